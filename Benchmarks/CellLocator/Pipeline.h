@@ -0,0 +1,200 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/CellLocator.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <iostream>
+#include <vector>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const dax::Id NUMBER_OF_QUERIES = 1024*1024;
+
+struct FindCell : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, UserObject, FieldOut);
+  typedef _3 ExecutionSignature(_1, _2);
+
+  template<typename LocatorType>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(const dax::Vector3 &point,
+                     const LocatorType &locator) const
+  {
+    return locator.FindCell(point);
+  }
+};
+
+void PrintResults(int pipeline, double buildTime, double queryTime)
+{
+  std::cout << "Build time: " << buildTime << " seconds." << std::endl;
+  std::cout << "Query time: " << queryTime << " seconds ("
+            << NUMBER_OF_QUERIES/queryTime << " queries per second)."
+            << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER ","
+            << pipeline << "," << buildTime << "," << queryTime << std::endl;
+}
+
+dax::Id PointIndex(dax::Id i, dax::Id j, dax::Id k, dax::Id pointsPerSide)
+{
+  return (k*pointsPerSide + j)*pointsPerSide + i;
+}
+
+/// Builds the points of a cube of size^3 unit voxels, which are either kept as
+/// hexahedra or split into six tetrahedra around their main diagonal.
+///
+template<typename CellTag>
+void MakeGrid(dax::Id size,
+              std::vector<dax::Vector3> &points,
+              std::vector<dax::Id> &connections,
+              CellTag)
+{
+  const dax::Id pointsPerSide = size + 1;
+  for (dax::Id k = 0; k < pointsPerSide; k++)
+    {
+    for (dax::Id j = 0; j < pointsPerSide; j++)
+      {
+      for (dax::Id i = 0; i < pointsPerSide; i++)
+        {
+        points.push_back(dax::make_Vector3(i, j, k));
+        }
+      }
+    }
+
+  const int tetrahedra[6][4] = { {0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+                                 {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6} };
+  for (dax::Id k = 0; k < size; k++)
+    {
+    for (dax::Id j = 0; j < size; j++)
+      {
+      for (dax::Id i = 0; i < size; i++)
+        {
+        const dax::Id hexahedron[8] = {
+          PointIndex(i,   j,   k,   pointsPerSide),
+          PointIndex(i+1, j,   k,   pointsPerSide),
+          PointIndex(i+1, j+1, k,   pointsPerSide),
+          PointIndex(i,   j+1, k,   pointsPerSide),
+          PointIndex(i,   j,   k+1, pointsPerSide),
+          PointIndex(i+1, j,   k+1, pointsPerSide),
+          PointIndex(i+1, j+1, k+1, pointsPerSide),
+          PointIndex(i,   j+1, k+1, pointsPerSide) };
+        if (dax::CellTraits<CellTag>::NUM_VERTICES == 8)
+          {
+          connections.insert(connections.end(), hexahedron, hexahedron+8);
+          }
+        else
+          {
+          for (int tet = 0; tet < 6; tet++)
+            {
+            for (int vertex = 0; vertex < 4; vertex++)
+              {
+              connections.push_back(hexahedron[tetrahedra[tet][vertex]]);
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
+/// Makes pseudo random query points in a box slightly larger than the grid so
+/// that some of them miss. A simple linear congruential generator keeps the
+/// query set identical across device adapters.
+///
+std::vector<dax::Vector3> MakeQueries(dax::Id size)
+{
+  std::vector<dax::Vector3> queries(NUMBER_OF_QUERIES);
+  unsigned int seed = 12345;
+  const dax::Scalar range = static_cast<dax::Scalar>(size) * 1.1f;
+  for (dax::Id index = 0; index < NUMBER_OF_QUERIES; index++)
+    {
+    dax::Vector3 point;
+    for (int component = 0; component < 3; component++)
+      {
+      seed = seed*1103515245u + 12345u;
+      point[component] =
+          range*static_cast<dax::Scalar>((seed >> 8) & 0xFFFF)/65535.0f;
+      }
+    queries[index] = point;
+    }
+  return queries;
+}
+
+template<typename CellTag>
+void RunLocator(dax::Id size, int pipeline)
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+
+  std::vector<dax::Vector3> points;
+  std::vector<dax::Id> connections;
+  MakeGrid(size, points, connections, CellTag());
+
+  GridType grid;
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+
+  std::vector<dax::Vector3> queries = MakeQueries(size);
+  dax::cont::ArrayHandle<dax::Vector3> queryHandle =
+      dax::cont::make_ArrayHandle(queries);
+  queryHandle.PrepareForInput();
+
+  std::cout << grid.GetNumberOfCells() << " cells, "
+            << NUMBER_OF_QUERIES << " queries" << std::endl;
+
+  dax::cont::Timer<> timer;
+  dax::cont::CellLocator<CellTag> locator(grid);
+  locator.Build();
+  double buildTime = timer.GetElapsedTime();
+
+  dax::cont::ArrayHandle<dax::Id> cellIds;
+  timer.Reset();
+  dax::cont::DispatcherMapField<FindCell>().Invoke(
+        queryHandle, locator.PrepareExecutionObject(), cellIds);
+  double queryTime = timer.GetElapsedTime();
+
+  PrintResults(pipeline, buildTime, queryTime);
+}
+
+void RunDAXPipeline(dax::Id size, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": locate cells in a "
+            << size << "^3 grid of "
+            << (pipeline == 2 ? "tetrahedra" : "hexahedra") << std::endl;
+
+  if (pipeline == 2)
+    {
+    RunLocator<dax::CellTagTetrahedron>(size, pipeline);
+    }
+  else
+    {
+    RunLocator<dax::CellTagHexahedron>(size, pipeline);
+    }
+}
+
+} // Anonymous namespace
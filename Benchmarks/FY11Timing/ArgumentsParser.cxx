@@ -20,7 +20,7 @@
 #include <sstream>
 #include <string>
 
-enum  optionIndex { UNKNOWN, HELP, SIZE, PIPELINE};
+enum  optionIndex { UNKNOWN, HELP, SIZE, PIPELINE, MEMORY};
 const dax::testing::option::Descriptor usage[] =
 {
   {UNKNOWN,   0,"" , ""    ,      dax::testing::option::Arg::None, "USAGE: example [options]\n\n"
@@ -28,6 +28,7 @@ const dax::testing::option::Descriptor usage[] =
   {HELP,      0,"h" , "help",      dax::testing::option::Arg::None, "  --help, -h  \tPrint usage and exit." },
   {SIZE,      0,"", "size",      dax::testing::option::Arg::Optional, "  --size  \t Size of the problem to test." },
   {PIPELINE,  0,"", "pipeline",  dax::testing::option::Arg::Optional, "  --pipeline  \t What pipeline to run." },
+  {MEMORY,    0,"", "memory",    dax::testing::option::Arg::None, "  --memory  \t Report array memory use." },
   {UNKNOWN,   0,"",  "",          dax::testing::option::Arg::None, "\nExamples:\n"
                                                                    " example --size=128 --pipeline=1\n"},
   {0,0,0,0,0,0}
@@ -36,7 +37,8 @@ const dax::testing::option::Descriptor usage[] =
 //-----------------------------------------------------------------------------
 dax::testing::ArgumentsParser::ArgumentsParser():
   ProblemSize(128),
-  Pipeline(CELL_GRADIENT)
+  Pipeline(CELL_GRADIENT),
+  Memory(false)
 {
 }
 
@@ -103,6 +105,11 @@ bool dax::testing::ArgumentsParser::parseArguments(int argc, char* argv[])
       }
     }
 
+  if ( options[MEMORY] )
+    {
+    this->Memory = true;
+    }
+
   delete[] options;
   delete[] buffer;
   return true;
@@ -58,6 +58,11 @@ int main(int argc, char* argv[])
     return 1;
     }
 
+  if (parser.memory())
+    {
+    dax::cont::MemoryTracker::Enable();
+    }
+
 
   //init grid vars from parser
   const dax::Id MAX_SIZE = parser.problemSize();
@@ -0,0 +1,104 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/Timer.h>
+
+#include <dax/worklet/Square.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const int NUMBER_OF_GATHERS = 10;
+
+void PrintResults(int pipeline, double time)
+{
+  std::cout << "Elapsed time: " << time << " seconds." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER ","
+            << pipeline << "," << time << std::endl;
+}
+
+// The gathered arrays are held in containers of the given tag, which sets
+// whether they are backed by huge pages.
+template<class ContainerTag>
+double RunGathers(dax::Id numberOfValues)
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+
+  std::vector<dax::Id> shuffledIndices(numberOfValues);
+  for (dax::Id index = 0; index < numberOfValues; index++)
+    {
+    shuffledIndices[index] = index;
+    }
+  std::random_shuffle(shuffledIndices.begin(), shuffledIndices.end());
+
+  dax::cont::ArrayHandle<dax::Id, ContainerTag> indices;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(shuffledIndices), indices);
+
+  dax::cont::ArrayHandle<dax::Scalar, ContainerTag> values;
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Scalar(0),
+                                                      numberOfValues),
+                  values);
+
+  dax::cont::ArrayHandle<dax::Scalar, ContainerTag> results;
+
+  dax::cont::Timer<> timer;
+  for (int gather = 0; gather < NUMBER_OF_GATHERS; gather++)
+    {
+    dax::cont::DispatcherMapField<dax::worklet::Square>().Invoke(
+          dax::cont::make_ArrayHandlePermutation(indices, values), results);
+    }
+  return timer.GetElapsedTime();
+}
+
+void RunDAXPipeline(dax::Id numberOfValues, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": random gather of "
+            << numberOfValues << " values with "
+            << (pipeline == 2 ? "huge" : "regular") << " pages" << std::endl;
+
+  double time;
+  if (pipeline == 2)
+    {
+    time = RunGathers<dax::cont::ArrayContainerControlTagHugePages>(
+          numberOfValues);
+    }
+  else
+    {
+    time = RunGathers<dax::cont::ArrayContainerControlTagBasic>(
+          numberOfValues);
+    }
+
+  PrintResults(pipeline, time);
+}
+
+} // Anonymous namespace
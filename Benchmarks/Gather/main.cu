@@ -0,0 +1,41 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define BOOST_SP_DISABLE_THREADS
+
+//included after defining the device adapter
+#ifndef DAX_DEVICE_ADAPTER
+  #define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_CUDA
+#endif
+
+#include "ArgumentsParser.h"
+#include "Pipeline.h"
+
+int main(int argc, char* argv[])
+  {
+  dax::testing::ArgumentsParser parser;
+  if (!parser.parseArguments(argc, argv))
+    {
+    return 1;
+    }
+
+  //init problem size from parser, given in millions of values
+  const dax::Id numberOfValues =
+      static_cast<dax::Id>(parser.problemSize())*1024*1024;
+
+  RunDAXPipeline(numberOfValues, parser.pipeline());
+  return 0;
+}
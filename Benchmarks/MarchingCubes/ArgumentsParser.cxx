@@ -21,14 +21,15 @@
 #include <sstream>
 #include <string>
 
-enum  optionIndex { UNKNOWN, HELP, SIZE, PIPELINE};
+enum  optionIndex { UNKNOWN, HELP, SIZE, PIPELINE, MEMORY};
 const dax::testing::option::Descriptor usage[] =
 {
   {UNKNOWN,   0,"" , ""    ,      dax::testing::option::Arg::None, "USAGE: example [options]\n\n"
                                                                     "Options:" },
   {HELP,      0,"h" , "help",      dax::testing::option::Arg::None, "  --help, -h  \tPrint usage and exit." },
   {SIZE,      0,"", "size",      dax::testing::option::Arg::Optional, "  --size  \t Size of the problem to test." },
-  {PIPELINE,  0,"", "pipeline",  dax::testing::option::Arg::Optional, "  --pipeline  \t What pipeline to run." },
+  {PIPELINE,  0,"", "pipeline",  dax::testing::option::Arg::Optional, "  --pipeline  \t What pipeline to run (1 marching cubes, 2 with duplicate points removed, 3 half float field, 4 16-bit quantized field, 5 flying edges)." },
+  {MEMORY,    0,"", "memory",    dax::testing::option::Arg::None, "  --memory  \t Report array memory use." },
   {UNKNOWN,   0,"",  "",          dax::testing::option::Arg::None, "\nExamples:\n"
                                                                    " example --size=128 --pipeline=1\n"},
   {0,0,0,0,0,0}
@@ -38,7 +39,8 @@ const dax::testing::option::Descriptor usage[] =
 //-----------------------------------------------------------------------------
 dax::testing::ArgumentsParser::ArgumentsParser():
   ProblemSize(128),
-  Pipeline(MARCHING_CUBES)
+  Pipeline(MARCHING_CUBES),
+  Memory(false)
 {
 }
 
@@ -96,6 +98,23 @@ bool dax::testing::ArgumentsParser::parseArguments(int argc, char* argv[])
       {
       this->Pipeline = MARCHING_CUBES_REMOVE_DUPLICATES;
       }
+    if (pipelineflag == 3)
+      {
+      this->Pipeline = MARCHING_CUBES_HALF_FIELD;
+      }
+    if (pipelineflag == 4)
+      {
+      this->Pipeline = MARCHING_CUBES_QUANTIZED_FIELD;
+      }
+    if (pipelineflag == 5)
+      {
+      this->Pipeline = FLYING_EDGES;
+      }
+    }
+
+  if ( options[MEMORY] )
+    {
+    this->Memory = true;
     }
 
   delete[] options;
@@ -32,15 +32,22 @@ public:
   enum PipelineMode
     {
     MARCHING_CUBES = 1,
-    MARCHING_CUBES_REMOVE_DUPLICATES = 2
+    MARCHING_CUBES_REMOVE_DUPLICATES = 2,
+    MARCHING_CUBES_HALF_FIELD = 3,
+    MARCHING_CUBES_QUANTIZED_FIELD = 4,
+    FLYING_EDGES = 5
 
     };
   PipelineMode pipeline() const
     { return this->Pipeline; }
 
+  bool memory() const
+    { return this->Memory; }
+
 private:
   unsigned int ProblemSize;
   PipelineMode Pipeline;
+  bool Memory;
 };
 
 }}
@@ -17,14 +17,19 @@
 #include "ArgumentsParser.h"
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompact.h>
 #include <dax/cont/DispatcherGenerateInterpolatedCells.h>
 #include <dax/cont/DispatcherMapCell.h>
 #include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/Timer.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/VectorOperations.h>
 
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/worklet/FlyingEdges.h>
 #include <dax/worklet/Magnitude.h>
 #include <dax/worklet/MarchingCubes.h>
 
@@ -46,6 +51,25 @@ void PrintResults(int pipeline, double time)
   std::cout << "Elapsed time: " << time << " seconds." << std::endl;
   std::cout << "CSV," DEVICE_ADAPTER ","
             << pipeline << "," << time << std::endl;
+
+  if (dax::cont::MemoryTracker::IsEnabled())
+    {
+    const dax::cont::MemoryTracker::Statistics &total =
+        dax::cont::MemoryTracker::GetStatistics();
+    std::cout << "CSV-MEMORY," DEVICE_ADAPTER "," << pipeline << ","
+              << total.CurrentBytes << "," << total.PeakBytes << ","
+              << total.NumberOfAllocations << std::endl;
+
+    typedef dax::cont::MemoryTracker::TagStatisticsType TagsType;
+    const TagsType &tags = dax::cont::MemoryTracker::GetTagStatistics();
+    for (TagsType::const_iterator tag = tags.begin(); tag != tags.end(); tag++)
+      {
+      std::cout << "CSV-MEMORY-TAG," DEVICE_ADAPTER "," << pipeline << ","
+                << tag->first << "," << tag->second.CurrentBytes << ","
+                << tag->second.PeakBytes << ","
+                << tag->second.NumberOfAllocations << std::endl;
+      }
+    }
 }
 
 template<typename T, typename Stream>
@@ -97,21 +121,18 @@ void PrintContentsToStream(dax::cont::UnstructuredGrid<T>& grid, Stream &stream)
   stream << std::endl;
   }
 
-void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
+template<class FieldHandleType>
+void RunMarchingCubes(const dax::cont::UniformGrid<> &grid,
+                      const FieldHandleType &field,
+                      int pipeline)
 {
-  std::cout << "Running pipeline " << pipeline << ": Magnitude -> MarchingCubes" << std::endl;
-
   dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
 
-  dax::cont::ArrayHandle<dax::Scalar> intermediate1;
-  dax::cont::DispatcherMapField< dax::worklet::Magnitude > magDispatcher;
-  magDispatcher.Invoke( grid.GetPointCoordinates(), intermediate1);
-
   dax::cont::Timer<> timer;
 
   //dispatch marching cubes worklet generate step
   typedef dax::cont::DispatcherGenerateInterpolatedCells< dax::worklet::MarchingCubesGenerate > DispatcherIC;
-  typedef DispatcherIC::CountHandleType  CountHandleType;
+  typedef typename DispatcherIC::CountHandleType  CountHandleType;
 
   dax::worklet::MarchingCubesCount classifyWorklet(ISOVALUE);
   dax::worklet::MarchingCubesGenerate generateWorklet(ISOVALUE);
@@ -119,7 +140,7 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
   //run the first step
   CountHandleType count; //array handle for the first step count
   dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount > cellDispatcher( classifyWorklet );
-  cellDispatcher.Invoke(grid, intermediate1, count);
+  cellDispatcher.Invoke(grid, field, count);
 
   //construct the topology generation worklet
   DispatcherIC icDispatcher(count, generateWorklet );
@@ -127,7 +148,7 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
                 pipeline == dax::testing::ArgumentsParser::MARCHING_CUBES_REMOVE_DUPLICATES);
 
   //run the second step
-  icDispatcher.Invoke(grid, outGrid, intermediate1);
+  icDispatcher.Invoke(grid, outGrid, field);
 
   double time = timer.GetElapsedTime();
 
@@ -143,7 +164,79 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
     PrintContentsToStream(outGrid,file);
     file.close();
     }
+}
+
+template<class FieldHandleType>
+void RunFlyingEdges(const dax::cont::UniformGrid<> &grid,
+                    const FieldHandleType &field,
+                    int pipeline)
+{
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
+
+  dax::cont::Timer<> timer;
 
+  dax::worklet::DispatcherFlyingEdges<> dispatcher(ISOVALUE);
+  dispatcher.Invoke(grid, field, outGrid);
+
+  double time = timer.GetElapsedTime();
+
+  std::cout << "number of coordinates in: " << grid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of coordinates out: " << outGrid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of cells out: " << outGrid.GetNumberOfCells() << std::endl;
+  PrintResults(pipeline, time);
+}
+
+void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
+{
+  if (pipeline == dax::testing::ArgumentsParser::FLYING_EDGES)
+    {
+    std::cout << "Running pipeline " << pipeline << ": Magnitude -> FlyingEdges" << std::endl;
+    }
+  else
+    {
+    std::cout << "Running pipeline " << pipeline << ": Magnitude -> MarchingCubes" << std::endl;
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> intermediate1;
+  dax::cont::DispatcherMapField< dax::worklet::Magnitude > magDispatcher;
+  magDispatcher.Invoke( grid.GetPointCoordinates(), intermediate1);
+
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+
+  // The compact pipelines encode the field before timing so that they
+  // measure reading a field with 2 bytes per point instead of 4 or 8.
+  if (pipeline == dax::testing::ArgumentsParser::MARCHING_CUBES_HALF_FIELD)
+    {
+    std::cout << "Using a half float field" << std::endl;
+    dax::cont::ArrayHandleCompact<dax::cont::CompactCodecHalf> halfField;
+    Algorithm::Copy(intermediate1, halfField);
+    intermediate1.ReleaseResources();
+    RunMarchingCubes(grid, halfField, pipeline);
+    }
+  else if (pipeline ==
+           dax::testing::ArgumentsParser::MARCHING_CUBES_QUANTIZED_FIELD)
+    {
+    std::cout << "Using a 16-bit quantized field" << std::endl;
+    typedef dax::cont::CompactCodecQuantized<unsigned short> CodecType;
+    // The magnitude of the point coordinates is at most the diagonal.
+    const dax::Id3 dims = dax::extentDimensions(grid.GetExtent());
+    const dax::Vector3 diagonal = grid.GetSpacing()*
+        dax::make_Vector3(dims[0]-1, dims[1]-1, dims[2]-1);
+    dax::cont::ArrayHandleCompact<CodecType> quantizedField(
+          CodecType::FromRange(0, dax::math::Magnitude(diagonal)));
+    Algorithm::Copy(intermediate1, quantizedField);
+    intermediate1.ReleaseResources();
+    RunMarchingCubes(grid, quantizedField, pipeline);
+    }
+  else if (pipeline == dax::testing::ArgumentsParser::FLYING_EDGES)
+    {
+    RunFlyingEdges(grid, intermediate1, pipeline);
+    }
+  else
+    {
+    RunMarchingCubes(grid, intermediate1, pipeline);
+    }
 }
 
 
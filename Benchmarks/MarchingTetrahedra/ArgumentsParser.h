@@ -38,9 +38,13 @@ public:
   PipelineMode pipeline() const
     { return this->Pipeline; }
 
+  bool memory() const
+    { return this->Memory; }
+
 private:
   unsigned int ProblemSize;
   PipelineMode Pipeline;
+  bool Memory;
 };
 
 }}
@@ -21,6 +21,7 @@
 #include <dax/cont/DispatcherGenerateTopology.h>
 #include <dax/cont/DispatcherMapCell.h>
 #include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/Timer.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
@@ -48,6 +49,25 @@ void PrintResults(int pipeline, double time)
   std::cout << "Elapsed time: " << time << " seconds." << std::endl;
   std::cout << "CSV," DEVICE_ADAPTER ","
             << pipeline << "," << time << std::endl;
+
+  if (dax::cont::MemoryTracker::IsEnabled())
+    {
+    const dax::cont::MemoryTracker::Statistics &total =
+        dax::cont::MemoryTracker::GetStatistics();
+    std::cout << "CSV-MEMORY," DEVICE_ADAPTER "," << pipeline << ","
+              << total.CurrentBytes << "," << total.PeakBytes << ","
+              << total.NumberOfAllocations << std::endl;
+
+    typedef dax::cont::MemoryTracker::TagStatisticsType TagsType;
+    const TagsType &tags = dax::cont::MemoryTracker::GetTagStatistics();
+    for (TagsType::const_iterator tag = tags.begin(); tag != tags.end(); tag++)
+      {
+      std::cout << "CSV-MEMORY-TAG," DEVICE_ADAPTER "," << pipeline << ","
+                << tag->first << "," << tag->second.CurrentBytes << ","
+                << tag->second.PeakBytes << ","
+                << tag->second.NumberOfAllocations << std::endl;
+      }
+    }
 }
 
 template<typename T, typename Stream>
@@ -108,14 +128,11 @@ void GridTetrahedralize(const InGridType& inGrid, OutGridType& outGrid)
           dax::cont::make_ArrayHandle(cellConnections);
 
     typedef dax::cont::DispatcherGenerateTopology<
-                          dax::worklet::Tetrahedralize,
-                          dax::cont::ArrayHandleConstant<dax::Id>
+                          dax::worklet::Tetrahedralize
                           > DispatcherTopology;
-    typedef dax::cont::ArrayHandleConstant<dax::Id> CountHandleType;
-
-    CountHandleType count(5,inGrid.GetNumberOfCells());
 
-    DispatcherTopology dispatcher(count);
+    //every voxel becomes 5 tetrahedra
+    DispatcherTopology dispatcher(5);
 
     //Although all the points from the input go into the output, if you set
     //this to false Dax will not copy the points to the unstructured grid due
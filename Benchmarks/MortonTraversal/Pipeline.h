@@ -0,0 +1,204 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/worklet/CellAverage.h>
+#include <dax/worklet/CellGradient.h>
+#include <dax/worklet/Magnitude.h>
+
+#include <iostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const int NUMBER_OF_ITERATIONS = 10;
+
+/// Counts the hardware cache misses of this process (including threads it
+/// starts afterwards) through the Linux perf events interface. The count is
+/// -1 when the counter is not available, for example on other platforms, in
+/// virtual machines or when perf_event_paranoid forbids it. Cache misses of
+/// a CUDA device are not counted.
+///
+class CacheMissCounter
+{
+public:
+  CacheMissCounter() : Descriptor(-1)
+  {
+#if defined(__linux__)
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    this->Descriptor = static_cast<int>(
+          syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+  }
+
+  ~CacheMissCounter()
+  {
+#if defined(__linux__)
+    if (this->Descriptor >= 0) { close(this->Descriptor); }
+#endif
+  }
+
+  void Start()
+  {
+#if defined(__linux__)
+    if (this->Descriptor < 0) { return; }
+    ioctl(this->Descriptor, PERF_EVENT_IOC_RESET, 0);
+    ioctl(this->Descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  long long Stop()
+  {
+    long long count = -1;
+#if defined(__linux__)
+    if (this->Descriptor < 0) { return count; }
+    ioctl(this->Descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(this->Descriptor, &count, sizeof(count)) != sizeof(count))
+      {
+      count = -1;
+      }
+#endif
+    return count;
+  }
+
+private:
+  int Descriptor;
+};
+
+void PrintResults(int pipeline,
+                  double rowMajorTime,
+                  long long rowMajorMisses,
+                  double mortonTime,
+                  long long mortonMisses)
+{
+  std::cout << "Row-major traversal: " << rowMajorTime << " seconds, "
+            << rowMajorMisses << " cache misses." << std::endl;
+  std::cout << "Morton traversal: " << mortonTime << " seconds, "
+            << mortonMisses << " cache misses." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER "," << pipeline << ","
+            << rowMajorTime << "," << rowMajorMisses << ","
+            << mortonTime << "," << mortonMisses << std::endl;
+}
+
+template<typename GridType>
+void RunWorklet(dax::worklet::CellGradient,
+                bool morton,
+                const GridType &grid,
+                const dax::cont::ArrayHandle<dax::Scalar> &field)
+{
+  dax::cont::ArrayHandle<dax::Vector3> gradient;
+  dax::cont::DispatcherMapCell<dax::worklet::CellGradient> dispatcher;
+  dispatcher.SetMortonTraversal(morton);
+  for (int iteration = 0; iteration < NUMBER_OF_ITERATIONS; iteration++)
+    {
+    dispatcher.Invoke(grid, grid.GetPointCoordinates(), field, gradient);
+    }
+}
+
+template<typename GridType>
+void RunWorklet(dax::worklet::CellAverage,
+                bool morton,
+                const GridType &grid,
+                const dax::cont::ArrayHandle<dax::Scalar> &field)
+{
+  dax::cont::ArrayHandle<dax::Scalar> average;
+  dax::cont::DispatcherMapCell<dax::worklet::CellAverage> dispatcher;
+  dispatcher.SetMortonTraversal(morton);
+  for (int iteration = 0; iteration < NUMBER_OF_ITERATIONS; iteration++)
+    {
+    dispatcher.Invoke(grid, field, average);
+    }
+}
+
+template<typename WorkletType>
+void RunTraversals(dax::Id size, int pipeline)
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(size, size, size));
+  std::cout << grid.GetNumberOfCells() << " cells, "
+            << grid.GetNumberOfPoints() << " points" << std::endl;
+
+  dax::cont::ArrayHandle<dax::Scalar> field;
+  dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+        grid.GetPointCoordinates(), field);
+
+  // Run once first so that both traversals see the arrays already allocated.
+  RunWorklet(WorkletType(), false, grid, field);
+
+  CacheMissCounter counter;
+
+  counter.Start();
+  dax::cont::Timer<> rowMajorTimer;
+  RunWorklet(WorkletType(), false, grid, field);
+  const double rowMajorTime = rowMajorTimer.GetElapsedTime();
+  const long long rowMajorMisses = counter.Stop();
+
+  counter.Start();
+  dax::cont::Timer<> mortonTimer;
+  RunWorklet(WorkletType(), true, grid, field);
+  const double mortonTime = mortonTimer.GetElapsedTime();
+  const long long mortonMisses = counter.Stop();
+
+  PrintResults(pipeline, rowMajorTime, rowMajorMisses,
+               mortonTime, mortonMisses);
+}
+
+void RunDAXPipeline(dax::Id size, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": "
+            << (pipeline == 2 ? "CellAverage" : "CellGradient")
+            << " on a " << size << "^3 uniform grid in row-major and Morton"
+            << " cell order" << std::endl;
+
+  if (pipeline == 2)
+    {
+    RunTraversals<dax::worklet::CellAverage>(size, pipeline);
+    }
+  else
+    {
+    RunTraversals<dax::worklet::CellGradient>(size, pipeline);
+    }
+}
+
+} // Anonymous namespace
@@ -0,0 +1,157 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/PointMerger.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <iostream>
+#include <vector>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> TriangleGridType;
+
+const dax::Scalar TOLERANCE = 0.0001f;
+
+void PrintResults(int pipeline, dax::Id numberOfPoints, double time)
+{
+  std::cout << "Elapsed time: " << time << " seconds ("
+            << numberOfPoints/time << " points per second)." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER ","
+            << pipeline << "," << time << std::endl;
+}
+
+/// Contours the magnitude of the point coordinates of a block.
+///
+void Contour(const dax::cont::UniformGrid<> &grid,
+             dax::Scalar isoValue,
+             bool removeDuplicatePoints,
+             TriangleGridType &outGrid)
+{
+  dax::cont::ArrayHandle<dax::Scalar> field;
+  dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+        grid.GetPointCoordinates(), field);
+
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<
+      dax::worklet::MarchingCubesGenerate> DispatcherIC;
+  DispatcherIC::CountHandleType count;
+  dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount>(
+        dax::worklet::MarchingCubesCount(isoValue)).Invoke(grid, field, count);
+
+  DispatcherIC icDispatcher(count,
+                            dax::worklet::MarchingCubesGenerate(isoValue));
+  icDispatcher.SetRemoveDuplicatePoints(removeDuplicatePoints);
+  icDispatcher.Invoke(grid, outGrid, field);
+}
+
+/// Appends the points and cells of a block to the merged arrays.
+///
+void AppendBlock(const TriangleGridType &block,
+                 std::vector<dax::Vector3> &points,
+                 std::vector<dax::Id> &connections)
+{
+  const dax::Id pointOffset = static_cast<dax::Id>(points.size());
+  const std::size_t connectionOffset = connections.size();
+
+  points.resize(points.size() + block.GetNumberOfPoints());
+  block.GetPointCoordinates().CopyInto(points.begin() + pointOffset);
+
+  connections.resize(connections.size()
+                     + block.GetCellConnections().GetNumberOfValues());
+  block.GetCellConnections().CopyInto(connections.begin() + connectionOffset);
+  for (std::size_t index = connectionOffset;
+       index < connections.size();
+       index++)
+    {
+    connections[index] += pointOffset;
+    }
+}
+
+void RunDAXPipeline(dax::Id size, int pipeline)
+{
+  const dax::Scalar isoValue = 0.75f*static_cast<dax::Scalar>(size);
+
+  std::vector<dax::Vector3> points;
+  std::vector<dax::Id> connections;
+  if (pipeline == dax::testing::ArgumentsParser::BLOCKS)
+    {
+    std::cout << "Running pipeline " << pipeline
+              << ": MarchingCubes on two blocks -> PointMerger" << std::endl;
+    // The two blocks share the plane of points at x = size/2, so the
+    // contour points on that plane are duplicated.
+    const dax::Id middle = size/2;
+    dax::cont::UniformGrid<> block;
+    TriangleGridType contour;
+
+    block.SetExtent(dax::make_Id3(0, 0, 0),
+                    dax::make_Id3(middle, size-1, size-1));
+    Contour(block, isoValue, true, contour);
+    AppendBlock(contour, points, connections);
+
+    block.SetExtent(dax::make_Id3(middle, 0, 0),
+                    dax::make_Id3(size-1, size-1, size-1));
+    Contour(block, isoValue, true, contour);
+    AppendBlock(contour, points, connections);
+    }
+  else
+    {
+    std::cout << "Running pipeline " << pipeline
+              << ": MarchingCubes triangle soup -> PointMerger" << std::endl;
+    dax::cont::UniformGrid<> grid;
+    grid.SetExtent(dax::make_Id3(0, 0, 0),
+                   dax::make_Id3(size-1, size-1, size-1));
+    TriangleGridType contour;
+    Contour(grid, isoValue, false, contour);
+    AppendBlock(contour, points, connections);
+    }
+
+  TriangleGridType grid;
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+  grid.GetPointCoordinates().PrepareForInput();
+  grid.GetCellConnections().PrepareForInput();
+  const dax::Id numberOfPoints = grid.GetNumberOfPoints();
+
+  dax::cont::Timer<> timer;
+  dax::cont::PointMerger<> merger(TOLERANCE);
+  merger.Merge(grid);
+  double time = timer.GetElapsedTime();
+
+  std::cout << "number of coordinates in: " << numberOfPoints << std::endl;
+  std::cout << "number of coordinates out: " << grid.GetNumberOfPoints()
+            << std::endl;
+  std::cout << "number of cells: " << grid.GetNumberOfCells() << std::endl;
+  PrintResults(pipeline, numberOfPoints, time);
+}
+
+} // Anonymous namespace
@@ -0,0 +1,160 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/math/Trig.h>
+
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <iostream>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const int NUMBER_OF_ITERATIONS = 5;
+
+typedef dax::cont::DispatcherGenerateInterpolatedCells<
+    dax::worklet::MarchingCubesGenerate> DispatcherType;
+typedef DispatcherType::CountHandleType CountHandleType;
+typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> OutGridType;
+
+/// A field whose zero contour is a lattice of small closed blobs, one every
+/// 16 points along each axis, so the surface has many more points than a
+/// single sphere.
+///
+struct BlobField : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,FieldOut);
+  typedef void ExecutionSignature(_1,_2);
+
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Vector3 &coordinates,
+                  dax::Scalar &value) const
+  {
+    const dax::Vector3 angles = coordinates*(dax::math::Pi()/8);
+    const dax::Vector3 sines = dax::math::Sin(angles);
+    value = sines[0]*sines[1]*sines[2] - dax::Scalar(0.25);
+  }
+};
+
+void PrintResults(int pipeline,
+                  dax::Id numberOfRecords,
+                  dax::Id numberOfPoints,
+                  double sortTime,
+                  double hashTime)
+{
+  std::cout << "Sort resolution: " << sortTime << " seconds." << std::endl;
+  std::cout << "Hash resolution: " << hashTime << " seconds." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER "," << pipeline << ","
+            << numberOfRecords << "," << numberOfPoints << ","
+            << sortTime << "," << hashTime << std::endl;
+}
+
+/// Runs the generate NUMBER_OF_ITERATIONS times with the given resolution
+/// of the duplicate points and returns the time it took.
+///
+template<class FieldHandleType>
+double TimeGenerate(const dax::cont::UniformGrid<> &grid,
+                    const FieldHandleType &field,
+                    const CountHandleType &count,
+                    dax::Scalar isovalue,
+                    DispatcherType::DuplicatePointResolution resolution,
+                    OutGridType &outGrid)
+{
+  DispatcherType dispatcher(count,
+                            dax::worklet::MarchingCubesGenerate(isovalue));
+  dispatcher.SetDuplicatePointResolution(resolution);
+  // Keep the counts for the next iterations and resolutions.
+  dispatcher.SetReleaseCount(false);
+  dax::cont::Timer<> timer;
+  for (int iteration = 0; iteration < NUMBER_OF_ITERATIONS; iteration++)
+    {
+    dispatcher.Invoke(grid, outGrid, field);
+    }
+  return timer.GetElapsedTime();
+}
+
+bool RunDAXPipeline(dax::Id size, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": duplicate points of "
+            << "MarchingCubes of "
+            << (pipeline == 1 ? "one sphere" : "many small blobs")
+            << " in a " << size << "^3 uniform grid" << std::endl;
+
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(size, size, size));
+
+  dax::cont::ArrayHandle<dax::Scalar> field;
+  dax::Scalar isovalue = 0;
+  if (pipeline == dax::testing::ArgumentsParser::SPHERE)
+    {
+    // Cut the sphere of points at half the size of the grid.
+    dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+          grid.GetPointCoordinates(), field);
+    isovalue = static_cast<dax::Scalar>(size)/2;
+    }
+  else
+    {
+    dax::cont::DispatcherMapField<BlobField>().Invoke(
+          grid.GetPointCoordinates(), field);
+    }
+
+  CountHandleType count;
+  dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount>(
+        dax::worklet::MarchingCubesCount(isovalue)).Invoke(grid, field, count);
+
+  OutGridType sortOutGrid;
+  const double sortTime = TimeGenerate(grid, field, count, isovalue,
+                                       DispatcherType::RESOLVE_DUPLICATES_BY_SORT,
+                                       sortOutGrid);
+  OutGridType hashOutGrid;
+  const double hashTime = TimeGenerate(grid, field, count, isovalue,
+                                       DispatcherType::RESOLVE_DUPLICATES_BY_HASH,
+                                       hashOutGrid);
+
+  const dax::Id numberOfRecords =
+      sortOutGrid.GetCellConnections().GetNumberOfValues();
+  std::cout << grid.GetNumberOfCells() << " cells, "
+            << numberOfRecords << " interpolated points, "
+            << sortOutGrid.GetNumberOfPoints() << " unique" << std::endl;
+  PrintResults(pipeline, numberOfRecords, sortOutGrid.GetNumberOfPoints(),
+               sortTime, hashTime);
+
+  if (hashOutGrid.GetNumberOfPoints() != sortOutGrid.GetNumberOfPoints() ||
+      hashOutGrid.GetNumberOfCells() != sortOutGrid.GetNumberOfCells())
+    {
+    std::cout << "The resolutions found different points." << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // Anonymous namespace
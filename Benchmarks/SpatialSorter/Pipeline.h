@@ -0,0 +1,229 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/SpatialSorter.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/worklet/CellGradient.h>
+#include <dax/worklet/Magnitude.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const int NUMBER_OF_GRADIENTS = 10;
+
+void PrintResults(int pipeline,
+                  double unsortedTime,
+                  double sortTime,
+                  double sortedTime)
+{
+  std::cout << "CellGradient on shuffled grid: " << unsortedTime
+            << " seconds." << std::endl;
+  std::cout << "SpatialSorter: " << sortTime << " seconds." << std::endl;
+  std::cout << "CellGradient on sorted grid: " << sortedTime
+            << " seconds." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER "," << pipeline << ","
+            << unsortedTime << "," << sortTime << "," << sortedTime
+            << std::endl;
+}
+
+dax::Id PointIndex(dax::Id i, dax::Id j, dax::Id k, dax::Id pointsPerSide)
+{
+  return (k*pointsPerSide + j)*pointsPerSide + i;
+}
+
+/// Builds the points of a cube of size^3 unit voxels, which are either kept as
+/// hexahedra or split into six tetrahedra around their main diagonal.
+///
+template<typename CellTag>
+void MakeGrid(dax::Id size,
+              std::vector<dax::Vector3> &points,
+              std::vector<dax::Id> &connections,
+              CellTag)
+{
+  const dax::Id pointsPerSide = size + 1;
+  for (dax::Id k = 0; k < pointsPerSide; k++)
+    {
+    for (dax::Id j = 0; j < pointsPerSide; j++)
+      {
+      for (dax::Id i = 0; i < pointsPerSide; i++)
+        {
+        points.push_back(dax::make_Vector3(i, j, k));
+        }
+      }
+    }
+
+  const int tetrahedra[6][4] = { {0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+                                 {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6} };
+  for (dax::Id k = 0; k < size; k++)
+    {
+    for (dax::Id j = 0; j < size; j++)
+      {
+      for (dax::Id i = 0; i < size; i++)
+        {
+        const dax::Id hexahedron[8] = {
+          PointIndex(i,   j,   k,   pointsPerSide),
+          PointIndex(i+1, j,   k,   pointsPerSide),
+          PointIndex(i+1, j+1, k,   pointsPerSide),
+          PointIndex(i,   j+1, k,   pointsPerSide),
+          PointIndex(i,   j,   k+1, pointsPerSide),
+          PointIndex(i+1, j,   k+1, pointsPerSide),
+          PointIndex(i+1, j+1, k+1, pointsPerSide),
+          PointIndex(i,   j+1, k+1, pointsPerSide) };
+        if (dax::CellTraits<CellTag>::NUM_VERTICES == 8)
+          {
+          connections.insert(connections.end(), hexahedron, hexahedron+8);
+          }
+        else
+          {
+          for (int tet = 0; tet < 6; tet++)
+            {
+            for (int vertex = 0; vertex < 4; vertex++)
+              {
+              connections.push_back(hexahedron[tetrahedra[tet][vertex]]);
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
+/// Renumbers the points and cells randomly, as in a grid read from a file
+/// written by an application with no particular ordering.
+///
+template<typename CellTag>
+void ShuffleGrid(std::vector<dax::Vector3> &points,
+                 std::vector<dax::Id> &connections,
+                 CellTag)
+{
+  const int numVertices = dax::CellTraits<CellTag>::NUM_VERTICES;
+  const dax::Id numberOfPoints = static_cast<dax::Id>(points.size());
+  const dax::Id numberOfCells =
+      static_cast<dax::Id>(connections.size())/numVertices;
+
+  std::vector<dax::Id> newPointIds(numberOfPoints);
+  for (dax::Id index = 0; index < numberOfPoints; index++)
+    {
+    newPointIds[index] = index;
+    }
+  std::random_shuffle(newPointIds.begin(), newPointIds.end());
+  std::vector<dax::Vector3> shuffledPoints(numberOfPoints);
+  for (dax::Id index = 0; index < numberOfPoints; index++)
+    {
+    shuffledPoints[newPointIds[index]] = points[index];
+    }
+  points.swap(shuffledPoints);
+
+  std::vector<dax::Id> cellOrder(numberOfCells);
+  for (dax::Id index = 0; index < numberOfCells; index++)
+    {
+    cellOrder[index] = index;
+    }
+  std::random_shuffle(cellOrder.begin(), cellOrder.end());
+  std::vector<dax::Id> shuffledConnections(connections.size());
+  for (dax::Id cell = 0; cell < numberOfCells; cell++)
+    {
+    for (int vertex = 0; vertex < numVertices; vertex++)
+      {
+      shuffledConnections[cell*numVertices + vertex] =
+          newPointIds[connections[cellOrder[cell]*numVertices + vertex]];
+      }
+    }
+  connections.swap(shuffledConnections);
+}
+
+template<typename GridType>
+double RunCellGradient(const GridType &grid,
+                       const dax::cont::ArrayHandle<dax::Scalar> &field)
+{
+  dax::cont::ArrayHandle<dax::Vector3> gradient;
+  dax::cont::Timer<> timer;
+  for (int iteration = 0; iteration < NUMBER_OF_GRADIENTS; iteration++)
+    {
+    dax::cont::DispatcherMapCell<dax::worklet::CellGradient>().Invoke(
+          grid, grid.GetPointCoordinates(), field, gradient);
+    }
+  return timer.GetElapsedTime();
+}
+
+template<typename CellTag>
+void RunSorter(dax::Id size, int pipeline)
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+
+  std::vector<dax::Vector3> points;
+  std::vector<dax::Id> connections;
+  MakeGrid(size, points, connections, CellTag());
+  ShuffleGrid(points, connections, CellTag());
+
+  GridType grid;
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+  std::cout << grid.GetNumberOfCells() << " cells, "
+            << grid.GetNumberOfPoints() << " points" << std::endl;
+
+  dax::cont::ArrayHandle<dax::Scalar> field;
+  dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+        grid.GetPointCoordinates(), field);
+
+  const double unsortedTime = RunCellGradient(grid, field);
+
+  dax::cont::Timer<> timer;
+  dax::cont::SpatialSorter<> sorter;
+  sorter.Sort(grid);
+  dax::cont::ArrayHandle<dax::Scalar> sortedField;
+  sorter.ReorderPointField(field, sortedField);
+  const double sortTime = timer.GetElapsedTime();
+
+  const double sortedTime = RunCellGradient(grid, sortedField);
+
+  PrintResults(pipeline, unsortedTime, sortTime, sortedTime);
+}
+
+void RunDAXPipeline(dax::Id size, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": CellGradient on a "
+            << size << "^3 grid of "
+            << (pipeline == 2 ? "tetrahedra" : "hexahedra")
+            << " before and after SpatialSorter" << std::endl;
+
+  if (pipeline == 2)
+    {
+    RunSorter<dax::CellTagTetrahedron>(size, pipeline);
+    }
+  else
+    {
+    RunSorter<dax::CellTagHexahedron>(size, pipeline);
+    }
+}
+
+} // Anonymous namespace
@@ -22,6 +22,7 @@
 
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/DispatcherMapCell.h>
 #include <dax/cont/DispatcherGenerateTopology.h>
 #include <dax/cont/Timer.h>
@@ -99,6 +100,25 @@ void PrintResults(int pipeline, double time)
   std::cout << "Elapsed time: " << time << " seconds." << std::endl;
   std::cout << "CSV," DEVICE_ADAPTER ","
             << pipeline << "," << time << std::endl;
+
+  if (dax::cont::MemoryTracker::IsEnabled())
+    {
+    const dax::cont::MemoryTracker::Statistics &total =
+        dax::cont::MemoryTracker::GetStatistics();
+    std::cout << "CSV-MEMORY," DEVICE_ADAPTER "," << pipeline << ","
+              << total.CurrentBytes << "," << total.PeakBytes << ","
+              << total.NumberOfAllocations << std::endl;
+
+    typedef dax::cont::MemoryTracker::TagStatisticsType TagsType;
+    const TagsType &tags = dax::cont::MemoryTracker::GetTagStatistics();
+    for (TagsType::const_iterator tag = tags.begin(); tag != tags.end(); tag++)
+      {
+      std::cout << "CSV-MEMORY-TAG," DEVICE_ADAPTER "," << pipeline << ","
+                << tag->first << "," << tag->second.CurrentBytes << ","
+                << tag->second.PeakBytes << ","
+                << tag->second.NumberOfAllocations << std::endl;
+      }
+    }
 }
 
 template<typename T, typename Stream>
@@ -0,0 +1,207 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include "ArgumentsParser.h"
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/Timer.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/dispatcher/AddVisitIndexArg.h>
+
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <iostream>
+#include <vector>
+
+#define MAKE_STRING2(x) #x
+#define MAKE_STRING1(x) MAKE_STRING2(x)
+#define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
+
+namespace
+{
+
+const int NUMBER_OF_ITERATIONS = 10;
+
+typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapterTag;
+typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+typedef dax::cont::ArrayHandle<dax::Id,
+    dax::cont::ArrayContainerControlTagBasic,
+    DeviceAdapterTag> IdArrayHandleType;
+
+/// The visit index as the generate dispatchers used to compute it: the lower
+/// bounds of each output in the cell map subtracted from its index.
+///
+struct SubtractLowerBounds : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,FieldOut);
+  typedef _2 ExecutionSignature(_1,WorkId);
+
+  DAX_EXEC_EXPORT dax::Id operator()(dax::Id lowerBounds,
+                                     dax::Id workId) const
+  {
+    return workId - lowerBounds;
+  }
+};
+
+/// A few long runs: every 64th cell makes 4096 outputs and the others make
+/// none, so a single output can be thousands of entries from its run start.
+///
+struct LongRunCount : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT dax::Id operator()(dax::Id cellId) const
+  {
+    return (cellId % 64 == 0) ? 4096 : 0;
+  }
+};
+
+void PrintResults(int pipeline,
+                  dax::Id numberOfCells,
+                  dax::Id numberOfOutputs,
+                  double lowerBoundsTime,
+                  double runStartsTime)
+{
+  std::cout << "LowerBounds visit index: " << lowerBoundsTime
+            << " seconds." << std::endl;
+  std::cout << "Run starts visit index: " << runStartsTime
+            << " seconds." << std::endl;
+  std::cout << "CSV," DEVICE_ADAPTER "," << pipeline << ","
+            << numberOfCells << "," << numberOfOutputs << ","
+            << lowerBoundsTime << "," << runStartsTime << std::endl;
+}
+
+/// Builds the cell map of a generate with the given counts the way the
+/// generate dispatchers do, with an inclusive scan and upper bounds.
+///
+void MakeCellMap(const IdArrayHandleType &counts, IdArrayHandleType &cellMap)
+{
+  IdArrayHandleType scannedCounts;
+  const dax::Id numberOfOutputs = Algorithm::ScanInclusive(counts,
+                                                           scannedCounts);
+  Algorithm::UpperBounds(scannedCounts,
+                         dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                             numberOfOutputs),
+                         cellMap);
+}
+
+void MakeCounts(const dax::cont::UniformGrid<> &grid,
+                int pipeline,
+                IdArrayHandleType &counts)
+{
+  const dax::Id numberOfCells = grid.GetNumberOfCells();
+  if (pipeline == dax::testing::ArgumentsParser::MARCHING_CUBES)
+    {
+    // Cut the sphere of points at half the size of the grid.
+    dax::cont::ArrayHandle<dax::Scalar> field;
+    dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+          grid.GetPointCoordinates(), field);
+    const dax::Id3 dims = dax::extentCellDimensions(grid.GetExtent());
+    dax::worklet::MarchingCubesCount countWorklet(
+          static_cast<dax::Scalar>(dims[0])/2);
+    dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount>(
+          countWorklet).Invoke(grid, field, counts);
+    }
+  else if (pipeline == dax::testing::ArgumentsParser::LONG_RUNS)
+    {
+    dax::cont::DispatcherMapField<LongRunCount, DeviceAdapterTag>().Invoke(
+          dax::cont::make_ArrayHandleCounting(dax::Id(0), numberOfCells),
+          counts);
+    }
+  else
+    {
+    const dax::Id countPerCell =
+        (pipeline == dax::testing::ArgumentsParser::HIGH_FANOUT) ? 32 : 5;
+    Algorithm::Copy(dax::cont::make_ArrayHandleConstant(countPerCell,
+                                                        numberOfCells,
+                                                        DeviceAdapterTag()),
+                    counts);
+    }
+}
+
+bool RunDAXPipeline(dax::Id size, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": visit index of the "
+            << (pipeline == 1 ? "Tetrahedralize" :
+                pipeline == 2 ? "MarchingCubes" :
+                pipeline == 3 ? "32 outputs per cell" :
+                "4096 outputs from every 64th cell")
+            << " cell map of a " << size << "^3 uniform grid" << std::endl;
+
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(size, size, size));
+
+  IdArrayHandleType counts;
+  MakeCounts(grid, pipeline, counts);
+
+  IdArrayHandleType cellMap;
+  MakeCellMap(counts, cellMap);
+  counts.ReleaseResources();
+
+  const dax::Id numberOfOutputs = cellMap.GetNumberOfValues();
+  std::cout << grid.GetNumberOfCells() << " cells, "
+            << numberOfOutputs << " outputs" << std::endl;
+  if (numberOfOutputs == 0)
+    {
+    std::cout << "Nothing to number." << std::endl;
+    return true;
+    }
+
+  IdArrayHandleType lowerBoundsVisitIndex;
+  dax::cont::Timer<> lowerBoundsTimer;
+  for (int iteration = 0; iteration < NUMBER_OF_ITERATIONS; iteration++)
+    {
+    Algorithm::LowerBounds(cellMap, cellMap, lowerBoundsVisitIndex);
+    dax::cont::DispatcherMapField<SubtractLowerBounds, DeviceAdapterTag>()
+        .Invoke(lowerBoundsVisitIndex, lowerBoundsVisitIndex);
+    }
+  const double lowerBoundsTime = lowerBoundsTimer.GetElapsedTime();
+
+  dax::cont::dispatcher::internal::MakeVisitIndexControlType<
+      true, Algorithm, IdArrayHandleType> makeVisitIndex;
+  IdArrayHandleType visitIndex;
+  dax::cont::Timer<> runStartsTimer;
+  for (int iteration = 0; iteration < NUMBER_OF_ITERATIONS; iteration++)
+    {
+    makeVisitIndex(cellMap, visitIndex);
+    }
+  const double runStartsTime = runStartsTimer.GetElapsedTime();
+
+  PrintResults(pipeline, grid.GetNumberOfCells(), numberOfOutputs,
+               lowerBoundsTime, runStartsTime);
+
+  std::vector<dax::Id> expected(numberOfOutputs);
+  std::vector<dax::Id> result(numberOfOutputs);
+  lowerBoundsVisitIndex.CopyInto(expected.begin());
+  visitIndex.CopyInto(result.begin());
+  if (expected != result)
+    {
+    std::cout << "The visit indices do not match." << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // Anonymous namespace
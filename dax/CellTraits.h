@@ -50,6 +50,12 @@ struct CellTraits
   ///
   const static int TOPOLOGICAL_DIMENSIONS = 3;
 
+  /// An identifier for the cell type that can be stored in an array, for
+  /// example the shapes array of dax::cont::UnstructuredGridMixed. The values
+  /// match those used by VTK.
+  ///
+  const static dax::Id CELL_SHAPE = 12;
+
   /// This tag is typedef'ed to
   /// dax::CellTopologicalDimensionsTag<TOPOLOGICAL_DIMENSIONS>. This provides
   /// a convenient way to overload a function based on topological dimensions
@@ -83,6 +89,7 @@ struct CellTraits
 template<> struct CellTraits<dax::CellTagHexahedron> {
   const static int NUM_VERTICES = 8;
   const static int TOPOLOGICAL_DIMENSIONS = 3;
+  const static dax::Id CELL_SHAPE = 12;
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagHexahedron CanonicalCellTag;
@@ -91,6 +98,7 @@ template<> struct CellTraits<dax::CellTagHexahedron> {
 template<> struct CellTraits<dax::CellTagLine> {
   const static int NUM_VERTICES = 2;
   const static int TOPOLOGICAL_DIMENSIONS = 1;
+  const static dax::Id CELL_SHAPE = 3;
   typedef dax::CellTopologicalDimensionsTag<1> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagLine CanonicalCellTag;
@@ -99,6 +107,7 @@ template<> struct CellTraits<dax::CellTagLine> {
 template<> struct CellTraits<dax::CellTagQuadrilateral> {
   const static int NUM_VERTICES = 4;
   const static int TOPOLOGICAL_DIMENSIONS = 2;
+  const static dax::Id CELL_SHAPE = 9;
   typedef dax::CellTopologicalDimensionsTag<2> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagQuadrilateral CanonicalCellTag;
@@ -107,6 +116,7 @@ template<> struct CellTraits<dax::CellTagQuadrilateral> {
 template<> struct CellTraits<dax::CellTagTetrahedron> {
   const static int NUM_VERTICES = 4;
   const static int TOPOLOGICAL_DIMENSIONS = 3;
+  const static dax::Id CELL_SHAPE = 10;
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagTetrahedron CanonicalCellTag;
@@ -115,6 +125,7 @@ template<> struct CellTraits<dax::CellTagTetrahedron> {
 template<> struct CellTraits<dax::CellTagTriangle> {
   const static int NUM_VERTICES = 3;
   const static int TOPOLOGICAL_DIMENSIONS = 2;
+  const static dax::Id CELL_SHAPE = 5;
   typedef dax::CellTopologicalDimensionsTag<2> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagTriangle CanonicalCellTag;
@@ -123,6 +134,7 @@ template<> struct CellTraits<dax::CellTagTriangle> {
 template<> struct CellTraits<dax::CellTagVertex> {
   const static int NUM_VERTICES = 1;
   const static int TOPOLOGICAL_DIMENSIONS = 0;
+  const static dax::Id CELL_SHAPE = 1;
   typedef dax::CellTopologicalDimensionsTag<0> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagVertex CanonicalCellTag;
@@ -131,6 +143,7 @@ template<> struct CellTraits<dax::CellTagVertex> {
 template<> struct CellTraits<dax::CellTagVoxel> {
   const static int NUM_VERTICES = 8;
   const static int TOPOLOGICAL_DIMENSIONS = 3;
+  const static dax::Id CELL_SHAPE = 11;
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUniform GridTag;
   typedef dax::CellTagHexahedron CanonicalCellTag;
@@ -139,6 +152,7 @@ template<> struct CellTraits<dax::CellTagVoxel> {
 template<> struct CellTraits<dax::CellTagWedge> {
   const static int NUM_VERTICES = 6;
   const static int TOPOLOGICAL_DIMENSIONS = 3;
+  const static dax::Id CELL_SHAPE = 13;
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagWedge CanonicalCellTag;
@@ -123,6 +123,85 @@ dax::Id index3ToFlatIndexCell(dax::Id3 ijk, const Extent3 &extent)
   return deltas[0] + dims[0]*(deltas[1] + dims[1]*deltas[2]);
 }
 
+/// Extent2 stores the 4 values for the extents of a 2D structured grid
+/// array. It gives the minimum indices and the maximum indices.
+DAX_ALIGN_BEGIN(DAX_SIZE_ID) struct Extent2
+{
+  Id2 Min;
+  Id2 Max;
+
+  DAX_EXEC_CONT_EXPORT Extent2() :
+    Min( dax::Id2(0,0)),
+    Max( dax::Id2(0,0))
+    {}
+
+  DAX_EXEC_CONT_EXPORT Extent2( const dax::Id2& min, const dax::Id2& max):
+    Min(min),
+    Max(max)
+    {}
+
+  DAX_EXEC_CONT_EXPORT Extent2( const Extent2& other) :
+    Min(other.Min),
+    Max(other.Max)
+    {}
+
+   DAX_EXEC_CONT_EXPORT Extent2& operator= (const Extent2& other)
+   {
+   this->Min = other.Min;
+   this->Max = other.Max;
+   return *this;
+   }
+
+} DAX_ALIGN_END(DAX_SIZE_ID);
+
+/// Given a 2D extent, returns the array dimensions in each direction.
+DAX_EXEC_CONT_EXPORT dax::Id2 extentDimensions(const Extent2 &extent)
+{
+  return dax::Id2(extent.Max[0] - extent.Min[0] + 1,
+                  extent.Max[1] - extent.Min[1] + 1);
+}
+
+/// Given a 2D extent, returns the cell dimensions in each direction.
+DAX_EXEC_CONT_EXPORT dax::Id2 extentCellDimensions(const Extent2 &extent)
+{
+  return dax::Id2(extent.Max[0] - extent.Min[0],
+                  extent.Max[1] - extent.Min[1]);
+}
+
+/// 2D version of flatIndexToIndex3.
+DAX_EXEC_CONT_EXPORT dax::Id2 flatIndexToIndex2(dax::Id index,
+                                                const Extent2 &extent)
+{
+  const dax::Id2 dims = extentDimensions(extent);
+  return dax::Id2((index % dims[0]) + extent.Min[0],
+                  (index / dims[0]) + extent.Min[1]);
+}
+
+/// 2D version of flatIndexToIndex3Cell.
+DAX_EXEC_CONT_EXPORT
+dax::Id2 flatIndexToIndex2Cell(dax::Id index, const Extent2 &extent)
+{
+  const dax::Id2 dims = extentCellDimensions(extent);
+  return dax::Id2((index % dims[0]) + extent.Min[0],
+                  (index / dims[0]) + extent.Min[1]);
+}
+
+/// 2D version of index3ToFlatIndex.
+DAX_EXEC_CONT_EXPORT dax::Id index2ToFlatIndex(dax::Id2 ij,
+                                               const Extent2 &extent)
+{
+  const dax::Id2 dims = extentDimensions(extent);
+  return (ij[0] - extent.Min[0]) + dims[0]*(ij[1] - extent.Min[1]);
+}
+
+/// 2D version of index3ToFlatIndexCell.
+DAX_EXEC_CONT_EXPORT
+dax::Id index2ToFlatIndexCell(dax::Id2 ij, const Extent2 &extent)
+{
+  const dax::Id2 dims = extentCellDimensions(extent);
+  return (ij[0] - extent.Min[0]) + dims[0]*(ij[1] - extent.Min[1]);
+}
+
 /// Returns the first point id for a given cell index and extent
 DAX_EXEC_CONT_EXPORT
 dax::Id indexToConnectivityIndex(dax::Id index, const Extent3 &extent)
@@ -21,17 +21,29 @@
 #include <dax/cont/Assert.h>
 #include <dax/cont/ErrorControlBadValue.h>
 #include <dax/cont/ErrorControlOutOfMemory.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/internal/AllocatorAligned.h>
 #include <dax/cont/internal/ArrayPortalFromIterators.h>
 
+#include <algorithm>
+
 namespace dax {
 namespace cont {
 
 /// A tag for the basic implementation of an ArrayContainerControl object.
 struct ArrayContainerControlTagBasic {  };
 
+/// A tag for a basic ArrayContainerControl whose large arrays are backed by
+/// huge pages. Use it for arrays that are accessed at random, such as the
+/// values gathered through a permutation array, to reduce TLB misses. See
+/// \c AllocatorAligned for details.
+struct ArrayContainerControlTagHugePages {  };
+
 namespace internal {
 
-/// A basic implementation of an ArrayContainerControl object.
+/// The implementation shared by the basic ArrayContainerControl objects. The
+/// containers differ only in how their memory is allocated, which \c
+/// AllocatorT defines.
 ///
 /// \todo This container does \em not construct the values within the array.
 /// Thus, it is important to not use this class with any type that will fail if
@@ -39,38 +51,38 @@ namespace internal {
 /// the Dax Tuple classes.  In the future it would be nice to have a compile
 /// time check to enforce this.
 ///
-template <typename ValueT>
-class ArrayContainerControl<ValueT, dax::cont::ArrayContainerControlTagBasic>
+template <typename ValueT, class AllocatorT>
+class ArrayContainerControlBasicImplementation
 {
 public:
   typedef ValueT ValueType;
   typedef dax::cont::internal::ArrayPortalFromIterators<ValueType*> PortalType;
   typedef dax::cont::internal::ArrayPortalFromIterators<const ValueType*> PortalConstType;
 
-private:
   /// The original design of this class provided an allocator as a template
   /// parameters. That messed things up, though, because other templated
   /// classes assume that the \c ArrayContainerControl has one template
   /// parameter. There are other ways to allow you to specify the allocator,
   /// but it is uncertain whether that would ever be useful. So, instead of
-  /// jumping through hoops implementing them, just fix the allocator for now.
+  /// jumping through hoops implementing them, just fix the allocator for each
+  /// container tag.
   ///
-  typedef std::allocator<ValueType> AllocatorType;
-
-public:
+  typedef AllocatorT AllocatorType;
 
-  ArrayContainerControl() : Array(NULL), NumberOfValues(0), AllocatedSize(0) { }
+  ArrayContainerControlBasicImplementation()
+    : Array(NULL), NumberOfValues(0), AllocatedSize(0) { }
 
-  ~ArrayContainerControl()
+  ~ArrayContainerControlBasicImplementation()
   {
     this->ReleaseResources();
   }
 
   void ReleaseResources()
   {
-    if (this->NumberOfValues > 0)
+    if (this->AllocatedSize > 0)
       {
       DAX_ASSERT_CONT(this->Array != NULL);
+      dax::cont::MemoryTracker::RecordDeallocation(this->Array);
       AllocatorType allocator;
       allocator.deallocate(this->Array, this->AllocatedSize);
       this->Array = NULL;
@@ -100,6 +112,8 @@ public:
         this->Array = allocator.allocate(numberOfValues);
         this->AllocatedSize  = numberOfValues;
         this->NumberOfValues = numberOfValues;
+        dax::cont::MemoryTracker::RecordAllocation(
+              this->Array, numberOfValues*sizeof(ValueType));
         }
       else
         {
@@ -123,6 +137,60 @@ public:
     return this->NumberOfValues;
   }
 
+  /// Returns the number of values that can be held without reallocating.
+  ///
+  dax::Id GetCapacity() const
+  {
+    return this->AllocatedSize;
+  }
+
+  /// Makes sure the array can hold at least \c capacity values without
+  /// reallocating. Unlike Allocate, the values already in the array are kept.
+  /// The number of values is not changed.
+  ///
+  void Reserve(dax::Id capacity)
+  {
+    if (capacity <= this->AllocatedSize) { return; }
+
+    AllocatorType allocator;
+    ValueType *newArray;
+    try
+      {
+      newArray = allocator.allocate(capacity);
+      }
+    catch (std::bad_alloc err)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not reserve basic control array.");
+      }
+
+    dax::cont::MemoryTracker::RecordAllocation(newArray,
+                                               capacity*sizeof(ValueType));
+
+    std::copy(this->Array, this->Array + this->NumberOfValues, newArray);
+    if (this->AllocatedSize > 0)
+      {
+      dax::cont::MemoryTracker::RecordDeallocation(this->Array);
+      allocator.deallocate(this->Array, this->AllocatedSize);
+      }
+    this->Array = newArray;
+    this->AllocatedSize = capacity;
+  }
+
+  /// Changes the number of values in the array while keeping the values
+  /// already in it. When the array has to grow past its capacity, the
+  /// capacity is at least doubled so that repeatedly growing the array (for
+  /// example appending to it) takes amortized constant time per value.
+  ///
+  void Resize(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->AllocatedSize)
+      {
+      this->Reserve(std::max(numberOfValues, 2*this->AllocatedSize));
+      }
+    this->NumberOfValues = numberOfValues;
+  }
+
   void Shrink(dax::Id numberOfValues)
   {
     if (numberOfValues > this->GetNumberOfValues())
@@ -151,27 +219,62 @@ public:
   /// ArrayContainerControl will never deallocate the array. This is
   /// helpful for taking a reference for an array created internally by Dax and
   /// not having to keep a Dax object around. Obviously the caller becomes
-  /// responsible for destroying the memory.
+  /// responsible for destroying the memory, which must be done with \c
+  /// delete[].
+  ///
+  /// Because the container allocates aligned memory, which cannot be freed
+  /// with \c delete[], the values are moved to an array allocated with \c
+  /// new[] and the aligned memory is released. This costs a copy of the
+  /// values.
   ///
   ValueType *StealArray()
   {
-    ValueType *saveArray =  this->Array;
-    this->Array = NULL;
-    this->NumberOfValues = 0;
-    this->AllocatedSize = 0;
-    return saveArray;
+    if (this->Array == NULL) { return NULL; }
+
+    ValueType *stolenArray;
+    try
+      {
+      stolenArray = new ValueType[this->NumberOfValues];
+      }
+    catch (std::bad_alloc err)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate stolen basic control array.");
+      }
+    std::copy(this->Array, this->Array + this->NumberOfValues, stolenArray);
+    this->ReleaseResources();
+    return stolenArray;
   }
 
 private:
   // Not implemented.
-  ArrayContainerControl(const ArrayContainerControl<ValueType, ArrayContainerControlTagBasic> &src);
-  void operator=(const ArrayContainerControl<ValueType, ArrayContainerControlTagBasic> &src);
+  ArrayContainerControlBasicImplementation(
+      const ArrayContainerControlBasicImplementation &src);
+  void operator=(const ArrayContainerControlBasicImplementation &src);
 
   ValueType *Array;
   dax::Id NumberOfValues;
   dax::Id AllocatedSize;
 };
 
+/// A basic implementation of an ArrayContainerControl object. The arrays are
+/// aligned to cache lines.
+///
+template <typename ValueT>
+class ArrayContainerControl<ValueT, dax::cont::ArrayContainerControlTagBasic>
+    : public ArrayContainerControlBasicImplementation<
+        ValueT, dax::cont::internal::AllocatorAligned<ValueT> >
+{  };
+
+/// A basic implementation of an ArrayContainerControl object whose large
+/// arrays are backed by huge pages.
+///
+template <typename ValueT>
+class ArrayContainerControl<ValueT, dax::cont::ArrayContainerControlTagHugePages>
+    : public ArrayContainerControlBasicImplementation<
+        ValueT, dax::cont::internal::AllocatorAligned<ValueT, true> >
+{  };
+
 } // namespace internal
 
 }
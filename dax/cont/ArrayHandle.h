@@ -27,6 +27,7 @@
 #include <boost/concept_check.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 
+#include <iterator>
 #include <vector>
 
 namespace dax {
@@ -226,6 +227,95 @@ public:
     DAX_ASSERT_CONT(this->GetNumberOfValues() == numberOfValues);
   }
 
+  /// \brief Changes the number of values in the array, keeping its values.
+  ///
+  /// Unlike Shrink, this method can also grow the array. The values at
+  /// indices 0 to min(\c numberOfValues, GetNumberOfValues()) - 1 are kept
+  /// and any new values are undefined. Growing reserves extra capacity, so
+  /// growing an array a little at a time takes amortized constant time per
+  /// value. If the array currently lives in the execution environment, it is
+  /// reallocated there without being transferred to the control environment.
+  ///
+  DAX_CONT_EXPORT void Resize(dax::Id numberOfValues)
+  {
+    if (numberOfValues <= this->GetNumberOfValues())
+      {
+      this->Shrink(numberOfValues);
+      return;
+      }
+
+    if (this->Internals->UserPortalValid)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandle has a read-only control portal.");
+      }
+
+    if (this->Internals->ExecutionArrayValid)
+      {
+      this->Internals->ExecutionArray.Resize(this->Internals->ControlArray,
+                                             numberOfValues);
+      // The control array is stale unless it shares memory with execution,
+      // in which case getting it back is cheap.
+      this->Internals->ControlArrayValid = false;
+      }
+    else
+      {
+      this->Internals->ControlArray.Resize(numberOfValues);
+      this->Internals->ControlArrayValid = true;
+      }
+
+    DAX_ASSERT_CONT(this->GetNumberOfValues() == numberOfValues);
+  }
+
+  /// \brief Makes room for at least \c numberOfValues values.
+  ///
+  /// The values and size of the array are not changed, but later calls to
+  /// Resize, Append, or PrepareForOutput up to the given size will not need
+  /// to reallocate. Space is reserved in the environment where the array
+  /// currently lives.
+  ///
+  DAX_CONT_EXPORT void Reserve(dax::Id numberOfValues)
+  {
+    if (this->Internals->UserPortalValid)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandle has a read-only control portal.");
+      }
+
+    if (this->Internals->ExecutionArrayValid)
+      {
+      this->Internals->ExecutionArray.Reserve(this->Internals->ControlArray,
+                                              numberOfValues);
+      }
+    else
+      {
+      this->Internals->ControlArray.Reserve(numberOfValues);
+      }
+  }
+
+  /// \brief Adds the values of \c other to the end of this array.
+  ///
+  /// The array is grown with Resize, so appending many arrays one after the
+  /// other takes amortized linear time. The values are copied in the control
+  /// environment, which is free when control and execution share memory.
+  /// \c other must not be this array.
+  ///
+  template<class OtherContainerTag>
+  DAX_CONT_EXPORT void Append(
+      const ArrayHandle<T,OtherContainerTag,DeviceAdapterTag_> &other)
+  {
+    const dax::Id numberToAppend = other.GetNumberOfValues();
+    if (numberToAppend == 0) { return; }
+
+    const dax::Id originalNumberOfValues = this->GetNumberOfValues();
+    this->Resize(originalNumberOfValues + numberToAppend);
+
+    PortalControl portal = this->GetPortalControl();
+    typename PortalControl::IteratorType dest = portal.GetIteratorBegin();
+    std::advance(dest, originalNumberOfValues);
+    other.CopyInto(dest);
+  }
+
   /// Releases any resources being used in the execution environment (that are
   /// not being shared by the control environment).
   ///
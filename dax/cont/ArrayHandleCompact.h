@@ -0,0 +1,319 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleCompact_h
+#define __dax_cont_ArrayHandleCompact_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/internal/ArrayContainerControlCompact.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Stores scalars as IEEE 754 half precision (16-bit) floats.
+///
+/// Half floats keep 11 significant bits and values up to 65504, so they are
+/// exact for integers up to 2048. Values that are too large encode to
+/// infinity. Rounding is to nearest, with ties rounded away from zero.
+///
+struct CompactCodecHalf
+{
+  typedef dax::Scalar ValueType;
+  typedef unsigned short StorageType;
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar Decode(StorageType half) const
+  {
+    const dax::internal::UInt32Type sign =
+        static_cast<dax::internal::UInt32Type>(half & 0x8000) << 16;
+    const dax::internal::UInt32Type exponent = (half >> 10) & 0x1f;
+    const dax::internal::UInt32Type mantissa = half & 0x3ff;
+
+    if (exponent == 0)
+      {
+      // Zero or subnormal, which is mantissa * 2^-24.
+      const float value = static_cast<float>(mantissa)*5.9604644775390625e-8f;
+      return static_cast<dax::Scalar>(sign ? -value : value);
+      }
+
+    FloatBits bits;
+    if (exponent == 0x1f)
+      {
+      // Infinity or NaN.
+      bits.Bits = sign | 0x7f800000 | (mantissa << 13);
+      }
+    else
+      {
+      bits.Bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+      }
+    return static_cast<dax::Scalar>(bits.Float);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  StorageType Encode(dax::Scalar value) const
+  {
+    FloatBits bits;
+    bits.Float = static_cast<float>(value);
+    const dax::internal::UInt32Type sign = (bits.Bits >> 16) & 0x8000;
+    const dax::internal::UInt32Type magnitude = bits.Bits & 0x7fffffff;
+
+    if (magnitude >= 0x47800000)
+      {
+      // Too large for a half (or infinity or NaN).
+      return static_cast<StorageType>(
+            sign | ((magnitude > 0x7f800000) ? 0x7e00 : 0x7c00));
+      }
+    if (magnitude < 0x38800000)
+      {
+      // Subnormal half or zero.
+      if (magnitude < 0x33000000) { return static_cast<StorageType>(sign); }
+      const dax::internal::UInt32Type shift = 126 - (magnitude >> 23);
+      const dax::internal::UInt32Type mantissa =
+          (magnitude & 0x7fffff) | 0x800000;
+      return static_cast<StorageType>(
+            sign | ((mantissa + (1 << (shift - 1))) >> shift));
+      }
+
+    // Normal half. Rebias the exponent and round the mantissa. A carry out
+    // of the mantissa correctly bumps the exponent (up to infinity).
+    return static_cast<StorageType>(
+          sign | (((magnitude - 0x38000000) + 0x1000) >> 13));
+  }
+
+private:
+  union FloatBits {
+    float Float;
+    dax::internal::UInt32Type Bits;
+  };
+};
+
+/// \brief Stores scalars linearly quantized to an unsigned integer type.
+///
+/// A stored value \c q represents \c Offset + \c Scale * \c q. Values are
+/// rounded to the nearest step and clamped to the range of \c StorageType,
+/// which must be an unsigned integer type (such as <tt>unsigned char</tt> or
+/// <tt>unsigned short</tt>).
+///
+template<typename StorageType_>
+struct CompactCodecQuantized
+{
+  typedef dax::Scalar ValueType;
+  typedef StorageType_ StorageType;
+
+  DAX_EXEC_CONT_EXPORT
+  CompactCodecQuantized() : Scale(1), Offset(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  CompactCodecQuantized(dax::Scalar scale, dax::Scalar offset)
+    : Scale(scale), Offset(offset) {  }
+
+  /// Returns a codec that spreads the range [\c minValue, \c maxValue] over
+  /// all the values of \c StorageType.
+  ///
+  DAX_CONT_EXPORT
+  static CompactCodecQuantized FromRange(dax::Scalar minValue,
+                                         dax::Scalar maxValue)
+  {
+    const dax::Scalar steps = static_cast<dax::Scalar>(MaxStorageValue());
+    return CompactCodecQuantized((maxValue - minValue)/steps, minValue);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar Decode(StorageType value) const
+  {
+    return this->Offset + this->Scale*static_cast<dax::Scalar>(value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  StorageType Encode(dax::Scalar value) const
+  {
+    const dax::Scalar steps = (value - this->Offset)/this->Scale;
+    if (!(steps > 0)) { return 0; }
+    const dax::Scalar maxSteps = static_cast<dax::Scalar>(MaxStorageValue());
+    if (steps >= maxSteps) { return MaxStorageValue(); }
+    return static_cast<StorageType>(steps + dax::Scalar(0.5));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar GetScale() const { return this->Scale; }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Scalar GetOffset() const { return this->Offset; }
+
+private:
+  DAX_EXEC_CONT_EXPORT
+  static StorageType MaxStorageValue()
+  {
+    return static_cast<StorageType>(~StorageType(0));
+  }
+
+  dax::Scalar Scale;
+  dax::Scalar Offset;
+};
+
+/// \brief Stores ids in a narrower integer type.
+///
+/// Ids are cast to and from \c StorageType without range checks, so every
+/// stored id must fit in it. This is meant for arrays such as cell
+/// connections, where the values are bounded by the number of points of one
+/// grid and so are much smaller than the range of a 64-bit dax::Id.
+///
+template<typename StorageType_>
+struct CompactCodecId
+{
+  typedef dax::Id ValueType;
+  typedef StorageType_ StorageType;
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id Decode(StorageType value) const
+  {
+    return static_cast<dax::Id>(value);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  StorageType Encode(dax::Id value) const
+  {
+    return static_cast<StorageType>(value);
+  }
+};
+
+/// Defines the container tag for arrays of ids held as \c StorageType. The
+/// tag can be given to grids to store their connections in fewer bits, for
+/// example
+///
+/// \code
+/// dax::cont::UnstructuredGrid<
+///     dax::CellTagTriangle,
+///     dax::cont::ArrayContainerControlCompactId<
+///         dax::internal::Int32Type>::ArrayContainerControlTag> grid;
+/// \endcode
+///
+template<typename StorageType,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+struct ArrayContainerControlCompactId
+{
+  typedef dax::cont::CompactCodecId<StorageType> CodecType;
+  typedef dax::cont::internal::ArrayContainerControlTagCompact<
+      dax::cont::ArrayHandle<StorageType,
+                             dax::cont::ArrayContainerControlTagBasic,
+                             DeviceAdapterTag>,
+      CodecType> ArrayContainerControlTag;
+};
+
+/// ArrayHandleCompact is a specialization of ArrayHandle that holds scalars
+/// or ids in a smaller storage type, such as half floats, quantized bytes or
+/// 32-bit ids. The
+/// codec encodes and decodes the values in the execution environment as
+/// they are read and written, so only the compact storage array is ever
+/// allocated and transferred. This reduces the memory use and bandwidth for
+/// fields that do not need full precision.
+///
+/// An ArrayHandleCompact can be used anywhere an array of the codec's
+/// \c ValueType is expected, both for input and output.
+///
+template <class CodecType,
+          class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG >
+class ArrayHandleCompact
+    : public ArrayHandle <
+      typename CodecType::ValueType,
+      dax::cont::internal::ArrayContainerControlTagCompact<
+        dax::cont::ArrayHandle<typename CodecType::StorageType,
+                               dax::cont::ArrayContainerControlTagBasic,
+                               DeviceAdapterTag_>,
+        CodecType>,
+      DeviceAdapterTag_>
+{
+public:
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+  typedef dax::cont::ArrayHandle<typename CodecType::StorageType,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> StorageHandleType;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControlCompactTypes<
+      StorageHandleType, CodecType> CompactTypes;
+
+public:
+  typedef typename CompactTypes::ValueType ValueType;
+  typedef typename CompactTypes::ArrayContainerControlTag
+      ArrayContainerControlTag;
+
+  typedef dax::cont::ArrayHandle< ValueType, ArrayContainerControlTag,
+                                  DeviceAdapterTag> Superclass;
+private:
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType,ArrayContainerControlTag,DeviceAdapterTag> ArrayTransferType;
+
+public:
+  /// Creates an empty array, typically to be used as an output.
+  ///
+  ArrayHandleCompact(const CodecType &codec = CodecType())
+    : Superclass(
+        typename CompactTypes::ArrayContainerControlType(StorageHandleType(),
+                                                         codec),
+        true,
+        ArrayTransferType(),
+        false)
+  {  }
+
+  /// Creates an array that decodes the values already in \c storage.
+  ///
+  ArrayHandleCompact(const StorageHandleType &storage,
+                     const CodecType &codec = CodecType())
+    : Superclass(
+        typename CompactTypes::ArrayContainerControlType(storage, codec),
+        true,
+        ArrayTransferType(),
+        false)
+  {  }
+
+  /// The array holding the encoded values. It shares its data with this
+  /// array.
+  ///
+  DAX_CONT_EXPORT
+  StorageHandleType GetStorage() const
+  {
+    return this->GetPortalConstControl().Array;
+  }
+
+  DAX_CONT_EXPORT
+  CodecType GetCodec() const
+  {
+    return this->GetPortalConstControl().Codec;
+  }
+};
+
+/// make_ArrayHandleCompact is convenience function to generate an
+/// ArrayHandleCompact. It takes in the handle of encoded values and the
+/// codec to decode them with.
+template <typename StorageType, typename CodecType, typename DeviceAdapterTag>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleCompact<CodecType,DeviceAdapterTag>
+make_ArrayHandleCompact(
+    const dax::cont::ArrayHandle<StorageType,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> &storage,
+    const CodecType &codec)
+{
+  return ArrayHandleCompact<CodecType,DeviceAdapterTag>(storage, codec);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleCompact_h
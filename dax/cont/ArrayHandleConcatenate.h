@@ -0,0 +1,88 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleConcatenate_h
+#define __dax_cont_ArrayHandleConcatenate_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/internal/ArrayContainerControlConcatenate.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleConcatenate is a specialization of ArrayHandle. It takes two
+/// delegate array handles and makes a new handle that accesses the values of
+/// the first handle followed by the values of the second handle. Both
+/// delegates must hold the same value type. The values are never copied, so
+/// the outputs of several blocks can be used (read or written) as one array.
+///
+template <typename FirstHandleType,
+          typename SecondHandleType,
+          class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG >
+class ArrayHandleConcatenate
+    : public ArrayHandle <
+      typename dax::cont::internal::ArrayContainerControlConcatenateTypes<
+               FirstHandleType,SecondHandleType>::ValueType,
+      typename dax::cont::internal::ArrayContainerControlConcatenateTypes<
+               FirstHandleType,SecondHandleType>::ArrayContainerControlTag,
+      DeviceAdapterTag_>
+{
+private:
+  typedef dax::cont::internal::ArrayContainerControlConcatenateTypes<
+      FirstHandleType,SecondHandleType> ConcatenateTypes;
+
+public:
+  typedef typename ConcatenateTypes::ValueType ValueType;
+  typedef typename ConcatenateTypes::ArrayContainerControlTag
+      ArrayContainerControlTag;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+   typedef dax::cont::ArrayHandle< ValueType, ArrayContainerControlTag,
+                                   DeviceAdapterTag> Superclass;
+private:
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType,ArrayContainerControlTag,DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleConcatenate(const FirstHandleType& firstHandle,
+                         const SecondHandleType& secondHandle)
+    : Superclass(
+        typename ConcatenateTypes::ArrayContainerControlType(firstHandle,
+                                                             secondHandle),
+        true,
+        ArrayTransferType(),
+        false)
+  {
+  }
+
+};
+
+/// make_ArrayHandleConcatenate is convenience function to generate an
+/// ArrayHandleConcatenate.  It takes in the two handles to join, the values
+/// of \c first come before the values of \c second.
+template <typename FirstHandle, typename SecondHandle>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleConcatenate<FirstHandle,SecondHandle>
+make_ArrayHandleConcatenate(FirstHandle first, SecondHandle second)
+{
+  return ArrayHandleConcatenate<FirstHandle,SecondHandle>(first,second);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleConcatenate_h
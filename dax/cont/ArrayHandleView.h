@@ -0,0 +1,90 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleView_h
+#define __dax_cont_ArrayHandleView_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/internal/ArrayContainerControlView.h>
+#include <dax/cont/ArrayHandle.h>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleView is a specialization of ArrayHandle. It takes a delegate
+/// array handle and makes a new handle that accesses a contiguous range of
+/// it, starting at the given offset and covering the given number of values.
+/// The view shares the memory of the delegate, so slabs of a large array can
+/// be processed (read or written) without copying them.
+///
+template <typename ArrayHandleType,
+          class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG >
+class ArrayHandleView
+    : public ArrayHandle <
+      typename dax::cont::internal::ArrayContainerControlViewTypes<
+               ArrayHandleType>::ValueType,
+      typename dax::cont::internal::ArrayContainerControlViewTypes<
+               ArrayHandleType>::ArrayContainerControlTag,
+      DeviceAdapterTag_>
+{
+private:
+  typedef dax::cont::internal::ArrayContainerControlViewTypes<
+      ArrayHandleType> ViewTypes;
+
+public:
+  typedef typename ViewTypes::ValueType ValueType;
+  typedef typename ViewTypes::ArrayContainerControlTag ArrayContainerControlTag;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+   typedef dax::cont::ArrayHandle< ValueType, ArrayContainerControlTag,
+                                   DeviceAdapterTag> Superclass;
+private:
+  typedef dax::cont::internal::ArrayTransfer<
+      ValueType,ArrayContainerControlTag,DeviceAdapterTag> ArrayTransferType;
+
+public:
+  ArrayHandleView(const ArrayHandleType& handle,
+                  dax::Id offset,
+                  dax::Id numberOfValues)
+    : Superclass(
+        typename ViewTypes::ArrayContainerControlType(handle,
+                                                      offset,
+                                                      numberOfValues),
+        true,
+        ArrayTransferType(),
+        false)
+  {
+    DAX_ASSERT_CONT(offset >= 0);
+    DAX_ASSERT_CONT(offset + numberOfValues <= handle.GetNumberOfValues());
+  }
+
+};
+
+/// make_ArrayHandleView is convenience function to generate an
+/// ArrayHandleView.  It takes in the handle to view along with the offset and
+/// number of values of the range to view.
+template <typename HandleType>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleView<HandleType>
+make_ArrayHandleView(HandleType handle, dax::Id offset, dax::Id numberOfValues)
+{
+  return ArrayHandleView<HandleType>(handle,offset,numberOfValues);
+}
+
+}
+}
+
+#endif //__dax_cont_ArrayHandleView_h
@@ -0,0 +1,292 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_CellLocator_h
+#define __dax_cont_CellLocator_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/cont/arg/ExecutionObject.h>
+#include <dax/cont/internal/ComputeBounds.h>
+
+#include <dax/exec/CellLocator.h>
+#include <dax/exec/internal/kernel/CellLocatorWorklets.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+#include <dax/math/Compare.h>
+#include <dax/math/Exp.h>
+#include <dax/math/Precision.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Builds a dax::exec::CellLocator for an unstructured grid.
+///
+/// The locator sorts the cells into a regular grid of bins covering the
+/// bounds of the grid. Build does all the work in the execution environment:
+/// the bounds are reduced in blocks, the cells are counted and scattered into
+/// the bins they overlap, and the (bin, cell) pairs are sorted by bin with
+/// SortByKey and indexed with LowerBounds. Once built, PrepareExecutionObject
+/// returns an object that can be passed to worklets as a \c UserObject to
+/// find the cell containing a point.
+///
+template <
+    typename CellT,
+    class CellConnectionsContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class PointsArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class CellLocator
+{
+public:
+  typedef CellT CellTag;
+  typedef dax::cont::UnstructuredGrid<CellTag,
+                                      CellConnectionsContainerControlTag,
+                                      PointsArrayContainerControlTag,
+                                      DeviceAdapterTag> GridType;
+
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayType;
+
+  typedef dax::exec::CellLocator<
+      CellTag,
+      typename GridType::CellConnectionsType::PortalConstExecution,
+      typename GridType::PointCoordinatesType::PortalConstExecution,
+      typename IdArrayType::PortalConstExecution> ExecutionObjectType;
+
+  DAX_CONT_EXPORT
+  CellLocator() : CellsPerBin(2), Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  CellLocator(const GridType &grid)
+    : Grid(grid), CellsPerBin(2), Valid(false) {  }
+
+  /// The grid to locate cells in. Changing the grid requires calling Build
+  /// again.
+  ///
+  DAX_CONT_EXPORT
+  const GridType &GetGrid() const { return this->Grid; }
+  DAX_CONT_EXPORT
+  void SetGrid(const GridType &grid) {
+    this->Grid = grid;
+    this->Valid = false;
+  }
+
+  /// The average number of cells per bin used to choose the number of bins.
+  /// Fewer cells per bin make queries faster at the cost of memory, as large
+  /// cells are listed in every bin they overlap.
+  ///
+  DAX_CONT_EXPORT
+  dax::Scalar GetCellsPerBin() const { return this->CellsPerBin; }
+  DAX_CONT_EXPORT
+  void SetCellsPerBin(dax::Scalar cellsPerBin) {
+    this->CellsPerBin = cellsPerBin;
+    this->Valid = false;
+  }
+
+  /// Sorts the cells of the grid into bins.
+  ///
+  DAX_CONT_EXPORT
+  void Build()
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithms;
+
+    dax::cont::MemoryTrackerScope memoryScope("CellLocator::Build");
+
+    const dax::Id numberOfCells = this->Grid.GetNumberOfCells();
+    if (numberOfCells < 1)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Cannot build a cell locator for a grid without cells.");
+      }
+    if (this->CellsPerBin <= 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The number of cells per bin must be positive.");
+      }
+
+    this->ComputeBins();
+
+    typename GridType::CellConnectionsType::PortalConstExecution connections =
+        this->Grid.GetCellConnections().PrepareForInput();
+    typename GridType::PointCoordinatesType::PortalConstExecution coordinates =
+        this->Grid.GetPointCoordinates().PrepareForInput();
+
+    // Count how many bins each cell overlaps and scan to find where the
+    // (bin, cell) pairs of each cell go.
+    IdArrayType cellOffsets;
+    dax::exec::internal::kernel::CellLocatorCountBinsFunctor<
+        CellTag,
+        typename GridType::CellConnectionsType::PortalConstExecution,
+        typename GridType::PointCoordinatesType::PortalConstExecution,
+        typename IdArrayType::PortalExecution>
+        countBins(connections,
+                  coordinates,
+                  this->Bins,
+                  cellOffsets.PrepareForOutput(numberOfCells));
+    Algorithms::Schedule(countBins, numberOfCells);
+    const dax::Id numberOfPairs =
+        Algorithms::ScanExclusive(cellOffsets, cellOffsets);
+
+    IdArrayType binIds;
+    dax::exec::internal::kernel::CellLocatorFillBinsFunctor<
+        CellTag,
+        typename GridType::CellConnectionsType::PortalConstExecution,
+        typename GridType::PointCoordinatesType::PortalConstExecution,
+        typename IdArrayType::PortalConstExecution,
+        typename IdArrayType::PortalExecution>
+        fillBins(connections,
+                 coordinates,
+                 this->Bins,
+                 cellOffsets.PrepareForInput(),
+                 binIds.PrepareForOutput(numberOfPairs),
+                 this->BinCellIds.PrepareForOutput(numberOfPairs));
+    Algorithms::Schedule(fillBins, numberOfCells);
+    cellOffsets.ReleaseResources();
+
+    // Group the pairs by bin and index the start of every bin.
+    Algorithms::SortByKey(binIds, this->BinCellIds);
+
+    const dax::Id numberOfBins = this->Bins.GetNumberOfBins();
+    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
+        binIndices(0, numberOfBins);
+    Algorithms::LowerBounds(binIds, binIndices, this->BinOffsets);
+
+    typedef dax::exec::internal::kernel::Offset2CountFunctor<
+        IdArrayType> OffsetFunctorType;
+    OffsetFunctorType offset2Count(
+          this->BinOffsets.PrepareForInput(),
+          this->BinCounts.PrepareForOutput(numberOfBins),
+          numberOfBins-1,
+          numberOfPairs);
+    Algorithms::Schedule(offset2Count, numberOfBins);
+
+    this->Valid = true;
+  }
+
+  /// Returns true if Build has been called since the grid or the settings
+  /// last changed.
+  ///
+  DAX_CONT_EXPORT
+  bool IsValid() const { return this->Valid; }
+
+  /// The number of bins along each axis, as chosen by Build.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 GetBinDimensions() const { return this->Bins.Dimensions; }
+
+  /// Prepares the locator to be used in the execution environment and returns
+  /// the object to pass to worklets.
+  ///
+  DAX_CONT_EXPORT
+  ExecutionObjectType PrepareExecutionObject() const
+  {
+    if (!this->Valid)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The cell locator has to be built before it is used.");
+      }
+    return ExecutionObjectType(
+          this->Grid.GetCellConnections().PrepareForInput(),
+          this->Grid.GetPointCoordinates().PrepareForInput(),
+          this->BinCounts.PrepareForInput(),
+          this->BinOffsets.PrepareForInput(),
+          this->BinCellIds.PrepareForInput(),
+          this->Bins);
+  }
+
+  /// Releases the bins. The locator has to be built again to be used.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->BinCounts.ReleaseResources();
+    this->BinOffsets.ReleaseResources();
+    this->BinCellIds.ReleaseResources();
+    this->Valid = false;
+  }
+
+private:
+  /// Computes the bounds of the points in parallel and chooses bins of about
+  /// equal size in every direction.
+  DAX_CONT_EXPORT
+  void ComputeBins()
+  {
+    dax::Vector3 minBounds;
+    dax::Vector3 maxBounds;
+    dax::cont::internal::ComputeBounds(this->Grid.GetPointCoordinates(),
+                                       minBounds,
+                                       maxBounds);
+
+    // Pick a bin size that gives about the requested number of cells per bin.
+    // Flat dimensions get a single bin and do not count in the volume.
+    const dax::Vector3 size = maxBounds - minBounds;
+    const dax::Scalar targetBins = dax::math::Max(
+          dax::Scalar(1),
+          this->Grid.GetNumberOfCells()/this->CellsPerBin);
+    dax::Scalar volume = 1;
+    int numberOfDimensions = 0;
+    for (int dim = 0; dim < 3; dim++)
+      {
+      if (size[dim] > 0)
+        {
+        volume *= size[dim];
+        numberOfDimensions++;
+        }
+      }
+    const dax::Scalar binSize = (numberOfDimensions > 0)
+        ? dax::math::Pow(volume/targetBins,
+                         dax::Scalar(1)/numberOfDimensions)
+        : dax::Scalar(1);
+
+    this->Bins.Origin = minBounds;
+    for (int dim = 0; dim < 3; dim++)
+      {
+      if (size[dim] > 0)
+        {
+        const dax::Id dimension =
+            static_cast<dax::Id>(dax::math::Ceil(size[dim]/binSize));
+        this->Bins.Dimensions[dim] = (dimension > 1) ? dimension : 1;
+        this->Bins.InverseBinSize[dim] = this->Bins.Dimensions[dim]/size[dim];
+        }
+      else
+        {
+        this->Bins.Dimensions[dim] = 1;
+        this->Bins.InverseBinSize[dim] = 1;
+        }
+      }
+  }
+
+  GridType Grid;
+  dax::Scalar CellsPerBin;
+  dax::exec::internal::CellLocatorBins Bins;
+  IdArrayType BinCounts;
+  IdArrayType BinOffsets;
+  IdArrayType BinCellIds;
+  bool Valid;
+};
+
+}
+}
+
+#endif //__dax_cont_CellLocator_h
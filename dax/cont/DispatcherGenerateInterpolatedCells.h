@@ -19,11 +19,19 @@
 #include <dax/Types.h>
 
 #include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/TopologyPlan.h>
 
 #include <dax/cont/dispatcher/AddVisitIndexArg.h>
+#include <dax/cont/dispatcher/ResolveDuplicatePointsByHash.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/cont/internal/EdgeInterpolatedGrid.h>
+#include <dax/cont/internal/GridTags.h>
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
+#include <dax/exec/internal/kernel/StructuredEdgeWorklets.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
 #include <dax/internal/ParameterPack.h>
 #include <dax/math/Compare.h>
@@ -52,22 +60,51 @@ class DispatcherGenerateInterpolatedCells :
                                                  WorkletType_,
                                                  DeviceAdapterTag_>;
 
-  typedef dax::cont::ArrayHandle< dax::PointAsEdgeInterpolation,
-                  dax::cont::ArrayContainerControlTagBasic,
-                  DeviceAdapterTag_ >  InterpolationWeightsType;
+  typedef typename dax::cont::TopologyPlan<
+      DeviceAdapterTag_>::InterpolationWeightsType InterpolationWeightsType;
 public:
   typedef WorkletType_ WorkletType;
   typedef CountHandleType_ CountHandleType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
+  typedef dax::cont::TopologyPlan<DeviceAdapterTag> TopologyPlanType;
+
+  /// How duplicate points are found when they are removed.
+  ///
+  enum DuplicatePointResolution
+    {
+    /// Sort the interpolated points by edge and keep one of each run of
+    /// equal points. The output points are ordered by edge.
+    RESOLVE_DUPLICATES_BY_SORT,
+    /// Sort 64-bit keys of a 32-bit hash of the edge and the index of each
+    /// interpolated point instead of the points themselves, and merge the
+    /// equal points among those with the same hash. The output points keep
+    /// the order in which the cells first use them.
+    RESOLVE_DUPLICATES_BY_HASH,
+    /// For uniform grid inputs, name each interpolated point by the grid
+    /// edge it lies on, flag the used edges and number them with a scan.
+    /// Needs memory for three edges per input point, but no sort, and the
+    /// output points are ordered the same way as when sorting. Points that
+    /// name the same edge with their end points swapped are merged too, and
+    /// keep the weight of the first of them with the end points in
+    /// increasing order; sorting merges only points named the same way.
+    /// Only valid for worklets that interpolate along the edges of the
+    /// voxels, like MarchingCubesGenerate and SliceGenerate; Invoke throws
+    /// dax::cont::ErrorExecution when a point lies on any other segment.
+    /// Other grid types fall back to sorting.
+    RESOLVE_DUPLICATES_BY_EDGE
+    };
+
 
   DAX_CONT_EXPORT
   DispatcherGenerateInterpolatedCells(const CountHandleType &count):
     Superclass( WorkletType() ),
     RemoveDuplicatePoints(true),
+    Resolution(RESOLVE_DUPLICATES_BY_SORT),
     ReleaseCount(true),
     Count(count),
-    InterpolationWeights()
+    InterpolationWeights(),
+    Plan()
     { }
 
   DAX_CONT_EXPORT
@@ -75,9 +112,11 @@ public:
                             const WorkletType& work):
     Superclass( work ),
     RemoveDuplicatePoints(true),
+    Resolution(RESOLVE_DUPLICATES_BY_SORT),
     ReleaseCount(true),
     Count(count),
-    InterpolationWeights()
+    InterpolationWeights(),
+    Plan()
     { }
 
 
@@ -103,6 +142,16 @@ public:
   bool GetRemoveDuplicatePoints() const
     { return RemoveDuplicatePoints; }
 
+  /// Selects how duplicate points are found when SetRemoveDuplicatePoints
+  /// is on. The default sorts the points.
+  ///
+  DAX_CONT_EXPORT
+  void SetDuplicatePointResolution(DuplicatePointResolution mode)
+    { Resolution = mode; }
+
+  DAX_CONT_EXPORT
+  DuplicatePointResolution GetDuplicatePointResolution() const
+    { return Resolution; }
 
   template<typename T,
            typename Container1,
@@ -113,6 +162,10 @@ public:
       const dax::cont::ArrayHandle<T,Container1,DeviceAdapter>& input,
       dax::cont::ArrayHandle<T,Container2,DeviceAdapter>& output)
     {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::CompactPointField");
+    ProfilePhaseType phase(this->GetActiveProfile(), "CompactPointField",
+                           this->InterpolationWeights.GetNumberOfValues());
 
     typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
                                         Algorithm;
@@ -140,7 +193,43 @@ public:
     return true;
     }
 
+  /// Same as CompactPointField for several fields of the same type at once.
+  /// All the fields are interpolated in a single pass that reads the
+  /// interpolation weights once, instead of once per field.
+  ///
+  template<typename T,
+           typename Container1,
+           typename Container2,
+           int NumFields>
+  DAX_CONT_EXPORT
+  bool CompactPointFields(
+      const dax::Tuple<dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>,
+                       NumFields>& inputs,
+      dax::Tuple<dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>,
+                 NumFields>& outputs)
+    {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::CompactPointFields");
+    ProfilePhaseType phase(this->GetActiveProfile(), "CompactPointFields",
+                           this->InterpolationWeights.GetNumberOfValues());
+
+    dax::cont::detail::InterpolatePointFields(this->InterpolationWeights,
+                                              inputs,
+                                              outputs);
+    return true;
+    }
+
+  /// The plan of the last Invoke: which input cell every output cell came
+  /// from, their visit index, and the interpolation weights of the output
+  /// points. Use it to map any number of point and cell fields to the
+  /// output, now or after their values change.
+  ///
+  DAX_CONT_EXPORT
+  TopologyPlanType GetTopologyPlan() const { return this->Plan; }
+
 private:
+  typedef dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+      ProfilePhaseType;
 
   template<typename ParameterPackType>
   DAX_CONT_EXPORT
@@ -164,23 +253,54 @@ private:
       OutputGrid outputGrid,
       const ParameterPackType &arguments)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::GenerateNewTopology");
     typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
         Algorithm;
     typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
         DeviceAdapterTag> IdArrayHandleType;
 
+    this->Plan = TopologyPlanType();
+
+    // The interpolated grid stores its connections like the output grid
+    // does, so grids with compact (for example 32-bit) connections keep
+    // them compact through the whole generate.
     dax::cont::internal::EdgeInterpolatedGrid<
         typename OutputGrid::CellTag,
-        ArrayContainerControlTagBasic,
+        typename OutputGrid::CellConnectionsType::ArrayContainerControlTag,
         ArrayContainerControlTagBasic,
         DeviceAdapterTag > edgeInterpolatedOutputGrid;
 
+    //we need to scan the args of the generate topology worklet
+    //and determine if we have the VisitIndex signature. If we do,
+    //we have to call a different Invoke algorithm, which properly uploads
+    //the visitIndex information. Since this information is slow to compute we don't
+    //want to always upload the information, instead only compute when explicitly
+    //requested
+
+    //The AddVisitIndexArg does all this, plus creates a derived worklet
+    //from the users worklet with the visit index added to the signature.
+    typedef dax::cont::dispatcher::AddVisitIndexArg<WorkletType,
+      Algorithm,IdArrayHandleType> AddVisitIndexFunctor;
+    typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
+    typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
+
+    IdArrayHandleType validCellRange;
+    IndexArgType visitIndex;
+    AddVisitIndexFunctor createVisitIndex;
+
+    //we get our magic here. we need to wrap some parameters and pass
+    //them to the real dispatcher
+    DerivedWorkletType derivedWorklet(worklet);
+
     //do an inclusive scan of the cell count / cell mask to get the number
     //of cells in the output
+    ProfilePhaseType scanPhase(this->GetActiveProfile(), "ScanInclusive");
     IdArrayHandleType scannedNewCellCounts;
     const dax::Id numNewCells =
         Algorithm::ScanInclusive(this->GetCount(),
                                  scannedNewCellCounts);
+    scanPhase.Stop(numNewCells);
 
     if(this->GetReleaseCount())
       {
@@ -193,50 +313,27 @@ private:
       return;
       }
 
-
     //now do the uppper bounds of the cell indices so that we figure out
     //which original topology indexs match the new indices.
-    IdArrayHandleType validCellRange;
+    ProfilePhaseType boundsPhase(this->GetActiveProfile(), "UpperBounds",
+                                 numNewCells);
     Algorithm::UpperBounds(scannedNewCellCounts,
                    dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
                    validCellRange);
 
     // We are done with scannedNewCellCounts.
     scannedNewCellCounts.ReleaseResources();
+    boundsPhase.Stop();
 
-    //we need to scan the args of the generate topology worklet
-    //and determine if we have the VisitIndex signature. If we do,
-    //we have to call a different Invoke algorithm, which properly uploads
-    //the visitIndex information. Since this information is slow to compute we don't
-    //want to always upload the information, instead only compute when explicitly
-    //requested
-
-    //The AddVisitIndexArg does all this, plus creates a derived worklet
-    //from the users worklet with the visit index added to the signature.
-    typedef dax::cont::dispatcher::AddVisitIndexArg<WorkletType,
-      Algorithm,IdArrayHandleType> AddVisitIndexFunctor;
-    typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
-    typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
-
-    IndexArgType visitIndex;
-    AddVisitIndexFunctor createVisitIndex;
+    ProfilePhaseType visitPhase(this->GetActiveProfile(), "VisitIndex",
+                                numNewCells);
     createVisitIndex(validCellRange,visitIndex);
+    visitPhase.Stop();
 
-    //create a temporary edge interpolation unstructured grid, that has
-    //the cell indices faked so that the worklet can write out the interpolated
-    //cell points edge interpolation information
-    edgeInterpolatedOutputGrid.GetCellConnections().PrepareForOutput(
-       numNewCells * dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES);
-    dax::cont::DispatcherMapField< dax::exec::internal::kernel::Index >()
-                                      .Invoke(edgeInterpolatedOutputGrid.GetCellConnections());
-
-    //Next step is to set the dispatcher to fill the output geometry
-    //with the interpolated cell values. We use edgeInterpolatedOutputGrid,
-    //since it 'points' are really interpolation of  2 edges and the weight
-
-    //we get our magic here. we need to wrap some parameters and pass
-    //them to the real dispatcher
-    DerivedWorkletType derivedWorklet(worklet);
+    ProfilePhaseType preparePhase(this->GetActiveProfile(),
+                                  "PrepareInterpolatedGrid", numNewCells);
+    this->PrepareInterpolatedGrid(edgeInterpolatedOutputGrid, numNewCells);
+    preparePhase.Stop();
 
     this->BasicInvoke( derivedWorklet,
           arguments.template Replace<1>(
@@ -251,6 +348,28 @@ private:
                              edgeInterpolatedOutputGrid,
                              outputGrid,
                              this->GetRemoveDuplicatePoints());
+
+    TopologyPlanType plan(validCellRange);
+    dax::cont::detail::SetTopologyPlanVisitIndex(plan, visitIndex);
+    plan.SetInterpolationWeights(this->InterpolationWeights);
+    this->Plan = plan;
+  }
+
+  //create a temporary edge interpolation unstructured grid, that has
+  //the cell indices faked so that the worklet can write out the interpolated
+  //cell points edge interpolation information. The worklet fills the output
+  //geometry with the interpolated cell values, since its 'points' are
+  //really interpolation of 2 edges and the weight
+  template <typename InterpolatedGrid>
+  DAX_CONT_EXPORT void PrepareInterpolatedGrid(
+      InterpolatedGrid& interpolatedGrid,
+      dax::Id numNewCells) const
+  {
+    interpolatedGrid.GetCellConnections().PrepareForOutput(
+       numNewCells *
+       dax::CellTraits<typename InterpolatedGrid::CellTag>::NUM_VERTICES);
+    dax::cont::DispatcherMapField< dax::exec::internal::kernel::Index >()
+                              .Invoke(interpolatedGrid.GetCellConnections());
   }
 
   //take the input grid and the interpolated grid to produce the new points
@@ -264,26 +383,66 @@ private:
                                           OutputGrid& outputGrid,
                                           bool removeDuplicates )
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::ResolveCoordinates");
     typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
         Algorithm;
 
     // We need to store the interpolation weights to be able to interpolate
     // point scalar fields (including point coordinates). We also need to
     // find duplicate interpolations if we want to remove duplicate points.
-    Algorithm::Copy(interpolatedGrid.GetInterpolatedPoints(),
-                    this->InterpolationWeights);
+    // Start from a new array, as the weights of the previous invoke may be
+    // shared by an exported plan. The edge and hash resolutions write only
+    // the unique weights, so only the other paths copy all of them.
+    this->InterpolationWeights = InterpolationWeightsType();
+
+    const bool resolvedByEdge = removeDuplicates &&
+        (this->GetDuplicatePointResolution() == RESOLVE_DUPLICATES_BY_EDGE) &&
+        this->ResolveDuplicatePointsByEdge(
+          inputGrid,
+          interpolatedGrid.GetInterpolatedPoints(),
+          outputGrid.GetCellConnections(),
+          typename InputGrid::GridTypeTag());
+
+    if(resolvedByEdge)
+      {
+      this->CompactPointField(inputGrid.GetPointCoordinates(),
+                              outputGrid.GetPointCoordinates());
+      }
+    else if(removeDuplicates &&
+       this->GetDuplicatePointResolution() == RESOLVE_DUPLICATES_BY_HASH)
+      {
+      this->ResolveDuplicatePointsByHash(
+            interpolatedGrid.GetInterpolatedPoints(),
+            outputGrid.GetCellConnections());
 
-    if(removeDuplicates)
+      this->CompactPointField(inputGrid.GetPointCoordinates(),
+                              outputGrid.GetPointCoordinates());
+      }
+    else if(removeDuplicates)
       {
+      this->CopyInterpolationWeights(interpolatedGrid);
+
       // the sort and unique will get us the subset of new points
       // the lower bounds on the subset and the original coords, will produce
       // the resulting topology array
+      ProfilePhaseType sortPhase(this->GetActiveProfile(), "Sort",
+                                 this->InterpolationWeights.GetNumberOfValues());
       Algorithm::Sort(this->InterpolationWeights);
+      sortPhase.Stop();
+
+      ProfilePhaseType uniquePhase(this->GetActiveProfile(), "Unique");
       Algorithm::Unique(this->InterpolationWeights);
+      uniquePhase.Stop(this->InterpolationWeights.GetNumberOfValues());
+
+      ProfilePhaseType boundsPhase(
+            this->GetActiveProfile(), "LowerBounds",
+            interpolatedGrid.GetInterpolatedPoints().GetNumberOfValues());
       Algorithm::LowerBounds(this->InterpolationWeights,
                              interpolatedGrid.GetInterpolatedPoints(),
                              outputGrid.GetCellConnections()
                              );
+      boundsPhase.Stop();
 
 
       this->CompactPointField(inputGrid.GetPointCoordinates(),
@@ -291,20 +450,163 @@ private:
       }
     else
       {
+      this->CopyInterpolationWeights(interpolatedGrid);
+
       this->CompactPointField(inputGrid.GetPointCoordinates(),
                               outputGrid.GetPointCoordinates());
       //we need to  copy the cells connections from the interpolatedGrid
       //over to the output grid
+      ProfilePhaseType copyConnectionsPhase(
+            this->GetActiveProfile(), "CopyConnections",
+            interpolatedGrid.GetCellConnections().GetNumberOfValues());
       Algorithm::Copy(interpolatedGrid.GetCellConnections(),
                       outputGrid.GetCellConnections());
       }
   }
 
+  //keep a weight for every interpolated point
+  template <typename InterpolatedGrid>
+  DAX_CONT_EXPORT void CopyInterpolationWeights(
+      const InterpolatedGrid& interpolatedGrid)
+  {
+    ProfilePhaseType copyPhase(
+          this->GetActiveProfile(), "CopyWeights",
+          interpolatedGrid.GetInterpolatedPoints().GetNumberOfValues());
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+          interpolatedGrid.GetInterpolatedPoints(),
+          this->InterpolationWeights);
+  }
+
+  //find the unique interpolated points by sorting a hash of their edge,
+  //and write the connections of the output cells to them
+  template <typename RecordsHandleType, typename ConnectionsHandleType>
+  DAX_CONT_EXPORT void ResolveDuplicatePointsByHash(
+      const RecordsHandleType& records,
+      ConnectionsHandleType& connections)
+  {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::ResolveDuplicatePointsByHash");
+    ProfilePhaseType phase(this->GetActiveProfile(),
+                           "ResolveDuplicatePointsByHash",
+                           records.GetNumberOfValues());
+    dax::cont::dispatcher::ResolveDuplicatePointsByHash<DeviceAdapterTag>(
+          records, this->InterpolationWeights, connections);
+  }
+
+  //find the unique interpolated points of a uniform grid by flagging the
+  //grid edges they lie on, and write the connections of the output cells
+  //to them. The edge flags are scanned to number the output points, and
+  //the first record on each edge gives its weight.
+  template <typename InputGrid,
+            typename RecordsHandleType,
+            typename ConnectionsHandleType>
+  DAX_CONT_EXPORT bool ResolveDuplicatePointsByEdge(
+      const InputGrid& inputGrid,
+      const RecordsHandleType& records,
+      ConnectionsHandleType& connections,
+      dax::cont::internal::UniformGridTag)
+  {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateInterpolatedCells::ResolveDuplicatePointsByEdge");
+    ProfilePhaseType phase(this->GetActiveProfile(),
+                           "ResolveDuplicatePointsByEdge",
+                           records.GetNumberOfValues());
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef typename RecordsHandleType::PortalConstExecution RecordsPortalType;
+    typedef typename IdArrayHandleType::PortalConstExecution IdPortalConstType;
+    typedef typename IdArrayHandleType::PortalExecution IdPortalType;
+
+    const dax::Id numRecords = records.GetNumberOfValues();
+    const dax::Id3 pointDimensions =
+        dax::extentDimensions(inputGrid.GetExtent());
+    const dax::Id numEdges = 3*inputGrid.GetNumberOfPoints();
+    if (numRecords == 0)
+      {
+      this->InterpolationWeights.PrepareForOutput(0);
+      connections.PrepareForOutput(0);
+      return true;
+      }
+
+    IdArrayHandleType edgeFlags;
+    Algorithm::Copy(dax::cont::make_ArrayHandleConstant(dax::Id(0), numEdges),
+                    edgeFlags);
+    IdArrayHandleType edgeOwners;
+    Algorithm::Copy(dax::cont::make_ArrayHandleConstant(numRecords, numEdges),
+                    edgeOwners);
+
+    //each edge is owned by the first record on it, so the output does not
+    //depend on the order the records are scheduled in. A pass that lowers
+    //no owner ends the loop; it takes one more pass than the number of
+    //times records of the same edge raced on the owner.
+    IdArrayHandleType pending;
+    dax::Id pendingValue = 1;
+    while (pendingValue != 0)
+      {
+      Algorithm::Copy(dax::cont::make_ArrayHandleConstant(dax::Id(0), 1),
+                      pending);
+      dax::exec::internal::kernel::StructuredEdgeClaimFunctor<
+          RecordsPortalType, IdPortalType, IdPortalType, IdPortalType>
+          claim(records.PrepareForInput(),
+                edgeFlags.PrepareForInPlace(),
+                edgeOwners.PrepareForInPlace(),
+                pending.PrepareForInPlace(),
+                pointDimensions);
+      Algorithm::Schedule(claim, numRecords);
+      pendingValue = pending.GetPortalConstControl().Get(0);
+      }
+
+    //the owners of the flagged edges come out in edge order, which is the
+    //order of the sorted interpolated points
+    IdArrayHandleType uniqueOwners;
+    Algorithm::StreamCompact(edgeOwners, edgeFlags, uniqueOwners);
+    edgeOwners.ReleaseResources();
+
+    const dax::Id numUniquePoints = uniqueOwners.GetNumberOfValues();
+    dax::exec::internal::kernel::StructuredEdgeWeightsFunctor<
+        RecordsPortalType, IdPortalConstType,
+        typename InterpolationWeightsType::PortalExecution>
+        weights(records.PrepareForInput(),
+                uniqueOwners.PrepareForInput(),
+                this->InterpolationWeights.PrepareForOutput(numUniquePoints));
+    Algorithm::Schedule(weights, numUniquePoints);
+    uniqueOwners.ReleaseResources();
+
+    Algorithm::ScanExclusive(edgeFlags, edgeFlags);
+
+    dax::exec::internal::kernel::StructuredEdgeConnectionsFunctor<
+        RecordsPortalType, IdPortalConstType,
+        typename ConnectionsHandleType::PortalExecution>
+        connect(records.PrepareForInput(),
+                edgeFlags.PrepareForInput(),
+                connections.PrepareForOutput(numRecords),
+                pointDimensions);
+    Algorithm::Schedule(connect, numRecords);
+    return true;
+  }
+
+  template <typename InputGrid,
+            typename RecordsHandleType,
+            typename ConnectionsHandleType,
+            typename GridTagType>
+  DAX_CONT_EXPORT bool ResolveDuplicatePointsByEdge(
+      const InputGrid&,
+      const RecordsHandleType&,
+      ConnectionsHandleType&,
+      GridTagType)
+  {
+    //the points of other grids do not have structured edges
+    return false;
+  }
 
   bool RemoveDuplicatePoints;
+  DuplicatePointResolution Resolution;
   bool ReleaseCount;
   CountHandleType Count;
   InterpolationWeightsType InterpolationWeights;
+  TopologyPlanType Plan;
 
 };
 
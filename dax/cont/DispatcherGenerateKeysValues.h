@@ -18,11 +18,13 @@
 
 #include <dax/Types.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletGenerateKeysValues.h>
 #include <dax/internal/ParameterPack.h>
 
 #include <dax/cont/dispatcher/AddVisitIndexArg.h>
+#include <dax/cont/dispatcher/GenerateFanout.h>
 
 namespace dax { namespace cont {
 
@@ -57,6 +59,8 @@ public:
   DispatcherGenerateKeysValues(OutputCountType outputCountArray):
     Superclass(WorkletType()),
     ReleaseOutputCountArray(true),
+    FixedFanout(false),
+    CountPerCell(0),
     OutputCountArray(outputCountArray)
     { }
 
@@ -64,9 +68,34 @@ public:
   DispatcherGenerateKeysValues(OutputCountType outputCountArray, WorkletType& work):
     Superclass( work ),
     ReleaseOutputCountArray(true),
+    FixedFanout(false),
+    CountPerCell(0),
     OutputCountArray(outputCountArray)
     { }
 
+  /// Generates \c countPerCell key/value pairs from every input cell.
+  /// Output \c i then comes from input cell <tt>i / countPerCell</tt> with
+  /// visit index <tt>i % countPerCell</tt>, computed on the fly instead of
+  /// scanning an output count array and searching the result.
+  ///
+  DAX_CONT_EXPORT
+  DispatcherGenerateKeysValues(dax::Id countPerCell):
+    Superclass(WorkletType()),
+    ReleaseOutputCountArray(true),
+    FixedFanout(true),
+    CountPerCell(countPerCell),
+    OutputCountArray()
+    { }
+
+  DAX_CONT_EXPORT
+  DispatcherGenerateKeysValues(dax::Id countPerCell, WorkletType& work):
+    Superclass( work ),
+    ReleaseOutputCountArray(true),
+    FixedFanout(true),
+    CountPerCell(countPerCell),
+    OutputCountArray()
+    { }
+
   DAX_CONT_EXPORT void SetReleaseOutputCountArray(bool flag){
     this->ReleaseOutputCountArray = flag;
   }
@@ -83,7 +112,20 @@ public:
     this->OutputCountArray.ReleaseResourcesExecution();
   }
 
+  /// True when constructed with a number of outputs per input cell instead
+  /// of an output count array.
+  ///
+  DAX_CONT_EXPORT bool GetFixedFanout() const {
+    return this->FixedFanout;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetCountPerCell() const {
+    return this->CountPerCell;
+  }
+
 private:
+  typedef dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+      ProfilePhaseType;
 
   template<typename ParameterPackType>
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
@@ -103,16 +145,26 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
     const InputGrid inputGrid,
     const ParameterPackType &arguments)
   {
+  dax::cont::MemoryTrackerScope memoryScope(
+      "DispatcherGenerateKeysValues::InvokeGenerateKeysValues");
   typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
   typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
       DeviceAdapterTag> IdArrayHandleType;
 
+  if(this->GetFixedFanout())
+    {
+    this->InvokeFixedFanout(worklet, inputGrid, arguments);
+    return;
+    }
+
   //do an inclusive scan of the cell count / cell mask to get the number
   //of cells in the output
+  ProfilePhaseType scanPhase(this->GetActiveProfile(), "ScanInclusive");
   IdArrayHandleType scannedOutputCounts;
   const dax::Id numNewValues =
       Algorithm::ScanInclusive(this->GetOutputCountArray(),
                                scannedOutputCounts);
+  scanPhase.Stop(numNewValues);
 
   if(this->GetReleaseOutputCountArray())
     {
@@ -127,6 +179,8 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
 
 
   //now do the lower bounds of the cell indices so that we figure out
+  ProfilePhaseType boundsPhase(this->GetActiveProfile(), "UpperBounds",
+                               numNewValues);
   IdArrayHandleType outputIndexRanges;
   Algorithm::UpperBounds(scannedOutputCounts,
                  dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewValues),
@@ -134,6 +188,7 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
 
   // We are done with scannedOutputCounts.
   scannedOutputCounts.ReleaseResources();
+  boundsPhase.Stop();
 
   //we need to scan the args of the generate topology worklet and determine if
   //we have the VisitIndex signature. If we do, we have to call a different
@@ -148,9 +203,12 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
   typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
   typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
 
+  ProfilePhaseType visitPhase(this->GetActiveProfile(), "VisitIndex",
+                              numNewValues);
   IndexArgType visitIndex;
   AddVisitIndexFunctor createVisitIndex;
   createVisitIndex(outputIndexRanges,visitIndex);
+  visitPhase.Stop();
 
   DerivedWorkletType derivedWorklet(worklet);
 
@@ -163,7 +221,44 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
         .Append(visitIndex));
   }
 
+template <typename InputGrid,
+          typename ParameterPackType>
+DAX_CONT_EXPORT void InvokeFixedFanout(
+    WorkletType worklet,
+    const InputGrid inputGrid,
+    const ParameterPackType &arguments)
+  {
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef dax::cont::dispatcher::GenerateFanout<DeviceAdapterTag> FanoutType;
+
+  //the input cell and visit index of every output are implicit arrays
+  FanoutType fanout(inputGrid.GetNumberOfCells(), this->GetCountPerCell());
+  if(fanout.GetNumberOfOutputs() == 0)
+    {
+    //nothing to do
+    return;
+    }
+
+  typedef dax::cont::dispatcher::AddVisitIndexArg<WorkletType,
+    Algorithm,typename FanoutType::VisitIndexType> AddVisitIndexFunctor;
+  typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
+  typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
+
+  IndexArgType visitIndex;
+  AddVisitIndexFunctor().UseVisitIndex(fanout.GetVisitIndex(),visitIndex);
+
+  DerivedWorkletType derivedWorklet(worklet);
+
+  this->BasicInvoke( derivedWorklet,
+        arguments.template Replace<1>(
+            dax::cont::make_Permutation(fanout.GetCellMap(),inputGrid,
+                                        inputGrid.GetNumberOfCells()))
+        .Append(visitIndex));
+  }
+
   bool ReleaseOutputCountArray;
+  bool FixedFanout;
+  dax::Id CountPerCell;
   OutputCountType OutputCountArray;
 };
 
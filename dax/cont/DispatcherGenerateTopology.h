@@ -19,11 +19,14 @@
 #include <dax/Types.h>
 
 #include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/TopologyPlan.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletGenerateTopology.h>
 #include <dax/internal/ParameterPack.h>
 
 #include <dax/cont/dispatcher/AddVisitIndexArg.h>
+#include <dax/cont/dispatcher/GenerateFanout.h>
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
 
 namespace dax { namespace cont {
@@ -55,17 +58,19 @@ public:
   typedef CountHandleType_ CountHandleType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
-  typedef dax::cont::ArrayHandle< dax::Id,
-            dax::cont::ArrayContainerControlTagBasic,
-            DeviceAdapterTag> PointMaskType;
+  typedef dax::cont::TopologyPlan<DeviceAdapterTag> TopologyPlanType;
+  typedef typename TopologyPlanType::PointMaskType PointMaskType;
 
   DAX_CONT_EXPORT
   DispatcherGenerateTopology(CountHandleType count):
     Superclass(WorkletType()),
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
+    FixedFanout(false),
+    CountPerCell(0),
     Count(count),
-    PointMask()
+    PointMask(),
+    Plan()
     { }
 
   DAX_CONT_EXPORT
@@ -73,8 +78,40 @@ public:
     Superclass(work),
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
+    FixedFanout(false),
+    CountPerCell(0),
     Count(count),
-    PointMask()
+    PointMask(),
+    Plan()
+    { }
+
+  /// Generates \c countPerCell cells from every input cell. Output cell
+  /// \c i then comes from input cell <tt>i / countPerCell</tt> with visit
+  /// index <tt>i % countPerCell</tt>, which the dispatcher computes on the
+  /// fly instead of scanning a count array and searching the result.
+  ///
+  DAX_CONT_EXPORT
+  DispatcherGenerateTopology(dax::Id countPerCell):
+    Superclass(WorkletType()),
+    RemoveDuplicatePoints(true),
+    ReleaseCount(true),
+    FixedFanout(true),
+    CountPerCell(countPerCell),
+    Count(),
+    PointMask(),
+    Plan()
+    { }
+
+  DAX_CONT_EXPORT
+  DispatcherGenerateTopology(dax::Id countPerCell, WorkletType& work):
+    Superclass(work),
+    RemoveDuplicatePoints(true),
+    ReleaseCount(true),
+    FixedFanout(true),
+    CountPerCell(countPerCell),
+    Count(),
+    PointMask(),
+    Plan()
     { }
 
   DAX_CONT_EXPORT void SetReleaseCount(bool b)
@@ -86,6 +123,15 @@ public:
   DAX_CONT_EXPORT CountHandleType GetCount() const
     { return Count; }
 
+  /// True when constructed with a number of cells per input cell instead
+  /// of a count array.
+  ///
+  DAX_CONT_EXPORT bool GetFixedFanout() const
+    { return FixedFanout; }
+
+  DAX_CONT_EXPORT dax::Id GetCountPerCell() const
+    { return CountPerCell; }
+
   DAX_CONT_EXPORT void DoReleaseCount()
     { Count.ReleaseResourcesExecution(); }
 
@@ -105,6 +151,8 @@ public:
     const bool valid = this->GetRemoveDuplicatePoints();
     if(valid)
       {
+      ProfilePhaseType phase(this->GetActiveProfile(), "CompactPointField",
+                             input.GetNumberOfValues());
       dax::cont::DeviceAdapterAlgorithm<DeviceAdapter>::
           StreamCompact(input, this->PointMask, output);
 
@@ -112,7 +160,40 @@ public:
     return valid;
     }
 
+  /// Same as CompactPointField for several fields of the same type at once.
+  /// All the fields are compacted in a single pass that reads the point mask
+  /// once, instead of once per field.
+  ///
+  template<typename T, typename Container1, typename Container2,
+           int NumFields>
+  DAX_CONT_EXPORT
+  bool CompactPointFields(
+      const dax::Tuple<dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>,
+                       NumFields>& inputs,
+      dax::Tuple<dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>,
+                 NumFields>& outputs)
+    {
+    const bool valid = this->GetRemoveDuplicatePoints();
+    if(valid)
+      {
+      ProfilePhaseType phase(this->GetActiveProfile(), "CompactPointFields",
+                             this->PointMask.GetNumberOfValues());
+      dax::cont::detail::MaskPointFields(this->PointMask, inputs, outputs);
+      }
+    return valid;
+    }
+
+  /// The plan of the last Invoke: which input cell every output cell came
+  /// from, their visit index, and the point mask when duplicate points are
+  /// removed. Use it to map any number of point and cell fields to the
+  /// output, now or after their values change.
+  ///
+  DAX_CONT_EXPORT
+  TopologyPlanType GetTopologyPlan() const { return this->Plan; }
+
 private:
+  typedef dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+      ProfilePhaseType;
 
   template<typename ParameterPackType>
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
@@ -134,38 +215,14 @@ private:
       OutputGrid outputGrid,
       const ParameterPackType &arguments)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateTopology::GenerateNewTopology");
     typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
         Algorithm;
     typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
         DeviceAdapterTag> IdArrayHandleType;
 
-    //do an inclusive scan of the cell count / cell mask to get the number
-    //of cells in the output
-    IdArrayHandleType scannedNewCellCounts;
-    const dax::Id numNewCells =
-        Algorithm::ScanInclusive(this->GetCount(),
-                                 scannedNewCellCounts);
-
-    if(this->GetReleaseCount())
-      {
-      this->DoReleaseCount();
-      }
-
-    if(numNewCells == 0)
-      {
-      //nothing to do
-      return;
-      }
-
-    //now do the lower bounds of the cell indices so that we figure out
-    //which original topology indexs match the new indices.
-    IdArrayHandleType validCellRange;
-    Algorithm::UpperBounds(scannedNewCellCounts,
-                   dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                   validCellRange);
-
-    // We are done with scannedNewCellCounts.
-    scannedNewCellCounts.ReleaseResources();
+    this->Plan = TopologyPlanType();
 
     //we need to scan the args of the generate topology worklet
     //and determine if we have the VisitIndex signature. If we do,
@@ -181,26 +238,110 @@ private:
     typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
     typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
 
+    IdArrayHandleType validCellRange;
     IndexArgType visitIndex;
     AddVisitIndexFunctor createVisitIndex;
-    createVisitIndex(validCellRange,visitIndex);
-
     DerivedWorkletType derivedWorklet(worklet);
 
-    //we get our magic here. we need to wrap some paramemters and pass
-    //them to the real dispatcher. The visitIndex must be last, as that is the
-    //hardcoded location the ReplaceAndExtendSignatures will place it at
-    this->BasicInvoke( derivedWorklet,
-          arguments.template Replace<1>(
-            dax::cont::make_Permutation(validCellRange,inputGrid,
-                                        inputGrid.GetNumberOfCells()))
-            .Append(visitIndex));
+    if(this->GetFixedFanout())
+      {
+      //the cell map and visit index are implicit arrays, nothing to compute
+      dax::cont::dispatcher::GenerateFanout<DeviceAdapterTag>
+          fanout(inputGrid.GetNumberOfCells(), this->GetCountPerCell());
+      const dax::Id numNewCells = fanout.GetNumberOfOutputs();
+      if(numNewCells == 0)
+        {
+        //nothing to do
+        return;
+        }
+
+      typedef dax::cont::dispatcher::AddVisitIndexArg<WorkletType,
+        Algorithm,
+        typename dax::cont::dispatcher::GenerateFanout<
+            DeviceAdapterTag>::VisitIndexType> AddFanoutVisitIndexFunctor;
+      typename AddFanoutVisitIndexFunctor::VisitIndexArgType fanoutVisitIndex;
+      AddFanoutVisitIndexFunctor().UseVisitIndex(fanout.GetVisitIndex(),
+                                                 fanoutVisitIndex);
+
+      this->BasicInvoke( derivedWorklet,
+            arguments.template Replace<1>(
+              dax::cont::make_Permutation(fanout.GetCellMap(),inputGrid,
+                                          inputGrid.GetNumberOfCells()))
+              .Append(fanoutVisitIndex));
+      }
+    else
+      {
+      //do an inclusive scan of the cell count / cell mask to get the number
+      //of cells in the output
+      ProfilePhaseType scanPhase(this->GetActiveProfile(), "ScanInclusive");
+      IdArrayHandleType scannedNewCellCounts;
+      const dax::Id numNewCells =
+          Algorithm::ScanInclusive(this->GetCount(),
+                                   scannedNewCellCounts);
+      scanPhase.Stop(numNewCells);
+
+      if(this->GetReleaseCount())
+        {
+        this->DoReleaseCount();
+        }
+
+      if(numNewCells == 0)
+        {
+        //nothing to do
+        return;
+        }
+
+      //now do the lower bounds of the cell indices so that we figure out
+      //which original topology indexs match the new indices.
+      ProfilePhaseType boundsPhase(this->GetActiveProfile(), "UpperBounds",
+                                   numNewCells);
+      Algorithm::UpperBounds(scannedNewCellCounts,
+                     dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
+                     validCellRange);
+
+      // We are done with scannedNewCellCounts.
+      scannedNewCellCounts.ReleaseResources();
+      boundsPhase.Stop();
+
+      ProfilePhaseType visitPhase(this->GetActiveProfile(), "VisitIndex",
+                                  numNewCells);
+      createVisitIndex(validCellRange,visitIndex);
+      visitPhase.Stop();
+
+      //we get our magic here. we need to wrap some paramemters and pass
+      //them to the real dispatcher. The visitIndex must be last, as that is the
+      //hardcoded location the ReplaceAndExtendSignatures will place it at
+      this->BasicInvoke( derivedWorklet,
+            arguments.template Replace<1>(
+              dax::cont::make_Permutation(validCellRange,inputGrid,
+                                          inputGrid.GetNumberOfCells()))
+              .Append(visitIndex));
+      }
+    //with a fixed fanout the plan implies the cell map and visit index
+    TopologyPlanType plan = this->GetFixedFanout() ?
+        TopologyPlanType(inputGrid.GetNumberOfCells(), this->GetCountPerCell()) :
+        TopologyPlanType(validCellRange);
+    if(!this->GetFixedFanout())
+      {
+      dax::cont::detail::SetTopologyPlanVisitIndex(plan, visitIndex);
+      }
+
     //call this here as we have stripped out the input and output grids
     if(this->GetRemoveDuplicatePoints())
       {
+      ProfilePhaseType maskPhase(this->GetActiveProfile(), "FillPointMask",
+                                 inputGrid.GetNumberOfPoints());
       this->FillPointMask(inputGrid,outputGrid);
+      maskPhase.Stop();
+
+      ProfilePhaseType resolvePhase(
+            this->GetActiveProfile(), "ResolveDuplicatePoints",
+            outputGrid.GetCellConnections().GetNumberOfValues());
       this->ResolveDuplicatePoints(inputGrid,outputGrid);
+      resolvePhase.Stop();
+      plan.SetPointMask(this->PointMask);
       }
+    this->Plan = plan;
   }
 
   template<class InGridType, class OutGridType>
@@ -208,7 +349,9 @@ private:
                                      const OutGridType &outGrid)
   {
     // Clear out the mask, have to allocate the size first
-    // so that  works properly
+    // so that  works properly. Start from a new array, as the mask of the
+    // previous invoke may be shared by an exported plan.
+    this->PointMask = PointMaskType();
     this->PointMask.PrepareForOutput(inGrid.GetNumberOfPoints());
 
     dax::cont::DispatcherMapField<
@@ -230,6 +373,8 @@ private:
   DAX_CONT_EXPORT void ResolveDuplicatePoints(const InGridType &inGrid,
                                               OutGridType& outGrid) const
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherGenerateTopology::ResolveDuplicatePoints");
     // Here we are assuming OutGridType is an UnstructuredGrid so that we
     // can set point and connectivity information.
 
@@ -259,8 +404,11 @@ private:
 
   bool RemoveDuplicatePoints;
   bool ReleaseCount;
+  bool FixedFanout;
+  dax::Id CountPerCell;
   CountHandleType Count;
   PointMaskType PointMask;
+  TopologyPlanType Plan;
 };
 
 } } //namespace dax::cont
@@ -22,6 +22,8 @@
 #include <dax/exec/WorkletMapCell.h>
 #include <dax/internal/ParameterPack.h>
 
+#include <boost/mpl/int.hpp>
+
 namespace dax { namespace cont {
 
 template <
@@ -48,19 +50,56 @@ public:
   typedef WorkletType_ WorkletType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
-  DAX_CONT_EXPORT DispatcherMapCell() : Superclass(WorkletType())
+  DAX_CONT_EXPORT DispatcherMapCell()
+    : Superclass(WorkletType()), MortonTraversal(false)
     { }
-  DAX_CONT_EXPORT DispatcherMapCell(WorkletType worklet) : Superclass(worklet)
+  DAX_CONT_EXPORT DispatcherMapCell(WorkletType worklet)
+    : Superclass(worklet), MortonTraversal(false)
     { }
 
+  /// When true, the cells of a uniform grid are visited in Morton (Z-curve)
+  /// order over small bricks instead of row-major order. Neighbouring cells
+  /// in k are then processed close together in time, which improves the
+  /// reuse of the point data they share on large grids. Results are still
+  /// written at the usual flat cell index. Other grid types ignore this
+  /// option. The default is false.
+  ///
+  DAX_CONT_EXPORT void SetMortonTraversal(bool flag)
+    { this->MortonTraversal = flag; }
+  DAX_CONT_EXPORT bool GetMortonTraversal() const
+    { return this->MortonTraversal; }
+
 private:
   template<typename ParameterPackType>
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
                                 ParameterPackType arguments) const
   {
-    this->BasicInvoke(worklet, arguments);
+    // Grids with mixed cell types need the worklet to be instantiated for
+    // every cell type, which the basic invoke cannot do.
+    typedef dax::cont::dispatcher::FindMixedGridArgument<ParameterPackType>
+        MixedGridArgument;
+    this->DoInvoke(worklet,
+                   arguments,
+                   boost::mpl::int_<MixedGridArgument::INDEX>());
+  }
+
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
+                                ParameterPackType arguments,
+                                boost::mpl::int_<0>) const
+  {
+    this->BasicInvokeWithTraversal(worklet, arguments, this->MortonTraversal);
+  }
+
+  template<typename ParameterPackType, int MixedGridIndex>
+  DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
+                                ParameterPackType arguments,
+                                boost::mpl::int_<MixedGridIndex>) const
+  {
+    this->template MixedCellInvoke<MixedGridIndex>(worklet, arguments);
   }
 
+  bool MortonTraversal;
 };
 
 } }
@@ -0,0 +1,110 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_DispatcherMapPoint_h
+#define __dax_cont_DispatcherMapPoint_h
+
+#include <dax/Types.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/PointToCellLinks.h>
+#include <dax/cont/internal/DeviceAdapterTag.h>
+#include <dax/cont/dispatcher/AddReduceKeysArgs.h>
+#include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/exec/WorkletMapPoint.h>
+#include <dax/internal/ParameterPack.h>
+
+namespace dax { namespace cont {
+
+/// \brief Dispatcher for dax::exec::WorkletMapPoint worklets.
+///
+/// The dispatcher is created from the point to cell links of a grid (see
+/// dax::cont::UnstructuredGrid::BuildPointToCellLinks) and schedules the
+/// worklet once per point. Arguments wrapped with AsIncidentCells gather the
+/// values of the cells incident to the point straight from the links, so
+/// mapping an additional cell field costs a single gather pass.
+///
+template <
+  class WorkletType_,
+  class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class DispatcherMapPoint :
+  public dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapPoint< WorkletType_, DeviceAdapterTag_ >,
+          dax::exec::WorkletMapPoint,
+          WorkletType_,
+          DeviceAdapterTag_ >
+{
+
+  typedef dax::cont::dispatcher::DispatcherBase< DispatcherMapPoint< WorkletType_, DeviceAdapterTag_>,
+                                                 dax::exec::WorkletMapPoint,
+                                                 WorkletType_,
+                                                 DeviceAdapterTag_> Superclass;
+  friend class dax::cont::dispatcher::DispatcherBase< DispatcherMapPoint< WorkletType_, DeviceAdapterTag_>,
+                                                 dax::exec::WorkletMapPoint,
+                                                 WorkletType_,
+                                                 DeviceAdapterTag_>;
+
+public:
+  typedef WorkletType_ WorkletType;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::PointToCellLinks<DeviceAdapterTag> PointToCellLinksType;
+
+  DAX_CONT_EXPORT
+  DispatcherMapPoint(const PointToCellLinksType &links)
+    : Superclass(WorkletType()), Links(links)
+    { }
+
+  DAX_CONT_EXPORT
+  DispatcherMapPoint(const PointToCellLinksType &links,
+                     const WorkletType &worklet)
+    : Superclass(worklet), Links(links)
+    { }
+
+  DAX_CONT_EXPORT
+  const PointToCellLinksType &GetPointToCellLinks() const
+    { return this->Links; }
+
+private:
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
+                                ParameterPackType arguments) const
+  {
+    if (!this->Links.IsValid())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "DispatcherMapPoint requires point to cell links that have been "
+            "built.");
+      }
+
+    // The incident cells of a point are exactly a key group of the reduce
+    // keys/values worklets, with the links as the reduction map. Reuse the
+    // same signature rewrite to append the links to the arguments.
+    typedef typename dax::cont::dispatcher::AddReduceKeysArgs<
+                  WorkletType>::DerivedWorkletType DerivedWorkletType;
+
+    DerivedWorkletType derivedWorklet(worklet);
+    this->BasicInvoke(derivedWorklet,
+                      arguments.Append(this->Links.GetCounts())
+                      .Append(this->Links.GetOffsets())
+                      .Append(this->Links.GetCellIds()),
+                      this->Links.GetNumberOfPoints());
+  }
+
+  PointToCellLinksType Links;
+};
+
+} } // namespace dax::cont
+
+#endif //__dax_cont_DispatcherMapPoint_h
@@ -0,0 +1,171 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_DispatcherProfile_h
+#define __dax_cont_DispatcherProfile_h
+
+#include <dax/Types.h>
+
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dax {
+namespace cont {
+
+/// \brief The time and memory taken by each phase of a dispatcher invoke.
+///
+/// A dispatcher fills its profile when profiling is turned on with its
+/// SetProfiling. Every internal phase of an invoke, such as the scan of the
+/// counts, the search for the input cells, the worklet itself or the merge
+/// of duplicate points, is timed with a dax::cont::Timer, which synchronizes
+/// with the device. When the MemoryTracker is enabled, the bytes of the
+/// arrays allocated during each phase are taken from it as well; profiling
+/// never enables it by itself. The profile is cleared at the start of
+/// every Invoke; phases run later, such as CompactPointField, are added to
+/// the profile of the last Invoke.
+///
+/// A callback can be given to see each phase as soon as it completes, for
+/// example to stream the phases to a log.
+///
+class DispatcherProfile
+{
+public:
+  /// The record of one phase.
+  ///
+  struct Phase
+  {
+    Phase() : Seconds(0), NumberOfValues(0), BytesAllocated(0) {  }
+
+    /// The name of the phase, such as "ScanInclusive" or "Worklet".
+    std::string Name;
+    /// The wall time the phase took.
+    double Seconds;
+    /// The number of values the phase worked on or produced.
+    dax::Id NumberOfValues;
+    /// Bytes of the arrays allocated during the phase, whether freed or not.
+    /// Zero unless the MemoryTracker was enabled.
+    std::size_t BytesAllocated;
+  };
+
+  typedef std::vector<Phase> PhaseListType;
+
+  /// Called with each phase as it completes, and the client data given to
+  /// SetCallback.
+  ///
+  typedef void (*CallbackType)(const Phase &phase, void *clientData);
+
+  DAX_CONT_EXPORT
+  DispatcherProfile()
+    : InvokeSeconds(0), Callback(NULL), CallbackClientData(NULL) {  }
+
+  /// The phases in the order they completed.
+  ///
+  DAX_CONT_EXPORT
+  const PhaseListType &GetPhases() const { return this->Phases; }
+
+  /// The wall time of the last Invoke, including the work done between its
+  /// phases.
+  ///
+  DAX_CONT_EXPORT
+  double GetInvokeSeconds() const { return this->InvokeSeconds; }
+  DAX_CONT_EXPORT
+  void SetInvokeSeconds(double seconds) { this->InvokeSeconds = seconds; }
+
+  /// The sum of the times of all phases.
+  ///
+  DAX_CONT_EXPORT
+  double GetPhaseSeconds() const
+  {
+    double seconds = 0;
+    for (std::size_t index = 0; index < this->Phases.size(); index++)
+      {
+      seconds += this->Phases[index].Seconds;
+      }
+    return seconds;
+  }
+
+  /// The sum of the bytes allocated by all phases.
+  ///
+  DAX_CONT_EXPORT
+  std::size_t GetBytesAllocated() const
+  {
+    std::size_t bytes = 0;
+    for (std::size_t index = 0; index < this->Phases.size(); index++)
+      {
+      bytes += this->Phases[index].BytesAllocated;
+      }
+    return bytes;
+  }
+
+  DAX_CONT_EXPORT
+  void SetCallback(CallbackType callback, void *clientData)
+  {
+    this->Callback = callback;
+    this->CallbackClientData = clientData;
+  }
+
+  /// Appends a phase and passes it to the callback.
+  ///
+  DAX_CONT_EXPORT
+  void AddPhase(const Phase &phase)
+  {
+    this->Phases.push_back(phase);
+    if (this->Callback != NULL)
+      {
+      this->Callback(phase, this->CallbackClientData);
+      }
+  }
+
+  /// Forgets the phases. The callback is kept.
+  ///
+  DAX_CONT_EXPORT
+  void Clear()
+  {
+    this->Phases.clear();
+    this->InvokeSeconds = 0;
+  }
+
+  /// Writes a table of the phases to \c stream.
+  ///
+  DAX_CONT_EXPORT
+  void Print(std::ostream &stream) const
+  {
+    for (std::size_t index = 0; index < this->Phases.size(); index++)
+      {
+      const Phase &phase = this->Phases[index];
+      stream << std::setw(28) << std::left << phase.Name << std::right
+             << std::setw(12) << phase.Seconds << " s"
+             << std::setw(12) << phase.NumberOfValues << " values"
+             << std::setw(14) << phase.BytesAllocated << " bytes"
+             << std::endl;
+      }
+    stream << std::setw(28) << std::left << "Invoke" << std::right
+           << std::setw(12) << this->InvokeSeconds << " s" << std::endl;
+  }
+
+private:
+  PhaseListType Phases;
+  double InvokeSeconds;
+  CallbackType Callback;
+  void *CallbackClientData;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_DispatcherProfile_h
@@ -18,14 +18,13 @@
 
 #include <dax/Types.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/cont/ReductionPlan.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletReduceKeysValues.h>
 #include <dax/internal/ParameterPack.h>
 
 #include <dax/cont/dispatcher/AddReduceKeysArgs.h>
 
-#include <dax/exec/internal/kernel/GenerateWorklets.h>
-
 
 namespace dax { namespace cont {
 
@@ -56,21 +55,17 @@ public:
   typedef KeysHandleType_ KeysHandleType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
-  typedef dax::cont::ArrayHandle<dax::Id,
-                                 dax::cont::ArrayContainerControlTagBasic,
-                                 DeviceAdapterTag> ReductionMapType;
+  typedef dax::cont::ReductionPlan<KeysHandleType,DeviceAdapterTag>
+      ReductionPlanType;
+  typedef typename ReductionPlanType::ReductionMapType ReductionMapType;
 
   DAX_CONT_EXPORT
   DispatcherReduceKeysValues(const KeysHandleType &keys):
     Superclass(WorkletType()),
     Keys(keys),
-    ReductionKeys(),
-    ReductionMapValid(false),
     ReleaseKeys(true),
     ReleaseReductionMap(true),
-    ReductionCounts(),
-    ReductionIndices(),
-    ReductionOffsets()
+    Plan()
     { }
 
   DAX_CONT_EXPORT
@@ -78,13 +73,33 @@ public:
                              const WorkletType& work):
     Superclass(work),
     Keys(keys),
-    ReductionKeys(),
-    ReductionMapValid(false),
     ReleaseKeys(true),
     ReleaseReductionMap(true),
-    ReductionCounts(),
-    ReductionIndices(),
-    ReductionOffsets()
+    Plan()
+    { }
+
+  /// Reduces with a plan that is already built, so the keys are not sorted
+  /// again. The plan is kept after Invoke unless SetReleaseReductionMap is
+  /// turned on, so several fields can be reduced with the same dispatcher
+  /// or with other dispatchers sharing the plan.
+  ///
+  DAX_CONT_EXPORT
+  DispatcherReduceKeysValues(const ReductionPlanType &plan):
+    Superclass(WorkletType()),
+    Keys(plan.GetKeys()),
+    ReleaseKeys(true),
+    ReleaseReductionMap(false),
+    Plan(plan)
+    { }
+
+  DAX_CONT_EXPORT
+  DispatcherReduceKeysValues(const ReductionPlanType &plan,
+                             const WorkletType& work):
+    Superclass(work),
+    Keys(plan.GetKeys()),
+    ReleaseKeys(true),
+    ReleaseReductionMap(false),
+    Plan(plan)
     { }
 
   DAX_CONT_EXPORT void SetReleaseKeys(bool flag){ this->ReleaseKeys = flag; }
@@ -99,12 +114,16 @@ public:
   DAX_CONT_EXPORT bool GetReleaseReductionMap() const
     { return ReleaseReductionMap; }
 
+  /// The plan used to group the values. It is built on the first Invoke
+  /// when the dispatcher was given keys, and can then be passed to other
+  /// dispatchers.
+  ///
+  DAX_CONT_EXPORT const ReductionPlanType &GetReductionPlan() const
+    { return this->Plan; }
+
  DAX_CONT_EXPORT
   void DoReleaseReductionMap() {
-    this->ReductionCounts.ReleaseResourcesExecution();
-    this->ReductionOffsets.ReleaseResourcesExecution();
-    this->ReductionIndices.ReleaseResourcesExecution();
-    this->ReductionMapValid = false;
+    this->Plan.ReleaseResources();
   }
 
 
@@ -114,8 +133,6 @@ private:
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
                                 ParameterPackType arguments)
   {
-    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
-
     //Get a map from output indices to input groups.
     this->BuildReductionMap();
     if (this->GetReleaseKeys())
@@ -135,9 +152,9 @@ private:
     //them to the real dispatcher
     DerivedWorkletType derivedWorklet(worklet);
     this->BasicInvoke(derivedWorklet,
-                      arguments.Append(this->ReductionCounts)
-                      .Append(this->ReductionOffsets)
-                      .Append(this->ReductionIndices)
+                      arguments.Append(this->Plan.GetReductionCounts())
+                      .Append(this->Plan.GetReductionOffsets())
+                      .Append(this->Plan.GetReductionIndices())
                       );
 
     if(this->GetReleaseReductionMap())
@@ -148,67 +165,25 @@ private:
 
   /// Builds a map from output indices to input indices that describes how
   /// many values are to be reduced for an entry and at what indices those
-  /// values are.  See GetReductionCounts, GetReductionOffsets, and
-  /// GetReductionIndices.
+  /// values are, unless the plan is already valid. See ReductionPlan.
   DAX_CONT_EXPORT void BuildReductionMap()
   {
-    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
-        Algorithms;
-
-    if (this->ReductionMapValid) { return; } // Nothing to do.
-
-    // Make a copy of the keys.  (Our first step is sort, which is in place.)
-    dax::cont::ArrayHandle<
-        typename KeysHandleType::ValueType,
-        dax::cont::ArrayContainerControlTagBasic,
-        DeviceAdapterTag> sortedKeys;
-    Algorithms::Copy(this->Keys, sortedKeys);
-
-    // Initialize the indices using a counting array. After they are sorted as
-    // values, they will point to the original index. Using a counting array
-    // handle to initialize. You could also use a simple functor and a
-    // schedule, but this is fewer lines and is probably about the same
-    // runtime.
-    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
-        countingArray(0, this->Keys.GetNumberOfValues());
-    Algorithms::Copy(countingArray, this->ReductionIndices);
-
-    Algorithms::SortByKey(sortedKeys, this->ReductionIndices);
-
-    // Unique keys represents the output entries.
-    Algorithms::Copy(sortedKeys, this->ReductionKeys);
-    Algorithms::Unique(this->ReductionKeys);
-
-    // Find the index of each unique key in the sorted list to get the offsets
-    // into the ReductionIndices array.
-    Algorithms::LowerBounds(sortedKeys, this->ReductionKeys, this->ReductionOffsets);
-
-    //Find the number of values corresponding to each unique key.
-    dax::Id numUniqueKeys = this->ReductionKeys.GetNumberOfValues();
-
-    typedef dax::exec::internal::kernel::Offset2CountFunctor<
-                        ReductionMapType> OffsetFunctorType;
-    OffsetFunctorType offset2Count( this->ReductionOffsets.PrepareForInput(),
-                        this->ReductionCounts.PrepareForOutput(numUniqueKeys),
-                        numUniqueKeys-1,
-                        this->ReductionIndices.GetNumberOfValues());
-    Algorithms::Schedule(offset2Count, numUniqueKeys);
-
-    this->ReductionMapValid = true;
+    if (this->Plan.IsValid()) { return; } // Nothing to do.
+
+    dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+        phase(this->GetActiveProfile(), "BuildReductionMap",
+              this->Keys.GetNumberOfValues());
+    this->Plan.Build(this->Keys);
   }
 
 
 
   KeysHandleType Keys;
-  KeysHandleType ReductionKeys;
 
-  bool ReductionMapValid;
   bool ReleaseKeys;
   bool ReleaseReductionMap;
 
-  ReductionMapType ReductionCounts;
-  ReductionMapType ReductionIndices;
-  ReductionMapType ReductionOffsets;
+  ReductionPlanType Plan;
 
 };
 
@@ -0,0 +1,292 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_MemoryTracker_h
+#define __dax_cont_MemoryTracker_h
+
+#include <dax/Types.h>
+#include <dax/cont/internal/SpinLock.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dax {
+namespace cont {
+
+/// \brief Keeps account of the memory Dax allocates for arrays.
+///
+/// The tracker is global and off by default. Once turned on with \c Enable,
+/// every array allocation made by the basic control container, by the
+/// execution array managers, and by the temporary arrays of the device
+/// adapter algorithms is recorded. The tracker reports the number of bytes
+/// currently allocated, the largest number of bytes that were allocated at
+/// any one time (the high water mark), and the number and total bytes of the
+/// allocations made.
+///
+/// Allocations are also accounted for by call site. Code can declare a \c
+/// MemoryTrackerScope to name the operation it performs. Every allocation is
+/// charged to the names of all the scopes active when it is made, joined by
+/// a '/' (for example "DispatcherGenerateInterpolatedCells::
+/// ResolveCoordinates/DeviceAdapterAlgorithm::Sort").
+///
+/// The tracker can be called from several host threads at once, for example
+/// by the TBB and OpenMP device adapters or by dispatchers run from different
+/// threads, so all of its state is guarded by a lock. The statistics are
+/// returned as copies taken under that lock. Allocations and frees first
+/// check volatile flags without the lock, so while the tracker is off and
+/// holds no allocations they never wait on it. Scope names form one stack for
+/// the whole process, so allocations are only charged to the right call site
+/// when the scopes are declared from a single thread.
+///
+class MemoryTracker
+{
+public:
+  /// The numbers kept for all allocations and for each call site.
+  ///
+  struct Statistics
+  {
+    Statistics()
+      : CurrentBytes(0), PeakBytes(0), NumberOfAllocations(0),
+        AllocatedBytes(0) {  }
+
+    /// Bytes allocated and not yet freed.
+    std::size_t CurrentBytes;
+    /// The largest value CurrentBytes has had.
+    std::size_t PeakBytes;
+    /// The number of allocations made.
+    std::size_t NumberOfAllocations;
+    /// Bytes of all the allocations made, whether freed or not.
+    std::size_t AllocatedBytes;
+  };
+
+  typedef std::map<std::string, Statistics> TagStatisticsType;
+
+  /// Starts recording allocations.
+  ///
+  DAX_CONT_EXPORT static void Enable() { SetEnabled(true); }
+
+  /// Stops recording allocations. Allocations already recorded are still
+  /// removed from the current byte counts when they are freed.
+  ///
+  DAX_CONT_EXPORT static void Disable() { SetEnabled(false); }
+
+  DAX_CONT_EXPORT static bool IsEnabled()
+  {
+    return GetState().Enabled;
+  }
+
+  /// Forgets all recorded allocations and zeroes all statistics.
+  ///
+  DAX_CONT_EXPORT static void Reset()
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    state.Total = Statistics();
+    state.Tags.clear();
+    state.Allocations.clear();
+    state.HasAllocations = false;
+  }
+
+  /// Sets the peak of the total and of every call site to its current value
+  /// and zeroes the allocation counts and bytes, so that the statistics describe only
+  /// what happens after this call. Live allocations are still tracked.
+  ///
+  DAX_CONT_EXPORT static void ResetPeak()
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    ResetPeak(state.Total);
+    for (TagStatisticsType::iterator tag = state.Tags.begin();
+         tag != state.Tags.end();
+         tag++)
+      {
+      ResetPeak(tag->second);
+      }
+  }
+
+  /// Statistics for all tracked allocations.
+  ///
+  DAX_CONT_EXPORT static Statistics GetStatistics()
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    return state.Total;
+  }
+
+  /// Statistics for each call site. Allocations made outside of any \c
+  /// MemoryTrackerScope are listed under an empty name.
+  ///
+  DAX_CONT_EXPORT static TagStatisticsType GetTagStatistics()
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    return state.Tags;
+  }
+
+  /// Records that \c bytes were allocated at \c pointer. Called by the array
+  /// containers and managers; there is no reason to call this otherwise.
+  ///
+  DAX_CONT_EXPORT static void RecordAllocation(const void *pointer,
+                                               std::size_t bytes)
+  {
+    State &state = GetState();
+    if (pointer == NULL || !state.Enabled) { return; }
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    if (!state.Enabled) { return; }
+
+    const std::string &tag = state.TagPath.empty() ? std::string()
+                                                   : state.TagPath.back();
+    AddBytes(state.Total, bytes);
+    AddBytes(state.Tags[tag], bytes);
+    state.Allocations[pointer] = Allocation(bytes, tag);
+    state.HasAllocations = true;
+  }
+
+  /// Records that the allocation at \c pointer was freed.
+  ///
+  DAX_CONT_EXPORT static void RecordDeallocation(const void *pointer)
+  {
+    State &state = GetState();
+    if (!state.HasAllocations) { return; }
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+
+    AllocationMapType::iterator allocation =
+        state.Allocations.find(pointer);
+    if (allocation == state.Allocations.end()) { return; }
+
+    const std::size_t bytes = allocation->second.Bytes;
+    state.Total.CurrentBytes -= bytes;
+    state.Tags[allocation->second.Tag].CurrentBytes -= bytes;
+    state.Allocations.erase(allocation);
+    state.HasAllocations = !state.Allocations.empty();
+  }
+
+  /// Pushes a call site name. Use \c MemoryTrackerScope instead.
+  ///
+  DAX_CONT_EXPORT static void PushTag(const std::string &tag)
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    if (state.TagPath.empty())
+      {
+      state.TagPath.push_back(tag);
+      }
+    else
+      {
+      state.TagPath.push_back(state.TagPath.back() + "/" + tag);
+      }
+  }
+
+  /// Pops the last pushed call site name.
+  ///
+  DAX_CONT_EXPORT static void PopTag()
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    if (!state.TagPath.empty()) { state.TagPath.pop_back(); }
+  }
+
+private:
+  struct Allocation
+  {
+    Allocation() : Bytes(0) {  }
+    Allocation(std::size_t bytes, const std::string &tag)
+      : Bytes(bytes), Tag(tag) {  }
+    std::size_t Bytes;
+    std::string Tag;
+  };
+  typedef std::map<const void *, Allocation> AllocationMapType;
+
+  struct State
+  {
+    State() : Enabled(false), HasAllocations(false) {  }
+    // Written under the lock, read without it by the fast paths.
+    volatile bool Enabled;
+    volatile bool HasAllocations;
+    Statistics Total;
+    TagStatisticsType Tags;
+    AllocationMapType Allocations;
+    std::vector<std::string> TagPath;
+    dax::cont::internal::SpinLock Lock;
+  };
+
+  // The state lives in a function static so that this header-only class has
+  // a single instance across translation units.
+  DAX_CONT_EXPORT static State &GetState()
+  {
+    static State state;
+    return state;
+  }
+
+  DAX_CONT_EXPORT static void SetEnabled(bool enabled)
+  {
+    State &state = GetState();
+    dax::cont::internal::SpinLockScope lock(state.Lock);
+    state.Enabled = enabled;
+  }
+
+  DAX_CONT_EXPORT static void AddBytes(Statistics &statistics,
+                                       std::size_t bytes)
+  {
+    statistics.CurrentBytes += bytes;
+    statistics.NumberOfAllocations++;
+    statistics.AllocatedBytes += bytes;
+    if (statistics.CurrentBytes > statistics.PeakBytes)
+      {
+      statistics.PeakBytes = statistics.CurrentBytes;
+      }
+  }
+
+  DAX_CONT_EXPORT static void ResetPeak(Statistics &statistics)
+  {
+    statistics.PeakBytes = statistics.CurrentBytes;
+    statistics.NumberOfAllocations = 0;
+    statistics.AllocatedBytes = 0;
+  }
+};
+
+/// \brief Names the call site of the allocations made during its lifetime.
+///
+/// Declare one of these at the start of an operation to have the \c
+/// MemoryTracker charge the allocations made in the operation to the given
+/// name. Scopes nest. When the tracker is disabled a scope does nothing.
+///
+class MemoryTrackerScope
+{
+public:
+  DAX_CONT_EXPORT explicit MemoryTrackerScope(const char *tag)
+    : Pushed(dax::cont::MemoryTracker::IsEnabled())
+  {
+    if (this->Pushed) { dax::cont::MemoryTracker::PushTag(tag); }
+  }
+
+  DAX_CONT_EXPORT ~MemoryTrackerScope()
+  {
+    if (this->Pushed) { dax::cont::MemoryTracker::PopTag(); }
+  }
+
+private:
+  MemoryTrackerScope(const MemoryTrackerScope &);  // Not implemented.
+  void operator=(const MemoryTrackerScope &);  // Not implemented.
+
+  bool Pushed;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_MemoryTracker_h
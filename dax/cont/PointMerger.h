@@ -0,0 +1,239 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_PointMerger_h
+#define __dax_cont_PointMerger_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/internal/ComputeBounds.h>
+
+#include <dax/exec/internal/kernel/PointMergerWorklets.h>
+
+#include <cmath>
+#include <limits>
+
+namespace dax {
+namespace cont {
+
+/// \brief Merges geometrically coincident points of an unstructured grid.
+///
+/// The duplicate point removal of the generate dispatchers only merges points
+/// that are topologically the same (the same input point or the same
+/// interpolated edge). PointMerger instead merges points that are close in
+/// space, such as the shared boundary points of contours extracted from
+/// several blocks.
+///
+/// Every point is quantized to a lattice with cells of size tolerance, and
+/// the lattice coordinates are used as a collision free spatial hash key.
+/// The lattice is counted from the cell that holds the lower corner of the
+/// bounds of the points, so only the extent of the points, not their
+/// distance from the origin, has to fit in a dax::Id: Merge throws
+/// dax::cont::ErrorControlBadValue when the bounds span more lattice cells
+/// along an axis than a dax::Id can count (about 2.1e9 with 32-bit ids, or
+/// 21474 units at the default tolerance).
+/// The keys are sorted, made unique and the original keys are located with
+/// LowerBounds to build the map from old to new point ids, which is then used
+/// to rewrite the cell connections. Points that fall in the same lattice cell
+/// are merged and the coordinates of one of them is kept. Note that two points
+/// closer than tolerance may still straddle a lattice cell boundary and stay
+/// separate.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class PointMerger
+{
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayType;
+
+  DAX_CONT_EXPORT
+  PointMerger(dax::Scalar tolerance = 0.00001) : Tolerance(tolerance) {  }
+
+  /// The size of the lattice cells that points are snapped to. Must be
+  /// positive.
+  ///
+  DAX_CONT_EXPORT
+  dax::Scalar GetTolerance() const { return this->Tolerance; }
+  DAX_CONT_EXPORT
+  void SetTolerance(dax::Scalar tolerance) { this->Tolerance = tolerance; }
+
+  /// Merges the points of \c grid in place. The point coordinates and cell
+  /// connections of the grid are replaced with new arrays, so copies of the
+  /// grid made before the call are unaffected.
+  ///
+  template<class GridType>
+  DAX_CONT_EXPORT
+  void Merge(GridType &grid)
+  {
+    dax::cont::MemoryTrackerScope memoryScope("PointMerger::Merge");
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id3,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> KeyArrayType;
+
+    if (this->Tolerance <= 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "PointMerger tolerance must be positive.");
+      }
+
+    const dax::Id numberOfPoints = grid.GetNumberOfPoints();
+    const dax::Vector3 origin = this->ComputeLatticeOrigin(grid);
+
+    KeyArrayType keys;
+    dax::cont::DispatcherMapField<
+        dax::exec::internal::kernel::QuantizePointFunctor>(
+          dax::exec::internal::kernel::QuantizePointFunctor(this->Tolerance,
+                                                            origin))
+        .Invoke(grid.GetPointCoordinates(), keys);
+
+    // Sort the keys along with the point ids so that the first point of
+    // every run of equal keys can represent the merged point.
+    KeyArrayType sortedKeys;
+    IdArrayType sortedPointIds;
+    Algorithm::Copy(keys, sortedKeys);
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                        numberOfPoints),
+                    sortedPointIds);
+    Algorithm::SortByKey(sortedKeys, sortedPointIds);
+
+    KeyArrayType uniqueKeys;
+    Algorithm::Copy(sortedKeys, uniqueKeys);
+    Algorithm::Unique(uniqueKeys);
+
+    IdArrayType firstSortedIndex;
+    Algorithm::LowerBounds(sortedKeys, uniqueKeys, firstSortedIndex);
+    sortedKeys.ReleaseResources();
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(firstSortedIndex,
+                                                           sortedPointIds),
+                    this->MergedPointIds);
+    firstSortedIndex.ReleaseResources();
+    sortedPointIds.ReleaseResources();
+
+    Algorithm::LowerBounds(uniqueKeys, keys, this->PointMap);
+    keys.ReleaseResources();
+    uniqueKeys.ReleaseResources();
+
+    typename GridType::PointCoordinatesType mergedCoordinates;
+    this->CompactPointField(grid.GetPointCoordinates(), mergedCoordinates);
+
+    typename GridType::CellConnectionsType mergedConnections;
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(
+                      grid.GetCellConnections(), this->PointMap),
+                    mergedConnections);
+
+    grid.SetPointCoordinates(mergedCoordinates);
+    grid.SetCellConnections(mergedConnections);
+  }
+
+  /// Map from the point ids before the last Merge to the merged point ids.
+  ///
+  DAX_CONT_EXPORT
+  const IdArrayType &GetPointMap() const { return this->PointMap; }
+
+  /// For every merged point, the id of the point it was copied from before
+  /// the last Merge.
+  ///
+  DAX_CONT_EXPORT
+  const IdArrayType &GetMergedPointIds() const { return this->MergedPointIds; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfMergedPoints() const
+  {
+    return this->MergedPointIds.GetNumberOfValues();
+  }
+
+  /// Reduces a point field of the grid given to the last Merge to the merged
+  /// points.
+  ///
+  template<typename T, class ContainerIn, class ContainerOut>
+  DAX_CONT_EXPORT
+  void CompactPointField(
+      const dax::cont::ArrayHandle<T,ContainerIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,ContainerOut,DeviceAdapterTag> &output) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(
+                      this->MergedPointIds, input),
+                    output);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->PointMap.ReleaseResources();
+    this->MergedPointIds.ReleaseResources();
+  }
+
+private:
+  // The corner of the lattice cell that holds the lower corner of the bounds
+  // of the points. Throws when the lattice coordinates of the upper corner
+  // of the bounds do not fit in a dax::Id.
+  template<class GridType>
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputeLatticeOrigin(const GridType &grid) const
+  {
+    if (grid.GetNumberOfPoints() == 0)
+      {
+      return dax::make_Vector3(0, 0, 0);
+      }
+
+    dax::Vector3 minBounds;
+    dax::Vector3 maxBounds;
+    dax::cont::internal::ComputeBounds(grid.GetPointCoordinates(),
+                                       minBounds,
+                                       maxBounds);
+
+    const dax::Scalar inverseTolerance = 1/this->Tolerance;
+    dax::Vector3 origin;
+    for (int axis = 0; axis < 3; axis++)
+      {
+      origin[axis] = static_cast<dax::Scalar>(
+            std::floor(static_cast<double>(minBounds[axis]) /
+                       static_cast<double>(this->Tolerance)) *
+            static_cast<double>(this->Tolerance));
+      // The same arithmetic as QuantizePointFunctor, so the check holds
+      // for the key of the upper corner.
+      const dax::Scalar extent =
+          (maxBounds[axis] - origin[axis]) * inverseTolerance;
+      if (!(static_cast<double>(extent) <
+            static_cast<double>(std::numeric_limits<dax::Id>::max())))
+        {
+        throw dax::cont::ErrorControlBadValue(
+              "PointMerger tolerance is too small for the bounds of the "
+              "points; the lattice coordinates do not fit in a dax::Id.");
+        }
+      }
+    return origin;
+  }
+
+  dax::Scalar Tolerance;
+  IdArrayType PointMap;
+  IdArrayType MergedPointIds;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_PointMerger_h
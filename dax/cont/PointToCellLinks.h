@@ -0,0 +1,172 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_PointToCellLinks_h
+#define __dax_cont_PointToCellLinks_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/MemoryTracker.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax {
+namespace cont {
+
+namespace detail {
+
+/// Converts, in place, indices into a cell connections array to the index of
+/// the cell holding that connection.
+///
+template<class PortalType>
+struct ConnectionIndexToCellIndex : public dax::exec::internal::WorkletBase
+{
+  PortalType Portal;
+  dax::Id NumberOfVertices;
+
+  DAX_CONT_EXPORT
+  ConnectionIndexToCellIndex(const PortalType &portal,
+                             dax::Id numberOfVertices)
+    : Portal(portal), NumberOfVertices(numberOfVertices) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    this->Portal.Set(index, this->Portal.Get(index) / this->NumberOfVertices);
+  }
+};
+
+} // namespace detail
+
+/// \brief Reverse (point to cell) connectivity of an unstructured grid.
+///
+/// PointToCellLinks holds, for every point, the list of cells that use that
+/// point in compressed sparse row form. The cells incident to point \c i are
+/// the \c GetCounts()[i] entries of \c GetCellIds() starting at
+/// \c GetOffsets()[i]. The links are built once with the device adapter
+/// algorithms and can then be reused by any number of point worklets (see
+/// dax::cont::DispatcherMapPoint).
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class PointToCellLinks
+{
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> LinksArrayType;
+
+  DAX_CONT_EXPORT
+  PointToCellLinks() : Valid(false) {  }
+
+  /// Builds the links from the connections array of a grid where every cell
+  /// has \c numberOfVertices points. Any previous links are replaced.
+  ///
+  template<class ConnectionsHandleType>
+  DAX_CONT_EXPORT
+  void Build(const ConnectionsHandleType &cellConnections,
+             dax::Id numberOfVertices,
+             dax::Id numberOfPoints)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithms;
+
+    dax::cont::MemoryTrackerScope memoryScope("PointToCellLinks::Build");
+
+    const dax::Id numberOfConnections = cellConnections.GetNumberOfValues();
+
+    // Sort the connection indices by the point they refer to. Dividing the
+    // connection index by the number of vertices then gives the cell.
+    LinksArrayType sortedPoints;
+    Algorithms::Copy(cellConnections, sortedPoints);
+
+    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
+        connectionIndices(0, numberOfConnections);
+    Algorithms::Copy(connectionIndices, this->CellIds);
+
+    Algorithms::SortByKey(sortedPoints, this->CellIds);
+
+    detail::ConnectionIndexToCellIndex<
+        typename LinksArrayType::PortalExecution> toCellIndex(
+          this->CellIds.PrepareForInPlace(), numberOfVertices);
+    Algorithms::Schedule(toCellIndex, numberOfConnections);
+
+    // The first occurrence of each point in the sorted list is its offset.
+    // Points not used by any cell get the offset of the next used point and a
+    // count of zero.
+    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
+        pointIndices(0, numberOfPoints);
+    Algorithms::LowerBounds(sortedPoints, pointIndices, this->Offsets);
+
+    typedef dax::exec::internal::kernel::Offset2CountFunctor<
+        LinksArrayType> OffsetFunctorType;
+    OffsetFunctorType offset2Count(
+          this->Offsets.PrepareForInput(),
+          this->Counts.PrepareForOutput(numberOfPoints),
+          numberOfPoints-1,
+          numberOfConnections);
+    Algorithms::Schedule(offset2Count, numberOfPoints);
+
+    this->Valid = true;
+  }
+
+  /// Returns true if Build has been called since the links were created or
+  /// last released.
+  ///
+  DAX_CONT_EXPORT
+  bool IsValid() const { return this->Valid; }
+
+  /// Releases all the arrays held by the links.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->Counts.ReleaseResources();
+    this->Offsets.ReleaseResources();
+    this->CellIds.ReleaseResources();
+    this->Valid = false;
+  }
+
+  /// The number of cells incident to each point.
+  ///
+  DAX_CONT_EXPORT
+  const LinksArrayType &GetCounts() const { return this->Counts; }
+
+  /// The index in the CellIds array of the first cell of each point.
+  ///
+  DAX_CONT_EXPORT
+  const LinksArrayType &GetOffsets() const { return this->Offsets; }
+
+  /// The incident cells of all points, grouped by point.
+  ///
+  DAX_CONT_EXPORT
+  const LinksArrayType &GetCellIds() const { return this->CellIds; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const { return this->Counts.GetNumberOfValues(); }
+
+private:
+  LinksArrayType Counts;
+  LinksArrayType Offsets;
+  LinksArrayType CellIds;
+  bool Valid;
+};
+
+}
+}
+
+#endif //__dax_cont_PointToCellLinks_h
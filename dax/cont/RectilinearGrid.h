@@ -0,0 +1,210 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__RectilinearGrid_h
+#define __dax__cont__RectilinearGrid_h
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/internal/ArrayContainerControlCartesianProduct.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/internal/TopologyRectilinear.h>
+
+namespace dax {
+namespace cont {
+
+/// This class defines the topology of a rectilinear grid. A rectilinear grid
+/// is axis aligned like a uniform grid, but the distance between grid points
+/// can vary along each axis. The point positions are the cartesian product of
+/// three 1-D coordinate arrays, one per axis, so the grid only stores
+/// nx+ny+nz values and the connectivity is implicit. Because the cells are
+/// laid out exactly like those of a uniform grid, worklets are scheduled over
+/// the i, j, k cell indices.
+///
+template <
+    class CoordinatesContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class RectilinearGrid
+{
+public:
+  typedef dax::CellTagVoxel CellTag;
+  typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Scalar, CoordinatesContainerControlTag, DeviceAdapterTag>
+      AxisCoordinatesType;
+
+  DAX_CONT_EXPORT
+  RectilinearGrid() {  }
+
+  DAX_CONT_EXPORT
+  RectilinearGrid(AxisCoordinatesType xCoordinates,
+                  AxisCoordinatesType yCoordinates,
+                  AxisCoordinatesType zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates)
+  {  }
+
+  /// The axis coordinate arrays give the position of the grid points along
+  /// each axis. They should be monotonically increasing. The number of values
+  /// in each defines the number of points in that dimension.
+  ///
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetXCoordinates() const {
+    return this->XCoordinates;
+  }
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetYCoordinates() const {
+    return this->YCoordinates;
+  }
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetZCoordinates() const {
+    return this->ZCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetCoordinates(AxisCoordinatesType xCoordinates,
+                      AxisCoordinatesType yCoordinates,
+                      AxisCoordinatesType zCoordinates) {
+    this->XCoordinates = xCoordinates;
+    this->YCoordinates = yCoordinates;
+    this->ZCoordinates = zCoordinates;
+  }
+
+  /// The extent of a rectilinear grid always starts at (0, 0, 0) and its
+  /// size is given by the length of the coordinate arrays.
+  ///
+  DAX_CONT_EXPORT
+  dax::Extent3 GetExtent() const {
+    return dax::Extent3(dax::make_Id3(0, 0, 0),
+                        dax::make_Id3(this->XCoordinates.GetNumberOfValues()-1,
+                                      this->YCoordinates.GetNumberOfValues()-1,
+                                      this->ZCoordinates.GetNumberOfValues()-1));
+  }
+
+  // Helper functions
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    dax::Id3 dims = dax::extentDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    dax::Id3 dims = dax::extentCellDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Converts an i, j, k point location to a point index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputePointIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndex(ijk, this->GetExtent());
+  }
+
+  /// Converts an i, j, k cell location to a cell index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputeCellIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndexCell(ijk, this->GetExtent());
+  }
+
+  /// Converts a flat point index to an i, j, k point location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputePointLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3(index, this->GetExtent());
+  }
+
+  /// Converts a flat cell index to an i, j, k cell location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputeCellLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3Cell(index, this->GetExtent());
+  }
+
+  /// Given a point i, j, k location, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id3 location) const {
+    return dax::make_Vector3(
+          this->XCoordinates.GetPortalConstControl().Get(location[0]),
+          this->YCoordinates.GetPortalConstControl().Get(location[1]),
+          this->ZCoordinates.GetPortalConstControl().Get(location[2]));
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->ComputePointCoordinates(this->ComputePointLocation(index));
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,
+      dax::cont::internal::ArrayContainerControlTagCartesianProduct<
+          AxisCoordinatesType>,
+      DeviceAdapterTag> PointCoordinatesType;
+
+  /// Returns an implicit array of the point coordinates. Only the three axis
+  /// arrays are transferred when it is used in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    typedef typename PointCoordinatesType::PortalConstControl PortalType;
+    return PointCoordinatesType(PortalType(this->XCoordinates,
+                                           this->YCoordinates,
+                                           this->ZCoordinates));
+  }
+
+  typedef dax::exec::internal::TopologyRectilinear<
+      typename AxisCoordinatesType::PortalConstExecution>
+      TopologyStructConstExecution;
+  typedef TopologyStructConstExecution TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Extent = this->GetExtent();
+    topology.XCoordinates = this->XCoordinates.PrepareForInput();
+    topology.YCoordinates = this->YCoordinates.PrepareForInput();
+    topology.ZCoordinates = this->ZCoordinates.PrepareForInput();
+    return topology;
+  }
+
+private:
+  AxisCoordinatesType XCoordinates;
+  AxisCoordinatesType YCoordinates;
+  AxisCoordinatesType ZCoordinates;
+};
+
+}
+}
+
+#endif //__dax__cont__RectilinearGrid_h
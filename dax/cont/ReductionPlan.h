@@ -0,0 +1,200 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ReductionPlan_h
+#define __dax_cont_ReductionPlan_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/MemoryTracker.h>
+
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax { namespace cont {
+
+/// \brief Describes how to group values by key for a reduction.
+///
+/// A ReductionPlan sorts a set of keys once and records, for every unique
+/// key, how many values share it (the counts), where its group starts
+/// (the offsets) and which input values belong to it (the indices). This
+/// is the map DispatcherReduceKeysValues needs to run a worklet over each
+/// group of values.
+///
+/// Building the plan sorts the keys, which is by far the most expensive
+/// part of a reduction. Build it once and pass it to any number of
+/// DispatcherReduceKeysValues to reduce several fields that share the
+/// same keys, such as every cell field averaged to the points of a grid.
+/// A plan can also be kept across time steps as long as the keys, and so
+/// the topology they come from, do not change.
+///
+/// Copies of a plan share their arrays.
+///
+template<class KeysHandleType_ = dax::cont::ArrayHandle< dax::Id >,
+         class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ReductionPlan
+{
+public:
+  typedef KeysHandleType_ KeysHandleType;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> ReductionMapType;
+
+  DAX_CONT_EXPORT
+  ReductionPlan() : Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  explicit ReductionPlan(const KeysHandleType &keys) : Valid(false)
+  {
+    this->Build(keys);
+  }
+
+  /// Sorts \c keys and builds the counts, offsets and indices of every
+  /// group of values sharing a key. Replaces any previous plan. The plan
+  /// keeps a reference to \c keys.
+  ///
+  DAX_CONT_EXPORT
+  void Build(const KeysHandleType &keys)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithms;
+
+    dax::cont::MemoryTrackerScope memoryScope("ReductionPlan::Build");
+
+    this->Keys = keys;
+
+    // Make a copy of the keys.  (Our first step is sort, which is in place.)
+    dax::cont::ArrayHandle<
+        typename KeysHandleType::ValueType,
+        dax::cont::ArrayContainerControlTagBasic,
+        DeviceAdapterTag> sortedKeys;
+    Algorithms::Copy(keys, sortedKeys);
+
+    // Initialize the indices using a counting array. After they are sorted as
+    // values, they will point to the original index.
+    dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapterTag>
+        countingArray(0, keys.GetNumberOfValues());
+    Algorithms::Copy(countingArray, this->ReductionIndices);
+
+    Algorithms::SortByKey(sortedKeys, this->ReductionIndices);
+
+    // Unique keys represents the output entries.
+    Algorithms::Copy(sortedKeys, this->ReductionKeys);
+    Algorithms::Unique(this->ReductionKeys);
+
+    // Find the index of each unique key in the sorted list to get the offsets
+    // into the ReductionIndices array.
+    Algorithms::LowerBounds(sortedKeys,
+                            this->ReductionKeys,
+                            this->ReductionOffsets);
+
+    //Find the number of values corresponding to each unique key.
+    dax::Id numUniqueKeys = this->ReductionKeys.GetNumberOfValues();
+
+    typedef dax::exec::internal::kernel::Offset2CountFunctor<
+                        ReductionMapType> OffsetFunctorType;
+    OffsetFunctorType offset2Count(
+          this->ReductionOffsets.PrepareForInput(),
+          this->ReductionCounts.PrepareForOutput(numUniqueKeys),
+          numUniqueKeys-1,
+          this->ReductionIndices.GetNumberOfValues());
+    Algorithms::Schedule(offset2Count, numUniqueKeys);
+
+    this->Valid = true;
+  }
+
+  /// True once the plan has been built and not released since.
+  ///
+  DAX_CONT_EXPORT
+  bool IsValid() const { return this->Valid; }
+
+  /// The keys the plan was built from.
+  ///
+  DAX_CONT_EXPORT
+  KeysHandleType GetKeys() const { return this->Keys; }
+
+  /// The number of values reduced, which is the number of keys the plan was
+  /// built from.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const
+  {
+    return this->ReductionIndices.GetNumberOfValues();
+  }
+
+  /// The number of groups of values, which is the number of unique keys and
+  /// the size of the output of a reduction.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfReductions() const
+  {
+    return this->ReductionCounts.GetNumberOfValues();
+  }
+
+  /// The unique keys, sorted. Entry i is the key of group i.
+  ///
+  DAX_CONT_EXPORT
+  KeysHandleType GetReductionKeys() const { return this->ReductionKeys; }
+
+  /// The number of values in each group.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMapType GetReductionCounts() const
+  {
+    return this->ReductionCounts;
+  }
+
+  /// The index in GetReductionIndices of the first value of each group.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMapType GetReductionOffsets() const
+  {
+    return this->ReductionOffsets;
+  }
+
+  /// The indices of the input values, ordered by group.
+  ///
+  DAX_CONT_EXPORT
+  ReductionMapType GetReductionIndices() const
+  {
+    return this->ReductionIndices;
+  }
+
+  /// Drops the arrays of the plan and marks it as not valid. Copies of the
+  /// plan, including those held by dispatchers, keep working; the memory is
+  /// freed once the last of them is released or destroyed.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    *this = ReductionPlan();
+  }
+
+private:
+  KeysHandleType Keys;
+  KeysHandleType ReductionKeys;
+  bool Valid;
+
+  ReductionMapType ReductionCounts;
+  ReductionMapType ReductionOffsets;
+  ReductionMapType ReductionIndices;
+};
+
+} } // namespace dax::cont
+
+#endif //__dax_cont_ReductionPlan_h
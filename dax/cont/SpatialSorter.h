@@ -0,0 +1,207 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_SpatialSorter_h
+#define __dax_cont_SpatialSorter_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/internal/ComputeBounds.h>
+
+#include <dax/exec/internal/kernel/SpatialSorterWorklets.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Reorders the points and cells of an unstructured grid along a
+/// Morton curve.
+///
+/// Grids produced by contouring or read from disk often number their points
+/// in an order unrelated to their position, so gathering the vertices of a
+/// cell touches memory all over the point arrays. SpatialSorter renumbers the
+/// points by the Morton (Z-order) code of their coordinates and the cells by
+/// the Morton code of their centroids, so that cells close in space use
+/// points close in memory.
+///
+/// Sort keeps the permutations it applied so that the point and cell fields
+/// of the grid can be reordered to match with ReorderPointField and
+/// ReorderCellField.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class SpatialSorter
+{
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayType;
+
+  /// Sorts the points and cells of \c grid in place. The point coordinates
+  /// and cell connections of the grid are replaced with new arrays, so
+  /// copies of the grid made before the call are unaffected.
+  ///
+  template<class GridType>
+  DAX_CONT_EXPORT
+  void Sort(GridType &grid)
+  {
+    dax::cont::MemoryTrackerScope memoryScope("SpatialSorter::Sort");
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef typename GridType::CellTag CellTag;
+    typedef typename GridType::CellConnectionsType CellConnectionsType;
+
+    const dax::Id numberOfPoints = grid.GetNumberOfPoints();
+    const dax::Id numberOfCells = grid.GetNumberOfCells();
+    if (numberOfPoints == 0)
+      {
+      this->PointPermutation.ReleaseResources();
+      this->CellPermutation.ReleaseResources();
+      return;
+      }
+
+    dax::Vector3 minBounds;
+    dax::Vector3 maxBounds;
+    dax::cont::internal::ComputeBounds(grid.GetPointCoordinates(),
+                                       minBounds,
+                                       maxBounds);
+    const dax::exec::internal::kernel::MortonCodeOfCoordinates
+        mortonCode(minBounds, maxBounds);
+
+    // Sort the points and renumber the cell connections to match.
+    IdArrayType codes;
+    dax::cont::DispatcherMapField<
+        dax::exec::internal::kernel::PointMortonCodeFunctor>(
+          dax::exec::internal::kernel::PointMortonCodeFunctor(mortonCode))
+        .Invoke(grid.GetPointCoordinates(), codes);
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                        numberOfPoints),
+                    this->PointPermutation);
+    Algorithm::SortByKey(codes, this->PointPermutation);
+
+    IdArrayType newPointIds;
+    dax::exec::internal::kernel::InversePermutationFunctor<
+        typename IdArrayType::PortalConstExecution,
+        typename IdArrayType::PortalExecution>
+        inverseFunctor(this->PointPermutation.PrepareForInput(),
+                       newPointIds.PrepareForOutput(numberOfPoints));
+    Algorithm::Schedule(inverseFunctor, numberOfPoints);
+
+    typename GridType::PointCoordinatesType sortedCoordinates;
+    this->ReorderPointField(grid.GetPointCoordinates(), sortedCoordinates);
+
+    CellConnectionsType renumberedConnections;
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(
+                      grid.GetCellConnections(), newPointIds),
+                    renumberedConnections);
+    newPointIds.ReleaseResources();
+
+    grid.SetPointCoordinates(sortedCoordinates);
+    grid.SetCellConnections(renumberedConnections);
+
+    // Sort the cells by their centroids, which now read sorted points.
+    dax::cont::DispatcherMapCell<
+        dax::exec::internal::kernel::CellMortonCodeFunctor>(
+          dax::exec::internal::kernel::CellMortonCodeFunctor(mortonCode))
+        .Invoke(grid, grid.GetPointCoordinates(), codes);
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                        numberOfCells),
+                    this->CellPermutation);
+    Algorithm::SortByKey(codes, this->CellPermutation);
+    codes.ReleaseResources();
+
+    CellConnectionsType sortedConnections;
+    dax::exec::internal::kernel::PermuteCellConnectionsFunctor<
+        CellTag,
+        typename IdArrayType::PortalConstExecution,
+        typename CellConnectionsType::PortalConstExecution,
+        typename CellConnectionsType::PortalExecution>
+        permuteFunctor(this->CellPermutation.PrepareForInput(),
+                       renumberedConnections.PrepareForInput(),
+                       sortedConnections.PrepareForOutput(
+                         renumberedConnections.GetNumberOfValues()));
+    Algorithm::Schedule(permuteFunctor, numberOfCells);
+
+    grid.SetCellConnections(sortedConnections);
+  }
+
+  /// For every point after the last Sort, the index of the point before it.
+  ///
+  DAX_CONT_EXPORT
+  const IdArrayType &GetPointPermutation() const
+  {
+    return this->PointPermutation;
+  }
+
+  /// For every cell after the last Sort, the index of the cell before it.
+  ///
+  DAX_CONT_EXPORT
+  const IdArrayType &GetCellPermutation() const
+  {
+    return this->CellPermutation;
+  }
+
+  /// Reorders a point field of the grid given to the last Sort to match its
+  /// new point order.
+  ///
+  template<typename T, class ContainerIn, class ContainerOut>
+  DAX_CONT_EXPORT
+  void ReorderPointField(
+      const dax::cont::ArrayHandle<T,ContainerIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,ContainerOut,DeviceAdapterTag> &output) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(
+                      this->PointPermutation, input),
+                    output);
+  }
+
+  /// Reorders a cell field of the grid given to the last Sort to match its
+  /// new cell order.
+  ///
+  template<typename T, class ContainerIn, class ContainerOut>
+  DAX_CONT_EXPORT
+  void ReorderCellField(
+      const dax::cont::ArrayHandle<T,ContainerIn,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,ContainerOut,DeviceAdapterTag> &output) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    Algorithm::Copy(dax::cont::make_ArrayHandlePermutation(
+                      this->CellPermutation, input),
+                    output);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    this->PointPermutation.ReleaseResources();
+    this->CellPermutation.ReleaseResources();
+  }
+
+private:
+  IdArrayType PointPermutation;
+  IdArrayType CellPermutation;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_SpatialSorter_h
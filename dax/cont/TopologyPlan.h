@@ -0,0 +1,416 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_TopologyPlan_h
+#define __dax_cont_TopologyPlan_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/dispatcher/AddVisitIndexArg.h>
+#include <dax/cont/dispatcher/GenerateFanout.h>
+#include <dax/cont/internal/EdgeInterpolatedGrid.h>
+
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax { namespace cont {
+
+namespace detail {
+
+/// Interpolates all the fields in \c inputs to \c outputs with the edge
+/// interpolation weights in a single schedule.
+///
+template<typename WeightsHandleType,
+         typename T,
+         typename Container1,
+         typename Container2,
+         typename DeviceAdapterTag,
+         int NumFields>
+DAX_CONT_EXPORT
+void InterpolatePointFields(
+    const WeightsHandleType &weights,
+    const dax::Tuple<
+      dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>,NumFields> &inputs,
+    dax::Tuple<
+      dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>,NumFields> &outputs)
+{
+  typedef typename dax::cont::ArrayHandle<
+      T,Container1,DeviceAdapterTag>::PortalConstExecution InPortalType;
+  typedef typename dax::cont::ArrayHandle<
+      T,Container2,DeviceAdapterTag>::PortalExecution OutPortalType;
+  typedef dax::exec::internal::kernel::InterpolateFieldsToFields<
+      InPortalType,
+      typename WeightsHandleType::PortalConstExecution,
+      OutPortalType,
+      NumFields> InterpolateType;
+
+  const dax::Id size = weights.GetNumberOfValues();
+  typename InterpolateType::InPortalsType inPortals;
+  typename InterpolateType::OutPortalsType outPortals;
+  for (int field = 0; field < NumFields; field++)
+    {
+    inPortals[field] = inputs[field].PrepareForInput();
+    outPortals[field] = outputs[field].PrepareForOutput(size);
+    }
+
+  InterpolateType interpolate(inPortals, weights.PrepareForInput(), outPortals);
+  dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(interpolate,
+                                                                size);
+}
+
+/// Compacts all the fields in \c inputs to the entries flagged in \c mask
+/// in a single schedule.
+///
+template<typename MaskHandleType,
+         typename T,
+         typename Container1,
+         typename Container2,
+         typename DeviceAdapterTag,
+         int NumFields>
+DAX_CONT_EXPORT
+void MaskPointFields(
+    const MaskHandleType &mask,
+    const dax::Tuple<
+      dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>,NumFields> &inputs,
+    dax::Tuple<
+      dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>,NumFields> &outputs)
+{
+  typedef dax::cont::ArrayHandle<dax::Id,
+      dax::cont::ArrayContainerControlTagBasic,
+      DeviceAdapterTag> IdArrayHandleType;
+  typedef typename dax::cont::ArrayHandle<
+      T,Container1,DeviceAdapterTag>::PortalConstExecution InPortalType;
+  typedef typename dax::cont::ArrayHandle<
+      T,Container2,DeviceAdapterTag>::PortalExecution OutPortalType;
+  typedef dax::exec::internal::kernel::GatherFieldsToFields<
+      InPortalType,
+      typename IdArrayHandleType::PortalConstExecution,
+      OutPortalType,
+      NumFields> GatherType;
+
+  //the mask is read once to find the kept entries, for all the fields
+  IdArrayHandleType keptIds;
+  dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::StreamCompact(mask,
+                                                                     keptIds);
+
+  const dax::Id size = keptIds.GetNumberOfValues();
+  typename GatherType::InPortalsType inPortals;
+  typename GatherType::OutPortalsType outPortals;
+  for (int field = 0; field < NumFields; field++)
+    {
+    inPortals[field] = inputs[field].PrepareForInput();
+    outPortals[field] = outputs[field].PrepareForOutput(size);
+    }
+
+  GatherType gather(inPortals, keptIds.PrepareForInput(), outPortals);
+  dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(gather, size);
+}
+
+} // namespace detail
+
+/// \brief Records how a generate dispatcher built its output grid.
+///
+/// DispatcherGenerateTopology and DispatcherGenerateInterpolatedCells export
+/// a TopologyPlan after every Invoke (see their GetTopologyPlan). The plan
+/// holds the map from each output cell to the input cell it was generated
+/// from, the visit index of each output cell, and how the output points
+/// derive from the input points: a point mask of the input points kept by
+/// DispatcherGenerateTopology, or the edge interpolation weights of
+/// DispatcherGenerateInterpolatedCells.
+///
+/// With the plan any number of point and cell fields of the input can be
+/// mapped to the output, and this can be repeated when only the values of
+/// the fields change between time steps, without running the dispatcher
+/// again. Copies of a plan share their arrays.
+///
+template<class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class TopologyPlan
+{
+public:
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayType;
+  typedef IdArrayType PointMaskType;
+  typedef dax::cont::ArrayHandle<dax::PointAsEdgeInterpolation,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> InterpolationWeightsType;
+
+  DAX_CONT_EXPORT
+  TopologyPlan()
+    : Valid(false), HasVisitIndex(false), NumberOfInputCells(0),
+      CountPerCell(0) {  }
+
+  /// Starts a plan from the map of output cells to input cells. The point
+  /// mapping is given by SetPointMask or SetInterpolationWeights.
+  ///
+  DAX_CONT_EXPORT
+  explicit TopologyPlan(const IdArrayType &cellMap)
+    : CellMap(cellMap), Valid(true), HasVisitIndex(false),
+      NumberOfInputCells(0), CountPerCell(0) {  }
+
+  /// Starts a plan for a generate in which every input cell generated
+  /// \c countPerCell output cells. The cell map and visit index are then
+  /// implied, and are only built when GetCellMap or GetVisitIndex asks for
+  /// them.
+  ///
+  DAX_CONT_EXPORT
+  TopologyPlan(dax::Id numberOfInputCells, dax::Id countPerCell)
+    : Valid(true), HasVisitIndex(false),
+      NumberOfInputCells(numberOfInputCells), CountPerCell(countPerCell) {  }
+
+  /// True once the plan describes a generated grid. A dispatcher whose last
+  /// Invoke generated no cells exports a plan that is not valid.
+  ///
+  DAX_CONT_EXPORT
+  bool IsValid() const { return this->Valid; }
+
+  /// The number of output cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return this->IsFanout() ? this->GetFanout().GetNumberOfOutputs()
+                            : this->CellMap.GetNumberOfValues();
+  }
+
+  /// For each output cell, the index of the input cell it came from.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayType GetCellMap() const
+  {
+    if (this->IsFanout() &&
+        this->CellMap.GetNumberOfValues() != this->GetNumberOfCells())
+      {
+      dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+            this->GetFanout().GetCellMap(), this->CellMap);
+      }
+    return this->CellMap;
+  }
+
+  /// For each output cell, how many cells the same input cell generated
+  /// before it. Dispatchers only compute the visit index when their
+  /// worklet asks for it, so it is computed from the cell map on the first
+  /// call otherwise.
+  ///
+  DAX_CONT_EXPORT
+  IdArrayType GetVisitIndex()
+  {
+    if (!this->HasVisitIndex && this->Valid && this->IsFanout())
+      {
+      dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+            this->GetFanout().GetVisitIndex(), this->VisitIndex);
+      this->HasVisitIndex = true;
+      }
+    else if (!this->HasVisitIndex && this->Valid)
+      {
+      dax::cont::dispatcher::internal::MakeVisitIndexControlType<
+          true,
+          dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>,
+          IdArrayType>()(this->CellMap, this->VisitIndex);
+      this->HasVisitIndex = true;
+      }
+    return this->VisitIndex;
+  }
+
+  DAX_CONT_EXPORT
+  void SetVisitIndex(const IdArrayType &visitIndex)
+  {
+    this->VisitIndex = visitIndex;
+    this->HasVisitIndex = true;
+  }
+
+  /// Flags for each input point, 1 if it is used by the output grid. Only
+  /// set when the output points are a subset of the input points.
+  ///
+  DAX_CONT_EXPORT
+  PointMaskType GetPointMask() const { return this->PointMask; }
+  DAX_CONT_EXPORT
+  void SetPointMask(const PointMaskType &mask) { this->PointMask = mask; }
+
+  /// For each output point, the input edge and weight it is interpolated
+  /// from. Only set when the output points are interpolated.
+  ///
+  DAX_CONT_EXPORT
+  InterpolationWeightsType GetInterpolationWeights() const
+  {
+    return this->InterpolationWeights;
+  }
+  DAX_CONT_EXPORT
+  void SetInterpolationWeights(const InterpolationWeightsType &weights)
+  {
+    this->InterpolationWeights = weights;
+  }
+
+  /// Maps a field on the points of the input grid to the points of the
+  /// output grid, by compacting it with the point mask or interpolating it
+  /// with the weights. Returns false, leaving \c output untouched, when the
+  /// plan has neither because the output grid uses the input points as is.
+  ///
+  template<typename T, typename Container1, typename Container2>
+  DAX_CONT_EXPORT
+  bool CompactPointField(
+      const dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>& input,
+      dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>& output) const
+  {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "TopologyPlan::CompactPointField");
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+    if (this->InterpolationWeights.GetNumberOfValues() > 0)
+      {
+      typedef typename dax::cont::ArrayHandle<
+          T,Container1,DeviceAdapterTag>::PortalConstExecution InPortalType;
+      typedef typename InterpolationWeightsType::PortalConstExecution
+          WeightsPortalType;
+      typedef typename dax::cont::ArrayHandle<
+          T,Container2,DeviceAdapterTag>::PortalExecution OutPortalType;
+
+      const dax::Id size = this->InterpolationWeights.GetNumberOfValues();
+      dax::exec::internal::kernel::InterpolateFieldToField<InPortalType,
+                                                           WeightsPortalType,
+                                                           OutPortalType>
+          interpolate(input.PrepareForInput(),
+                      this->InterpolationWeights.PrepareForInput(),
+                      output.PrepareForOutput(size));
+      Algorithm::Schedule(interpolate, size);
+      return true;
+      }
+    if (this->PointMask.GetNumberOfValues() > 0)
+      {
+      Algorithm::StreamCompact(input, this->PointMask, output);
+      return true;
+      }
+    return false;
+  }
+
+  /// Same as CompactPointField for several fields of the same type at once.
+  /// All the fields are mapped in a single pass, which reads the weights or
+  /// point mask once instead of once per field.
+  ///
+  template<typename T, typename Container1, typename Container2, int NumFields>
+  DAX_CONT_EXPORT
+  bool CompactPointFields(
+      const dax::Tuple<dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>,
+                       NumFields>& inputs,
+      dax::Tuple<dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>,
+                 NumFields>& outputs) const
+  {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "TopologyPlan::CompactPointFields");
+
+    if (this->InterpolationWeights.GetNumberOfValues() > 0)
+      {
+      dax::cont::detail::InterpolatePointFields(this->InterpolationWeights,
+                                                inputs,
+                                                outputs);
+      return true;
+      }
+    if (this->PointMask.GetNumberOfValues() > 0)
+      {
+      dax::cont::detail::MaskPointFields(this->PointMask, inputs, outputs);
+      return true;
+      }
+    return false;
+  }
+
+  /// Maps a field on the cells of the input grid to the cells of the output
+  /// grid. Every output cell gets the value of the cell it came from.
+  ///
+  template<typename T, typename Container1, typename Container2>
+  DAX_CONT_EXPORT
+  void CompactCellField(
+      const dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>& input,
+      dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>& output) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    if (this->IsFanout())
+      {
+      Algorithm::Copy(
+            dax::cont::make_ArrayHandlePermutation(
+              this->GetFanout().GetCellMap(), input),
+            output);
+      }
+    else
+      {
+      Algorithm::Copy(
+            dax::cont::make_ArrayHandlePermutation(this->CellMap, input),
+            output);
+      }
+  }
+
+  /// Drops the arrays of the plan and marks it as not valid. Copies of the
+  /// plan keep working; the memory is freed once the last of them is
+  /// released or destroyed.
+  ///
+  DAX_CONT_EXPORT
+  void ReleaseResources()
+  {
+    *this = TopologyPlan();
+  }
+
+private:
+  DAX_CONT_EXPORT
+  bool IsFanout() const { return this->CountPerCell > 0; }
+
+  DAX_CONT_EXPORT
+  dax::cont::dispatcher::GenerateFanout<DeviceAdapterTag> GetFanout() const
+  {
+    return dax::cont::dispatcher::GenerateFanout<DeviceAdapterTag>(
+          this->NumberOfInputCells, this->CountPerCell);
+  }
+
+  // Built on demand by GetCellMap when the plan has a fixed fanout.
+  mutable IdArrayType CellMap;
+  IdArrayType VisitIndex;
+  PointMaskType PointMask;
+  InterpolationWeightsType InterpolationWeights;
+  bool Valid;
+  bool HasVisitIndex;
+  dax::Id NumberOfInputCells;
+  dax::Id CountPerCell;
+};
+
+namespace detail {
+
+/// Stores the visit index computed by a generate dispatcher in its plan.
+/// When the worklet did not ask for the visit index the dispatcher only has
+/// a placeholder value, and the plan computes the index when requested.
+///
+template<class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void SetTopologyPlanVisitIndex(
+    dax::cont::TopologyPlan<DeviceAdapterTag> &plan,
+    const typename dax::cont::TopologyPlan<DeviceAdapterTag>::IdArrayType
+      &visitIndex)
+{
+  plan.SetVisitIndex(visitIndex);
+}
+
+template<class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void SetTopologyPlanVisitIndex(dax::cont::TopologyPlan<DeviceAdapterTag> &,
+                               dax::Id)
+{  }
+
+} // namespace detail
+
+} } // namespace dax::cont
+
+#endif //__dax_cont_TopologyPlan_h
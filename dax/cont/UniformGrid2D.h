@@ -0,0 +1,235 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__UniformGrid2D_h
+#define __dax__cont__UniformGrid2D_h
+
+#include <dax/cont/ArrayContainerControlImplicit.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <dax/CellTag.h>
+
+#include <dax/exec/internal/TopologyUniform2D.h>
+
+namespace dax {
+namespace cont {
+
+namespace detail {
+
+class ArrayPortalFromUniformGrid2DPointCoordinates
+{
+public:
+  typedef dax::Vector3 ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalFromUniformGrid2DPointCoordinates> IteratorType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalFromUniformGrid2DPointCoordinates() {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalFromUniformGrid2DPointCoordinates(dax::Vector3 origin,
+                                               dax::Vector2 spacing,
+                                               dax::Extent2 extent):
+  Origin(origin),
+  Spacing(spacing),
+  Extent(extent),
+  NumberOfValues(0)
+  {
+    const dax::Id2 dims = dax::extentDimensions(extent);
+    this->NumberOfValues = dims[0]*dims[1];
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    dax::Id2 location = dax::flatIndexToIndex2(index, this->Extent);
+    return dax::make_Vector3(this->Origin[0] + this->Spacing[0]*location[0],
+                             this->Origin[1] + this->Spacing[1]*location[1],
+                             this->Origin[2]);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  dax::Vector3 Origin;
+  dax::Vector2 Spacing;
+  dax::Extent2 Extent;
+  dax::Id NumberOfValues;
+};
+
+} // namespace detail
+
+/// This class defines the topology of a 2D uniform grid, such as an image.
+/// The grid lies in the plane z = Origin[2], is axis aligned and has uniform
+/// spacing between grid points in both dimensions. Its cells are pixels,
+/// represented as dax::CellTagQuadrilateral, and MapCell worklets on this grid
+/// are scheduled on 2D indices.
+///
+template <class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class UniformGrid2D
+{
+public:
+  typedef dax::CellTagQuadrilateral CellTag;
+  typedef dax::cont::internal::UniformGrid2DTag GridTypeTag;
+
+  DAX_CONT_EXPORT
+  UniformGrid2D()
+    : Origin(dax::make_Vector3(0.0, 0.0, 0.0)),
+      Spacing(dax::make_Vector2(1.0, 1.0))
+  {
+    this->SetExtent(dax::Id2(0, 0), dax::Id2(0, 0));
+  }
+
+  /// The extent defines the minimum and maximum (inclusive) indices in each
+  /// dimension.
+  ///
+  DAX_CONT_EXPORT
+  const dax::Extent2 &GetExtent() const { return this->Extent; }
+  void SetExtent(const dax::Extent2 &extent) { this->Extent = extent; }
+  void SetExtent(const dax::Id2 &min, const dax::Id2 &max) {
+    this->Extent.Min = min;
+    this->Extent.Max = max;
+  }
+
+  /// The origin is the location in space of the point at grid position
+  /// (0, 0). Its z component gives the plane the grid lies in.
+  ///
+  DAX_CONT_EXPORT
+  const dax::Vector3 &GetOrigin() const { return this->Origin; }
+  void SetOrigin(const dax::Vector3 &coords) { this->Origin = coords; }
+
+  /// The spacing is the distance between grid points along the x and y axes.
+  ///
+  DAX_CONT_EXPORT
+  const dax::Vector2 &GetSpacing() const { return this->Spacing; }
+  void SetSpacing(const dax::Vector2 &distances) { this->Spacing = distances; }
+
+  // Helper functions
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    dax::Id2 dims = dax::extentDimensions(this->GetExtent());
+    return dims[0]*dims[1];
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    dax::Id2 dims = dax::extentCellDimensions(this->GetExtent());
+    return dims[0]*dims[1];
+  }
+
+  /// Converts an i, j point location to a point index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputePointIndex(const dax::Id2 &ij) const {
+    return dax::index2ToFlatIndex(ij, this->GetExtent());
+  }
+
+  /// Converts an i, j cell location to a cell index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputeCellIndex(const dax::Id2 &ij) const {
+    return dax::index2ToFlatIndexCell(ij, this->GetExtent());
+  }
+
+  /// Converts a flat point index to an i, j point location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id2 ComputePointLocation(dax::Id index) const {
+    return dax::flatIndexToIndex2(index, this->GetExtent());
+  }
+
+  /// Converts a flat cell index to an i, j cell location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id2 ComputeCellLocation(dax::Id index) const {
+    return dax::flatIndexToIndex2Cell(index, this->GetExtent());
+  }
+
+  /// Given a point i, j location, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id2 location) const {
+    return dax::make_Vector3(
+          this->GetOrigin()[0] + this->GetSpacing()[0]*location[0],
+          this->GetOrigin()[1] + this->GetSpacing()[1]*location[1],
+          this->GetOrigin()[2]);
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->ComputePointCoordinates(this->ComputePointLocation(index));
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,
+      dax::cont::ArrayContainerControlTagImplicit<
+          detail::ArrayPortalFromUniformGrid2DPointCoordinates>,
+      DeviceAdapterTag> PointCoordinatesType;
+
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    detail::ArrayPortalFromUniformGrid2DPointCoordinates portal(this->Origin,
+                                                                this->Spacing,
+                                                                this->Extent);
+    return PointCoordinatesType(portal);
+  }
+
+  typedef dax::exec::internal::TopologyUniform2D TopologyStructConstExecution;
+  typedef dax::exec::internal::TopologyUniform2D TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Origin = this->Origin;
+    topology.Spacing = this->Spacing;
+    topology.Extent = this->Extent;
+    return topology;
+  }
+
+private:
+  dax::Vector3 Origin;
+  dax::Vector2 Spacing;
+  dax::Extent2 Extent;
+};
+
+}
+}
+
+#endif //__dax__cont__UniformGrid2D_h
@@ -20,6 +20,7 @@
 #include <dax/CellTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/PointToCellLinks.h>
 #include <dax/cont/internal/GridTags.h>
 #include <dax/exec/internal/TopologyUnstructured.h>
 
@@ -74,6 +75,7 @@ public:
   }
   void SetCellConnections(CellConnectionsType cellConnections) {
     this->CellConnections = cellConnections;
+    this->Links = PointToCellLinksType();
   }
 
 
@@ -91,6 +93,7 @@ public:
   DAX_CONT_EXPORT
   void SetPointCoordinates(PointCoordinatesType pointCoordinates) {
     this->PointCoordinates = pointCoordinates;
+    this->Links = PointToCellLinksType();
   }
 
   // Helper functions
@@ -118,6 +121,36 @@ public:
             / dax::CellTraits<CellTag>::NUM_VERTICES);
   }
 
+  typedef dax::cont::PointToCellLinks<DeviceAdapterTag> PointToCellLinksType;
+
+  /// Builds the reverse (point to cell) connectivity of the grid. The links
+  /// are computed on the first call and cached, so calling this again is
+  /// cheap. Setting new connections or points discards the cached links, as
+  /// does calling ReleasePointToCellLinks. If the connections are modified
+  /// in place, release the links so that they get rebuilt.
+  ///
+  DAX_CONT_EXPORT
+  const PointToCellLinksType &BuildPointToCellLinks() {
+    if (!this->Links.IsValid())
+      {
+      this->Links.Build(this->CellConnections,
+                        dax::CellTraits<CellTag>::NUM_VERTICES,
+                        this->GetNumberOfPoints());
+      }
+    return this->Links;
+  }
+
+  /// Returns the reverse connectivity built by BuildPointToCellLinks. The
+  /// returned links are not valid if they have not been built.
+  ///
+  DAX_CONT_EXPORT
+  const PointToCellLinksType &GetPointToCellLinks() const {
+    return this->Links;
+  }
+
+  DAX_CONT_EXPORT
+  void ReleasePointToCellLinks() { this->Links.ReleaseResources(); }
+
   typedef dax::exec::internal::TopologyUnstructured<
       CellTag, typename CellConnectionsType::PortalConstExecution>
       TopologyStructConstExecution;
@@ -158,6 +191,7 @@ public:
 private:
   CellConnectionsType CellConnections;
   PointCoordinatesType PointCoordinates;
+  PointToCellLinksType Links;
 };
 
 }
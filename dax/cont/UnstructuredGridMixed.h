@@ -0,0 +1,233 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_UnstructuredGridMixed_h
+#define __dax_cont_UnstructuredGridMixed_h
+
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/exec/internal/TopologyUnstructuredMixed.h>
+
+namespace dax {
+namespace cont {
+
+/// This class defines the topology of an unstructured grid whose cells can be
+/// of different types. Three arrays define the cells. The Shapes array holds
+/// for each cell the dax::CellTraits::CELL_SHAPE of its type. The Offsets
+/// array holds for each cell the index in the CellConnections array of its
+/// first vertex. The CellConnections array holds the point indices of the
+/// vertices of all cells, one cell after the other.
+///
+/// When a mixed grid is given to dax::cont::DispatcherMapCell, the worklet is
+/// instantiated for every supported cell type and each cell is handed to the
+/// instance matching its shape. Currently hexahedra, wedges and tetrahedra are
+/// supported.
+///
+template <
+    class CellConnectionsContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class PointsArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class UnstructuredGridMixed
+{
+public:
+  typedef dax::cont::internal::UnstructuredGridMixedTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      ShapesType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      OffsetsType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      CellConnectionsType;
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3, PointsArrayContainerControlTag, DeviceAdapterTag>
+      PointCoordinatesType;
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixed() { }
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixed(ShapesType shapes,
+                        OffsetsType offsets,
+                        CellConnectionsType cellConnections,
+                        PointCoordinatesType pointCoordinates)
+    : Shapes(shapes),
+      Offsets(offsets),
+      CellConnections(cellConnections),
+      PointCoordinates(pointCoordinates)
+  {
+    DAX_ASSERT_CONT(this->Shapes.GetNumberOfValues()
+                    == this->Offsets.GetNumberOfValues());
+  }
+
+  /// The Shapes array gives the type of each cell as the CELL_SHAPE value of
+  /// its dax::CellTraits. The length of this array is the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  const ShapesType &GetShapes() const { return this->Shapes; }
+  DAX_CONT_EXPORT
+  ShapesType &GetShapes() { return this->Shapes; }
+  DAX_CONT_EXPORT
+  void SetShapes(ShapesType shapes) { this->Shapes = shapes; }
+
+  /// The Offsets array gives for each cell the index in the CellConnections
+  /// array where the point indices of that cell start.
+  ///
+  DAX_CONT_EXPORT
+  const OffsetsType &GetOffsets() const { return this->Offsets; }
+  DAX_CONT_EXPORT
+  OffsetsType &GetOffsets() { return this->Offsets; }
+  DAX_CONT_EXPORT
+  void SetOffsets(OffsetsType offsets) { this->Offsets = offsets; }
+
+  /// The CellConnections array defines the connectivity of the mesh. Each
+  /// cell is represented by as many point indices as its type has vertices.
+  ///
+  DAX_CONT_EXPORT
+  const CellConnectionsType &GetCellConnections() const {
+    return this->CellConnections;
+  }
+  DAX_CONT_EXPORT
+  CellConnectionsType &GetCellConnections() {
+    return this->CellConnections;
+  }
+  DAX_CONT_EXPORT
+  void SetCellConnections(CellConnectionsType cellConnections) {
+    this->CellConnections = cellConnections;
+  }
+
+  /// The PointCoordinates array defines the location of each point.  The
+  /// length of this array defines how many points are in the mesh.
+  ///
+  DAX_CONT_EXPORT
+  const PointCoordinatesType &GetPointCoordinates() const {
+    return this->PointCoordinates;
+  }
+  DAX_CONT_EXPORT
+  PointCoordinatesType &GetPointCoordinates() {
+    return this->PointCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetPointCoordinates(PointCoordinatesType pointCoordinates) {
+    this->PointCoordinates = pointCoordinates;
+  }
+
+  // Helper functions
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const{
+    DAX_ASSERT_CONT(this->PointCoordinates.GetNumberOfValues() >= index);
+    DAX_ASSERT_CONT(index >= 0);
+    return this->PointCoordinates.GetPortalConstControl().Get(index);
+  }
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    return this->PointCoordinates.GetNumberOfValues();
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    return this->Shapes.GetNumberOfValues();
+  }
+
+  /// The execution topology that reads the cells of this grid as cells of
+  /// type \c CellTag.
+  ///
+  template<class CellTag>
+  struct TopologyOfCell
+  {
+    typedef dax::exec::internal::TopologyUnstructuredMixed<
+        CellTag,
+        typename OffsetsType::PortalConstExecution,
+        typename CellConnectionsType::PortalConstExecution> type;
+  };
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment, seeing every cell as a \c CellTag. Returns a
+  /// structure that can be used directly in the execution environment.
+  ///
+  template<class CellTag>
+  DAX_CONT_EXPORT
+  typename TopologyOfCell<CellTag>::type PrepareForInput() const {
+    return typename TopologyOfCell<CellTag>::type(
+          this->Offsets.PrepareForInput(),
+          this->CellConnections.PrepareForInput(),
+          this->GetNumberOfPoints());
+  }
+
+private:
+  ShapesType Shapes;
+  OffsetsType Offsets;
+  CellConnectionsType CellConnections;
+  PointCoordinatesType PointCoordinates;
+};
+
+namespace internal {
+
+/// A view of a dax::cont::UnstructuredGridMixed that presents all of its
+/// cells as \c CellT. Dispatchers replace a mixed grid argument with one of
+/// these views for every supported cell type so that the worklet bindings can
+/// be resolved statically.
+///
+template<typename CellT, class MixedGridType>
+class UnstructuredGridMixedOfCell
+{
+public:
+  typedef CellT CellTag;
+  typedef dax::cont::internal::UnstructuredGridMixedTag GridTypeTag;
+  typedef typename MixedGridType::template TopologyOfCell<CellTag>::type
+      TopologyStructConstExecution;
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixedOfCell() { }
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixedOfCell(const MixedGridType &grid) : Grid(grid) { }
+
+  DAX_CONT_EXPORT
+  const MixedGridType &GetMixedGrid() const { return this->Grid; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const { return this->Grid.GetNumberOfPoints(); }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const { return this->Grid.GetNumberOfCells(); }
+
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    return this->Grid.template PrepareForInput<CellTag>();
+  }
+
+private:
+  MixedGridType Grid;
+};
+
+} // namespace internal
+
+}
+}
+
+#endif //__dax_cont_UnstructuredGridMixed_h
@@ -41,7 +41,7 @@ public:
     Portal()
     {}
 
-  DAX_CONT_EXPORT ExecArg GetExecArg()
+  DAX_CONT_EXPORT ExecArg GetExecArg() const
     {
     return ExecArg(this->Portal);
     }
@@ -90,7 +90,7 @@ public:
     Portal()
     {}
 
-  DAX_CONT_EXPORT ExecArg GetExecArg()
+  DAX_CONT_EXPORT ExecArg GetExecArg() const
     {
     return ExecArg(this->Portal);
     }
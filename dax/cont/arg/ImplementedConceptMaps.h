@@ -21,16 +21,23 @@
 //Add all concept maps to this header so that dispatchers can find them.
 #include <dax/cont/arg/ConceptMap.h>
 #include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/arg/FieldArrayHandleCompact.h>
+#include <dax/cont/arg/FieldArrayHandleConcatenate.h>
 #include <dax/cont/arg/FieldArrayHandleConstant.h>
 #include <dax/cont/arg/FieldArrayHandleCounting.h>
 #include <dax/cont/arg/FieldArrayHandleImplicit.h>
 #include <dax/cont/arg/FieldArrayHandlePermutation.h>
 #include <dax/cont/arg/FieldArrayHandleTransform.h>
+#include <dax/cont/arg/FieldArrayHandleView.h>
 #include <dax/cont/arg/FieldConstant.h>
 #include <dax/cont/arg/FieldMap.h>
 #include <dax/cont/arg/Geometry.h>
 #include <dax/cont/arg/GeometryEdgeInterpolatedGrid.h>
+#include <dax/cont/arg/TopologyRectilinearGrid.h>
+#include <dax/cont/arg/TopologyStructuredGrid.h>
 #include <dax/cont/arg/TopologyUniformGrid.h>
+#include <dax/cont/arg/TopologyUniformGrid2D.h>
 #include <dax/cont/arg/TopologyUnstructuredGrid.h>
+#include <dax/cont/arg/TopologyUnstructuredGridMixed.h>
 
 #endif
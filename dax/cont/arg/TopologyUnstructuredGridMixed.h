@@ -0,0 +1,91 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_TopologyUnstructuredGridMixed_h
+#define __dax_cont_arg_TopologyUnstructuredGridMixed_h
+
+#include <dax/Types.h>
+#include <dax/internal/Tags.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/arg/TopologyCell.h>
+#include <dax/cont/UnstructuredGridMixed.h>
+
+#include <boost/mpl/assert.hpp>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile TopologyUnstructuredGridMixed.h dax/cont/arg/TopologyUnstructuredGridMixed.h
+/// \brief Map a single cell type view of a mixed unstructured grid to an
+/// execution side cell topology parameter. Mixed grids can only be inputs.
+template <typename Tags,
+          typename Cell,
+          typename MixedGridType
+          >
+class ConceptMap<Topology(Tags),
+                 dax::cont::internal::UnstructuredGridMixedOfCell<
+                   Cell, MixedGridType> >
+{
+  typedef dax::cont::internal::UnstructuredGridMixedOfCell<
+      Cell, MixedGridType> GridType;
+
+  // If you get a compile error here, you are trying to use a mixed grid as
+  // an output topology, which is not supported.
+  BOOST_MPL_ASSERT_NOT((typename Tags::template Has<dax::cont::sig::Out>));
+
+  typedef typename GridType::TopologyStructConstExecution TopologyType;
+
+  typedef dax::exec::arg::TopologyCell<Tags,TopologyType> ExecGridType;
+  GridType Grid;
+  TopologyType Topology;
+
+public:
+  //All Topology binding classes must export the cell tag and grid tag
+  //This allows us to do better scheduling based on cell / grid types
+  typedef typename GridType::CellTag CellTypeTag;
+  typedef typename GridType::GridTypeTag GridTypeTag;
+
+  typedef GridType ContArg;
+  typedef ExecGridType ExecArg;
+  typedef dax::cont::sig::Cell DomainTag;
+
+  ConceptMap(GridType g): Grid(g) {}
+
+  ExecArg GetExecArg() const { return ExecGridType(this->Topology); }
+
+  //All topology fields are required by dispatchers to expose the cont arg
+  DAX_CONT_EXPORT const ContArg& GetContArg() const { return this->Grid; }
+
+  void ToExecution(dax::Id)
+    { /* Input  */
+    this->Topology = this->Grid.PrepareForInput();
+    }
+
+  dax::Id GetDomainLength(sig::Point) const
+    {
+    return Grid.GetNumberOfPoints();
+    }
+
+  dax::Id GetDomainLength(sig::Cell) const
+    {
+    return Grid.GetNumberOfCells();
+    }
+};
+
+}}} // namespace dax::cont::arg
+
+#endif //__dax_cont_arg_TopologyUnstructuredGridMixed_h
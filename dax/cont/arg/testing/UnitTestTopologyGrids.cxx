@@ -14,6 +14,8 @@
 //
 //=============================================================================
 
+#include <dax/cont/arg/TopologyRectilinearGrid.h>
+#include <dax/cont/arg/TopologyStructuredGrid.h>
 #include <dax/cont/arg/TopologyUniformGrid.h>
 #include <dax/cont/arg/TopologyUnstructuredGrid.h>
 
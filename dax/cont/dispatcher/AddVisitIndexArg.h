@@ -44,22 +44,41 @@ template<bool GenerateVisitIndex,
 struct MakeVisitIndexControlType
 {
   typedef HandleType Type;
+  typedef typename HandleType::PortalExecution PortalType;
 
   template<typename OtherHandleType>
   void operator()(const OtherHandleType& inputCellIds, Type& visitIndices) const
   {
-    //To determine the number of times we have already visited
-    //the current input cell, we take the lower bounds of the
-    //input cell id array. The resulting number subtracted from the WorkId
-    //gives us the number of times we have visited that cell
-    visitIndices.PrepareForOutput(inputCellIds.GetNumberOfValues());
-    Algorithm::LowerBounds(inputCellIds, inputCellIds, visitIndices);
-
-    dax::cont::DispatcherMapField<
-           dax::exec::internal::kernel::ComputeVisitIndex,
-          typename OtherHandleType::DeviceAdapterTag > dispatcher;
-
-    dispatcher.Invoke( visitIndices, visitIndices ); //as input and output
+    //The cell map lists the input cells in order, so the number of times we
+    //have already visited the current input cell is the distance to the
+    //start of its run of equal ids. Flag the run starts, compact their
+    //indices and scan the flags to number the run of each output, so that
+    //every output finds its run start with constant work.
+    typedef typename OtherHandleType::PortalConstExecution CellMapPortalType;
+    const dax::Id numValues = inputCellIds.GetNumberOfValues();
+    dax::exec::internal::kernel::VisitIndexRunStartFlags<
+        CellMapPortalType, PortalType>
+        flags(inputCellIds.PrepareForInput(),
+              visitIndices.PrepareForOutput(numValues));
+    Algorithm::Schedule(flags, numValues);
+
+    HandleType runStarts;
+    Algorithm::StreamCompact(visitIndices, runStarts);
+    Algorithm::ScanInclusive(visitIndices, visitIndices);
+
+    dax::exec::internal::kernel::VisitIndexFromRunStarts<
+        typename HandleType::PortalConstExecution, PortalType>
+        fromRunStarts(runStarts.PrepareForInput(),
+                      visitIndices.PrepareForInPlace());
+    Algorithm::Schedule(fromRunStarts, numValues);
+  }
+
+  //When the visit indices are known without searching the cell map, as in
+  //the fixed fanout generate, just use them.
+  template<typename OtherHandleType>
+  void Use(const OtherHandleType& knownVisitIndices, Type& visitIndices) const
+  {
+    visitIndices = knownVisitIndices;
   }
 };
 
@@ -76,6 +95,12 @@ struct MakeVisitIndexControlType<false,Algorithm,HandleType>
     //won't be uploaded to the execution env.
     value = 0;
   }
+
+  template<typename OtherHandleType>
+  void Use(const OtherHandleType& daxNotUsed(handle), Type& value) const
+  {
+    value = 0;
+  }
 };
 }
 
@@ -112,6 +137,13 @@ public:
     VisitContFunction()(cellRange,visitIndex);
     }
 
+  template<class HandleType>
+  void UseVisitIndex(const HandleType& knownVisitIndex,
+                     VisitIndexArgType& visitIndex)
+    {
+    VisitContFunction().Use(knownVisitIndex,visitIndex);
+    }
+
 };
 
 } } } //dax::cont::dispatcher
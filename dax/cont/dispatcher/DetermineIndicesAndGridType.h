@@ -40,6 +40,24 @@ namespace internal
     typedef dax::Id3 type;
   };
 
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::UniformGrid2DTag >
+  {
+    typedef dax::Id2 type;
+  };
+
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::Id3 type;
+  };
+
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::StructuredGridTag >
+  {
+    typedef dax::Id3 type;
+  };
+
   template< class GridTypeTag>
   struct GenerateGridCount
   {
@@ -62,6 +80,68 @@ namespace internal
       }
   };
 
+  template<>
+  struct GenerateGridCount< dax::cont::internal::UniformGrid2DTag >
+  {
+    typedef dax::cont::internal::UniformGrid2DTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
+  template<>
+  struct GenerateGridCount< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
+  template<>
+  struct GenerateGridCount< dax::cont::internal::StructuredGridTag >
+  {
+    typedef dax::cont::internal::StructuredGridTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
+  // Morton traversal over bricks is only supported on uniform grids, whose
+  // cells need nothing but their i, j, k location.
+  template< class GridTypeTag >
+  struct MortonCellDimensions
+  {
+    enum { SUPPORTED = false };
+
+    template<class Topo>
+    dax::Id3 operator()(const Topo&) const { return dax::Id3(0, 0, 0); }
+  };
+
+  template<>
+  struct MortonCellDimensions< dax::cont::internal::UniformGridTag >
+  {
+    enum { SUPPORTED = true };
+
+    template<class Topo>
+    dax::Id3 operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
   template<typename ReturnType, int N, typename BindingsType>
   const ReturnType& get_topology(const BindingsType& bindings)
   {
@@ -91,6 +171,12 @@ public:
 
  bool isValidForGridScheduling() const
     { return false; }
+
+  bool isValidForMortonScheduling() const
+    { return false; }
+
+  dax::Id3 mortonCellDimensions() const
+    { return dax::Id3(0, 0, 0); }
 };
 
 
@@ -144,6 +230,19 @@ public:
     return this->NumInstances == this->Topology.GetNumberOfCells();
     }
 
+  //cells can be visited in Morton order over bricks instead of row-major
+  //order when the grid is scheduled by cell and is uniform
+  bool isValidForMortonScheduling() const
+    {
+    return internal::MortonCellDimensions<GridTypeTag>::SUPPORTED &&
+           this->isValidForGridScheduling();
+    }
+
+  dax::Id3 mortonCellDimensions() const
+    {
+    return internal::MortonCellDimensions<GridTypeTag>()(this->Topology);
+    }
+
 };
 
 } } } //namespace dax::cont::dispatcher
@@ -33,9 +33,13 @@
 #include <dax/cont/dispatcher/CollectCount.h>
 #include <dax/cont/dispatcher/CreateExecutionResources.h>
 #include <dax/cont/dispatcher/DetermineIndicesAndGridType.h>
+#include <dax/cont/dispatcher/MixedCellInvocation.h>
+#include <dax/cont/dispatcher/ProfilePhase.h>
 #include <dax/cont/dispatcher/VerifyUserArgLength.h>
 
 #include <dax/exec/internal/Functor.h>
+#include <dax/exec/internal/FunctorMixedCell.h>
+#include <dax/exec/internal/FunctorMortonCells.h>
 
 namespace dax { namespace cont { namespace dispatcher {
 
@@ -65,6 +69,8 @@ public:
     // (Check the type for WorkletType. It should match WorkletBaseType.)
     BOOST_MPL_ASSERT((Worklet_Should_Match_DispatcherType));
 
+    dax::cont::dispatcher::ProfileInvoke<DeviceAdapterTag>
+        profileInvoke(this->GetActiveProfile());
     static_cast<DerivedDispatcher*>(this)->DoInvoke(
       this->Worklet, dax::internal::make_ParameterPack(arguments...));
     }
@@ -76,15 +82,60 @@ public:
 #     include BOOST_PP_ITERATE()
 #endif // !DAX_USE_VARIADIC_TEMPLATE
 
+  /// When set, every Invoke times its internal phases and counts the values
+  /// and bytes they handle, see dax::cont::DispatcherProfile. Off by
+  /// default, in which case the phases are not timed at all.
+  ///
+  DAX_CONT_EXPORT
+  void SetProfiling(bool b) { this->Profiling = b; }
+
+  DAX_CONT_EXPORT
+  bool GetProfiling() const { return this->Profiling; }
+
+  /// The phases of the last Invoke, when profiling.
+  ///
+  DAX_CONT_EXPORT
+  const dax::cont::DispatcherProfile &GetProfile() const
+    { return this->Profile; }
+
+  /// Passes each phase to \c callback as soon as it completes, when
+  /// profiling.
+  ///
+  DAX_CONT_EXPORT
+  void SetProfileCallback(dax::cont::DispatcherProfile::CallbackType callback,
+                          void *clientData)
+    { this->Profile.SetCallback(callback, clientData); }
+
 protected:
   DAX_CONT_EXPORT
-  DispatcherBase(WorkletType worklet) : Worklet(worklet)
+  DispatcherBase(WorkletType worklet)
+    : Worklet(worklet), Profiling(false)
     { }
 
+  /// The profile phases are added to, or NULL when not profiling. Pass it to
+  /// a ProfilePhase to time a phase.
+  ///
+  DAX_CONT_EXPORT
+  dax::cont::DispatcherProfile *GetActiveProfile() const
+    { return this->Profiling ? &this->Profile : NULL; }
+
   template <typename DerivedWorkletType, typename ParameterPackType>
   DAX_CONT_EXPORT
   void BasicInvoke(DerivedWorkletType worklet, const ParameterPackType &arguments) const
   {
+  this->BasicInvokeWithTraversal(worklet, arguments, false);
+  }
+
+  /// Same as BasicInvoke. When \c mortonCellTraversal is set, cell worklets
+  /// on uniform grids visit the cells in Morton order over small bricks
+  /// rather than in row-major order.
+  ///
+  template <typename DerivedWorkletType, typename ParameterPackType>
+  DAX_CONT_EXPORT
+  void BasicInvokeWithTraversal(DerivedWorkletType worklet,
+                                const ParameterPackType &arguments,
+                                bool mortonCellTraversal) const
+  {
   typedef typename boost::is_base_of<
         WorkletType, DerivedWorkletType > DerivedWorklet_Should_Match;
 
@@ -117,6 +168,52 @@ protected:
   bindings.ForEachCont(
         dax::cont::dispatcher::CollectCount<DomainType>(count));
 
+  this->template ScheduleBindings<Invocation>(worklet, bindings, count,
+                                              mortonCellTraversal);
+  }
+
+  /// Same as BasicInvoke, except that the worklet is scheduled \c count
+  /// times instead of using the length of the arguments in the domain of the
+  /// worklet. Use this when the domain is not given by any argument, such as
+  /// the points of the grid the point to cell links were built for.
+  ///
+  template <typename DerivedWorkletType, typename ParameterPackType>
+  DAX_CONT_EXPORT
+  void BasicInvoke(DerivedWorkletType worklet,
+                   const ParameterPackType &arguments,
+                   dax::Id count) const
+  {
+  typedef typename boost::is_base_of<
+        WorkletType, DerivedWorkletType > DerivedWorklet_Should_Match;
+  BOOST_MPL_ASSERT((DerivedWorklet_Should_Match));
+
+  typedef dax::cont::dispatcher::VerifyUserArgLength<DerivedWorkletType,
+              ParameterPackType::NUM_PARAMETERS> WorkletUserArgs;
+  DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+  DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+  typedef dax::internal::Invocation<DerivedWorkletType,ParameterPackType> Invocation;
+  typename dax::cont::internal::Bindings<Invocation>::type
+      bindings = dax::cont::internal::BindingsCreate(worklet, arguments);
+
+  this->template ScheduleBindings<Invocation>(worklet, bindings, count);
+  }
+
+  /// Invokes the worklet \c count times on arguments that are already
+  /// bound, in Morton order over bricks when \c mortonCellTraversal is set
+  /// and the arguments allow it.
+  ///
+  template <typename Invocation, typename DerivedWorkletType>
+  DAX_CONT_EXPORT
+  void ScheduleBindings(
+      DerivedWorkletType worklet,
+      typename dax::cont::internal::Bindings<Invocation>::type &bindings,
+      dax::Id count,
+      bool mortonCellTraversal = false) const
+  {
+  dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+      workletPhase(this->GetActiveProfile(), "Worklet", count);
+
   // Visit each bound argument to set up its representation in the
   // execution environment.
   bindings.ForEachCont(
@@ -131,7 +228,17 @@ protected:
                       WorkletBaseType, Invocation>  CellSchedulingIndices;
 
   CellSchedulingIndices cellScheduler(bindings,count);
-  if(cellScheduler.isValidForGridScheduling())
+  if(mortonCellTraversal && cellScheduler.isValidForMortonScheduling())
+    {
+    // Visit the cells in Morton order over bricks. The functor still gets
+    // the i, j, k index of each cell, so results land at the flat index.
+    dax::exec::internal::FunctorMortonCells<
+        dax::exec::internal::Functor<Invocation> >
+        mortonFunctor(bindingFunctor, cellScheduler.mortonCellDimensions());
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+            Schedule(mortonFunctor,mortonFunctor.GetNumberOfInstances());
+    }
+  else if(cellScheduler.isValidForGridScheduling())
     {
     // Schedule the worklet invocations in the execution environment
     // using the specialized id3 scheduler
@@ -146,8 +253,79 @@ protected:
     }
   }
 
+  /// Invokes the worklet on a grid with mixed cell types. The argument at
+  /// \c MixedGridIndex must be a dax::cont::UnstructuredGridMixed. The
+  /// arguments are bound once for every supported cell type and all cells are
+  /// scheduled together, each one running the worklet instantiated for the
+  /// type of that cell.
+  template <int MixedGridIndex,
+            typename DerivedWorkletType,
+            typename ParameterPackType>
+  DAX_CONT_EXPORT
+  void MixedCellInvoke(DerivedWorkletType worklet,
+                       const ParameterPackType &arguments) const
+  {
+  typedef dax::cont::dispatcher::VerifyUserArgLength<DerivedWorkletType,
+              ParameterPackType::NUM_PARAMETERS> WorkletUserArgs;
+  DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::NotEnoughParameters));
+  DAX_ASSERT_ARG_LENGTH((typename WorkletUserArgs::TooManyParameters));
+
+  typedef dax::cont::dispatcher::MixedCellInvocation<dax::CellTagHexahedron,
+      DerivedWorkletType, ParameterPackType, MixedGridIndex> HexahedronCells;
+  typedef dax::cont::dispatcher::MixedCellInvocation<dax::CellTagWedge,
+      DerivedWorkletType, ParameterPackType, MixedGridIndex> WedgeCells;
+  typedef dax::cont::dispatcher::MixedCellInvocation<dax::CellTagTetrahedron,
+      DerivedWorkletType, ParameterPackType, MixedGridIndex> TetrahedronCells;
+
+  typename HexahedronCells::BindingsType hexahedronBindings =
+      HexahedronCells::CreateBindings(worklet, arguments);
+  typename WedgeCells::BindingsType wedgeBindings =
+      WedgeCells::CreateBindings(worklet, arguments);
+  typename TetrahedronCells::BindingsType tetrahedronBindings =
+      TetrahedronCells::CreateBindings(worklet, arguments);
+
+  // The bindings only differ by the cell type of the topology, so any of
+  // them gives the count.
+  typedef typename DerivedWorkletType::DomainType DomainType;
+  dax::Id count=1;
+  hexahedronBindings.ForEachCont(
+        dax::cont::dispatcher::CollectCount<DomainType>(count));
+
+  dax::cont::dispatcher::ProfilePhase<DeviceAdapterTag>
+      workletPhase(this->GetActiveProfile(), "Worklet", count);
+
+  // Each set of bindings gets its own execution representation. Arrays shared
+  // between them are only transferred once, as preparing an array that is
+  // already in the execution environment does not copy it again.
+  hexahedronBindings.ForEachCont(
+        dax::cont::dispatcher::CreateExecutionResources(count));
+  wedgeBindings.ForEachCont(
+        dax::cont::dispatcher::CreateExecutionResources(count));
+  tetrahedronBindings.ForEachCont(
+        dax::cont::dispatcher::CreateExecutionResources(count));
+
+  const typename HexahedronCells::MixedGridType &grid =
+      dax::internal::ParameterPackGetArgument<MixedGridIndex>(arguments);
+
+  typedef dax::exec::internal::FunctorMixedCell<
+      typename HexahedronCells::MixedGridType::ShapesType::PortalConstExecution,
+      typename HexahedronCells::FunctorType,
+      typename WedgeCells::FunctorType,
+      typename TetrahedronCells::FunctorType> MixedFunctorType;
+  MixedFunctorType bindingFunctor(
+        grid.GetShapes().PrepareForInput(),
+        typename HexahedronCells::FunctorType(worklet, hexahedronBindings),
+        typename WedgeCells::FunctorType(worklet, wedgeBindings),
+        typename TetrahedronCells::FunctorType(worklet, tetrahedronBindings));
+
+  dax::cont::DeviceAdapterAlgorithm< DeviceAdapterTag >::
+          Schedule(bindingFunctor,count);
+  }
+
 private:
   WorkletType Worklet;
+  bool Profiling;
+  mutable dax::cont::DispatcherProfile Profile;
 };
 
 } }  } //namespace dax::cont::dispatcher_internal
@@ -165,6 +343,8 @@ private:
     // (Check the type for WorkletType. It should match WorkletBaseType.)
     BOOST_MPL_ASSERT((Worklet_Should_Match_DispatcherType));
 
+    dax::cont::dispatcher::ProfileInvoke<DeviceAdapterTag>
+        profileInvoke(this->GetActiveProfile());
     static_cast<DerivedDispatcher*>(this)->DoInvoke(
       this->Worklet,
       dax::internal::make_ParameterPack( _dax_pp_args___(arguments) ) );
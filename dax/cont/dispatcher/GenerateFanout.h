@@ -0,0 +1,97 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_dispatcher_GenerateFanout_h
+#define __dax_cont_dispatcher_GenerateFanout_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayHandleImplicit.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/exec/internal/kernel/GenerateWorklets.h>
+
+namespace dax { namespace cont { namespace dispatcher {
+
+/// \brief The fixed fanout mode of the generate dispatchers
+///
+/// When every input cell generates the same number of outputs, output
+/// \c i comes from input cell <tt>i / countPerCell</tt> and is its visit
+/// <tt>i % countPerCell</tt>. GenerateFanout gives both maps as implicit
+/// arrays, so no scan of the counts, search or temporary arrays are needed.
+///
+template<class DeviceAdapterTag>
+class GenerateFanout
+{
+public:
+  typedef dax::cont::ArrayHandleImplicit<
+      dax::Id,
+      dax::exec::internal::kernel::FanoutInputCellFunctor,
+      DeviceAdapterTag> CellMapType;
+  typedef dax::cont::ArrayHandleImplicit<
+      dax::Id,
+      dax::exec::internal::kernel::FanoutVisitIndexFunctor,
+      DeviceAdapterTag> VisitIndexType;
+
+  DAX_CONT_EXPORT
+  GenerateFanout(dax::Id numberOfInputCells, dax::Id countPerCell)
+    : NumberOfInputCells(numberOfInputCells),
+      CountPerCell(countPerCell)
+  {
+    if (countPerCell < 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "The number of outputs per cell can not be negative.");
+      }
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfOutputs() const
+  {
+    return this->NumberOfInputCells * this->CountPerCell;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetCountPerCell() const { return this->CountPerCell; }
+
+  /// For each output, the input cell it is generated from.
+  ///
+  DAX_CONT_EXPORT
+  CellMapType GetCellMap() const
+  {
+    return CellMapType(
+          dax::exec::internal::kernel::FanoutInputCellFunctor(
+            this->CountPerCell),
+          this->GetNumberOfOutputs());
+  }
+
+  /// For each output, how many outputs its input cell generated before it.
+  ///
+  DAX_CONT_EXPORT
+  VisitIndexType GetVisitIndex() const
+  {
+    return VisitIndexType(
+          dax::exec::internal::kernel::FanoutVisitIndexFunctor(
+            this->CountPerCell),
+          this->GetNumberOfOutputs());
+  }
+
+private:
+  dax::Id NumberOfInputCells;
+  dax::Id CountPerCell;
+};
+
+} } } //dax::cont::dispatcher
+
+#endif //__dax_cont_dispatcher_GenerateFanout_h
@@ -0,0 +1,105 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_dispatcher_MixedCellInvocation_h
+#define __dax_cont_dispatcher_MixedCellInvocation_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/UnstructuredGridMixed.h>
+#include <dax/cont/internal/Bindings.h>
+#include <dax/exec/internal/Functor.h>
+#include <dax/internal/Invocation.h>
+#include <dax/internal/ParameterPack.h>
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/remove_const.hpp>
+
+namespace dax { namespace cont { namespace dispatcher {
+
+/// Determines whether a control argument is a
+/// dax::cont::UnstructuredGridMixed.
+///
+template<typename T>
+struct IsUnstructuredGridMixed : boost::false_type {  };
+
+template<class C, class P, class D>
+struct IsUnstructuredGridMixed< dax::cont::UnstructuredGridMixed<C,P,D> >
+    : boost::true_type {  };
+
+/// Finds the index of the first dax::cont::UnstructuredGridMixed in the
+/// arguments given to a dispatcher. \c INDEX is 0 when there is none.
+///
+template<typename ParameterPackType,
+         int N = ParameterPackType::NUM_PARAMETERS>
+struct FindMixedGridArgument
+{
+private:
+  typedef typename boost::remove_const<
+      typename ParameterPackType::template Parameter<N>::type>::type ArgType;
+  static const int REMAINING_INDEX =
+      FindMixedGridArgument<ParameterPackType, N-1>::INDEX;
+public:
+  static const int INDEX =
+      (REMAINING_INDEX == 0 && IsUnstructuredGridMixed<ArgType>::value)
+      ? N : REMAINING_INDEX;
+};
+
+template<typename ParameterPackType>
+struct FindMixedGridArgument<ParameterPackType, 0>
+{
+  static const int INDEX = 0;
+};
+
+/// Describes the invocation of a worklet on the cells of type \c CellTag of
+/// the mixed grid found at \c Index in the dispatcher arguments. The grid
+/// argument is replaced with a dax::cont::internal::UnstructuredGridMixedOfCell
+/// so that the bindings see a single cell type.
+///
+template<class CellTag,
+         typename WorkletType,
+         typename ParameterPackType,
+         int Index>
+struct MixedCellInvocation
+{
+  typedef typename boost::remove_const<
+      typename ParameterPackType::template Parameter<Index>::type>::type
+      MixedGridType;
+  typedef dax::cont::internal::UnstructuredGridMixedOfCell<
+      CellTag, MixedGridType> GridOfCellType;
+  typedef typename dax::internal::detail::PPackReplace<
+      GridOfCellType, Index, ParameterPackType>::type ParameterPackOfCellType;
+
+  typedef dax::internal::Invocation<WorkletType, ParameterPackOfCellType>
+      Invocation;
+  typedef typename dax::cont::internal::Bindings<Invocation>::type
+      BindingsType;
+  typedef dax::exec::internal::Functor<Invocation> FunctorType;
+
+  DAX_CONT_EXPORT
+  static BindingsType CreateBindings(const WorkletType &worklet,
+                                     const ParameterPackType &arguments)
+  {
+    const MixedGridType &grid =
+        dax::internal::ParameterPackGetArgument<Index>(arguments);
+    return dax::cont::internal::BindingsCreate(
+          worklet,
+          arguments.template Replace<Index>(GridOfCellType(grid)));
+  }
+};
+
+} } } //dax::cont::dispatcher
+
+#endif //__dax_cont_dispatcher_MixedCellInvocation_h
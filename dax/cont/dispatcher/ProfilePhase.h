@@ -0,0 +1,151 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_dispatcher_ProfilePhase_h
+#define __dax_cont_dispatcher_ProfilePhase_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/DispatcherProfile.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/Timer.h>
+
+#include <boost/smart_ptr/scoped_ptr.hpp>
+
+namespace dax { namespace cont { namespace dispatcher {
+
+/// \brief Times one phase of a dispatcher invoke.
+///
+/// The phase starts when this is constructed and is added to the profile
+/// by Stop, or when this is destroyed if Stop was not called. Given a NULL
+/// profile, which is what a dispatcher that is not profiling passes, it
+/// does nothing at all; in particular no timer is made, since making one
+/// synchronizes the device. The bytes the phase allocates are only
+/// counted when the MemoryTracker is already enabled; the phase does not
+/// turn it on, so profiling does not change the allocations it measures.
+///
+template<class DeviceAdapterTag>
+class ProfilePhase
+{
+public:
+  DAX_CONT_EXPORT
+  ProfilePhase(dax::cont::DispatcherProfile *profile,
+               const char *name,
+               dax::Id numberOfValues = 0)
+    : Profile(profile),
+      Name(name),
+      NumberOfValues(numberOfValues),
+      StartBytes(0),
+      TrackingMemory(false)
+  {
+    if (this->Profile == NULL) { return; }
+
+    this->TrackingMemory = dax::cont::MemoryTracker::IsEnabled();
+    if (this->TrackingMemory)
+      {
+      this->StartBytes =
+          dax::cont::MemoryTracker::GetStatistics().AllocatedBytes;
+      }
+    this->PhaseTimer.reset(new dax::cont::Timer<DeviceAdapterTag>());
+  }
+
+  DAX_CONT_EXPORT
+  ~ProfilePhase() { this->Stop(); }
+
+  /// Ends the phase and adds it to the profile. Later calls do nothing.
+  ///
+  DAX_CONT_EXPORT
+  void Stop()
+  {
+    if (this->Profile == NULL) { return; }
+
+    dax::cont::DispatcherProfile::Phase phase;
+    phase.Name = this->Name;
+    phase.Seconds = this->PhaseTimer->GetElapsedTime();
+    phase.NumberOfValues = this->NumberOfValues;
+    if (this->TrackingMemory && dax::cont::MemoryTracker::IsEnabled())
+      {
+      const std::size_t endBytes =
+          dax::cont::MemoryTracker::GetStatistics().AllocatedBytes;
+      // The tracker statistics may have been reset during the phase.
+      phase.BytesAllocated =
+          (endBytes > this->StartBytes) ? endBytes - this->StartBytes : 0;
+      }
+
+    dax::cont::DispatcherProfile *profile = this->Profile;
+    this->Profile = NULL;
+    this->PhaseTimer.reset();
+    profile->AddPhase(phase);
+  }
+
+  /// Same as Stop, recording the number of values the phase worked on when
+  /// it is only known at the end, such as the total of a scan.
+  ///
+  DAX_CONT_EXPORT
+  void Stop(dax::Id numberOfValues)
+  {
+    this->NumberOfValues = numberOfValues;
+    this->Stop();
+  }
+
+private:
+  ProfilePhase(const ProfilePhase &);  // Not implemented.
+  void operator=(const ProfilePhase &);  // Not implemented.
+
+  dax::cont::DispatcherProfile *Profile;
+  const char *Name;
+  dax::Id NumberOfValues;
+  std::size_t StartBytes;
+  bool TrackingMemory;
+  boost::scoped_ptr<dax::cont::Timer<DeviceAdapterTag> > PhaseTimer;
+};
+
+/// \brief Clears a dispatcher profile and times the whole invoke.
+///
+/// Like ProfilePhase, this makes no timer when given a NULL profile.
+///
+template<class DeviceAdapterTag>
+class ProfileInvoke
+{
+public:
+  DAX_CONT_EXPORT
+  explicit ProfileInvoke(dax::cont::DispatcherProfile *profile)
+    : Profile(profile)
+  {
+    if (this->Profile == NULL) { return; }
+
+    this->Profile->Clear();
+    this->InvokeTimer.reset(new dax::cont::Timer<DeviceAdapterTag>());
+  }
+
+  DAX_CONT_EXPORT
+  ~ProfileInvoke()
+  {
+    if (this->Profile == NULL) { return; }
+
+    this->Profile->SetInvokeSeconds(this->InvokeTimer->GetElapsedTime());
+  }
+
+private:
+  ProfileInvoke(const ProfileInvoke &);  // Not implemented.
+  void operator=(const ProfileInvoke &);  // Not implemented.
+
+  dax::cont::DispatcherProfile *Profile;
+  boost::scoped_ptr<dax::cont::Timer<DeviceAdapterTag> > InvokeTimer;
+};
+
+} } } //dax::cont::dispatcher
+
+#endif //__dax_cont_dispatcher_ProfilePhase_h
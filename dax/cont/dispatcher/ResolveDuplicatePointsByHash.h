@@ -0,0 +1,158 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_dispatcher_ResolveDuplicatePointsByHash_h
+#define __dax_cont_dispatcher_ResolveDuplicatePointsByHash_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/exec/internal/kernel/PointHashWorklets.h>
+
+namespace dax { namespace cont { namespace dispatcher {
+
+/// \brief Finds the unique interpolated points by a hash of their edge
+///
+/// Each point record gets a 64-bit key of its 32-bit hash and its index, so
+/// one sort of plain integers groups the records by hash, in index order
+/// within a group, which is cheaper than sorting whole records or sorting
+/// the hashes by key with the indices. The first key of each run of equal
+/// hashes is flagged, and each run finds the owners of its records, the
+/// equal record with the smallest index. The owners, in the order of the
+/// records, are copied to \c uniquePoints, and \c connections gets for
+/// each record the index of its owner in \c uniquePoints. So the output
+/// points keep the order in which the cells first use them. Every pass
+/// writes only to locations that belong to it, so the result does not
+/// depend on the device adapter.
+///
+/// \c hash maps a dax::PointAsEdgeInterpolation to a
+/// dax::internal::UInt32Type. Equal records must have equal hashes; records
+/// with colliding hashes are still told apart, by comparing each record of
+/// their run with the ones before it, so a hash with few values makes the
+/// runs long and slow. Throws dax::cont::ErrorControlBadValue when there
+/// are more records than the 32 bits of the key can index.
+///
+template<class DeviceAdapterTag,
+         class RecordsHandleType,
+         class HashFunctorType,
+         class UniqueHandleType,
+         class ConnectionsHandleType>
+DAX_CONT_EXPORT
+void ResolveDuplicatePointsByHash(const RecordsHandleType &records,
+                                  const HashFunctorType &hash,
+                                  UniqueHandleType &uniquePoints,
+                                  ConnectionsHandleType &connections)
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef dax::cont::ArrayHandle<dax::Id,
+      dax::cont::ArrayContainerControlTagBasic,
+      DeviceAdapterTag> IdArrayHandleType;
+  typedef dax::cont::ArrayHandle<dax::internal::UInt64Type,
+      dax::cont::ArrayContainerControlTagBasic,
+      DeviceAdapterTag> KeyArrayHandleType;
+  typedef typename RecordsHandleType::PortalConstExecution RecordsPortalType;
+  typedef typename IdArrayHandleType::PortalConstExecution IdPortalConstType;
+  typedef typename IdArrayHandleType::PortalExecution IdPortalType;
+  typedef typename KeyArrayHandleType::PortalConstExecution KeyPortalConstType;
+
+  const dax::Id numRecords = records.GetNumberOfValues();
+  if (numRecords == 0)
+    {
+    uniquePoints.PrepareForOutput(0);
+    connections.PrepareForOutput(0);
+    return;
+    }
+  if (static_cast<dax::internal::UInt64Type>(numRecords) > 0xFFFFFFFFu)
+    {
+    throw dax::cont::ErrorControlBadValue(
+          "Too many interpolated points to resolve duplicates by hash.");
+    }
+
+  KeyArrayHandleType keys;
+  dax::exec::internal::kernel::PointHashKeysFunctor<
+      RecordsPortalType, HashFunctorType,
+      typename KeyArrayHandleType::PortalExecution>
+      hashKeys(records.PrepareForInput(),
+               hash,
+               keys.PrepareForOutput(numRecords));
+  Algorithm::Schedule(hashKeys, numRecords);
+  Algorithm::Sort(keys);
+
+  IdArrayHandleType runStartFlags;
+  dax::exec::internal::kernel::PointHashRunStartFlagsFunctor<
+      KeyPortalConstType, IdPortalType>
+      flagRuns(keys.PrepareForInput(),
+               runStartFlags.PrepareForOutput(numRecords));
+  Algorithm::Schedule(flagRuns, numRecords);
+  IdArrayHandleType runStarts;
+  Algorithm::StreamCompact(runStartFlags, runStarts);
+  runStartFlags.ReleaseResources();
+
+  IdArrayHandleType owners;
+  dax::exec::internal::kernel::PointHashOwnersFunctor<
+      KeyPortalConstType, IdPortalConstType, RecordsPortalType, IdPortalType>
+      findOwners(keys.PrepareForInput(),
+                 runStarts.PrepareForInput(),
+                 records.PrepareForInput(),
+                 owners.PrepareForOutput(numRecords));
+  Algorithm::Schedule(findOwners, runStarts.GetNumberOfValues());
+  keys.ReleaseResources();
+  runStarts.ReleaseResources();
+
+  //the records that own themselves are the output points, numbered in the
+  //order of the records
+  IdArrayHandleType pointIds;
+  dax::exec::internal::kernel::PointHashOwnerFlagsFunctor<
+      IdPortalConstType, IdPortalType>
+      ownerFlags(owners.PrepareForInput(),
+                 pointIds.PrepareForOutput(numRecords));
+  Algorithm::Schedule(ownerFlags, numRecords);
+  Algorithm::StreamCompact(records, pointIds, uniquePoints);
+  Algorithm::ScanExclusive(pointIds, pointIds);
+
+  dax::exec::internal::kernel::PointHashConnectionsFunctor<
+      IdPortalConstType, IdPortalConstType,
+      typename ConnectionsHandleType::PortalExecution>
+      connect(owners.PrepareForInput(),
+              pointIds.PrepareForInput(),
+              connections.PrepareForOutput(numRecords));
+  Algorithm::Schedule(connect, numRecords);
+}
+
+/// Finds the unique interpolated points with the default hash of their
+/// edge, dax::exec::internal::kernel::PointHashFunctor.
+///
+template<class DeviceAdapterTag,
+         class RecordsHandleType,
+         class UniqueHandleType,
+         class ConnectionsHandleType>
+DAX_CONT_EXPORT
+void ResolveDuplicatePointsByHash(const RecordsHandleType &records,
+                                  UniqueHandleType &uniquePoints,
+                                  ConnectionsHandleType &connections)
+{
+  dax::cont::dispatcher::ResolveDuplicatePointsByHash<DeviceAdapterTag>(
+        records,
+        dax::exec::internal::kernel::PointHashFunctor(),
+        uniquePoints,
+        connections);
+}
+
+} } } //dax::cont::dispatcher
+
+#endif //__dax_cont_dispatcher_ResolveDuplicatePointsByHash_h
@@ -149,6 +149,32 @@ void AddVisitIndex()
   DAX_TEST_ASSERT((visitIndices[5]==3),"Incorrect VisIndex value at pos: 5");
   DAX_TEST_ASSERT((visitIndices[6]==0),"Incorrect VisIndex value at pos: 6");
 
+  //runs of every length, including ones that start and end the cell map,
+  //like the cell map of a generate with a high output to input ratio
+  std::vector<dax::Id> long_runs;
+  for (dax::Id cell = 0; cell < 40; cell++)
+    {
+    for (dax::Id visit = 0; visit < (cell*7)%40 + 1; visit++)
+      {
+      long_runs.push_back(cell);
+      }
+    }
+  IdHandleType longRuns = dax::cont::make_ArrayHandle(long_runs);
+  addIndex(longRuns,result);
+  DAX_TEST_ASSERT(result.GetNumberOfValues() ==
+                  static_cast<dax::Id>(long_runs.size()),
+                  "Wrong number of visit indices");
+
+  std::vector<dax::Id> longVisitIndices(long_runs.size());
+  result.CopyInto(longVisitIndices.begin());
+  dax::Id expected = 0;
+  for (std::size_t i = 0; i < long_runs.size(); i++)
+    {
+    expected = (i > 0 && long_runs[i-1] == long_runs[i]) ? expected + 1 : 0;
+    DAX_TEST_ASSERT(longVisitIndices[i] == expected,
+                    "Incorrect VisIndex value for long runs");
+    }
+
 }
 
 }
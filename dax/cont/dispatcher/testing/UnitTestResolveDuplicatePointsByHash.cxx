@@ -0,0 +1,145 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/dispatcher/ResolveDuplicatePointsByHash.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/internal/EdgeInterpolatedGrid.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace{
+
+typedef dax::cont::ArrayHandle<dax::PointAsEdgeInterpolation> RecordsHandleType;
+typedef dax::cont::ArrayHandle<dax::Id> IdHandleType;
+
+//A hash with few values, so that many different edges collide.
+struct CollidingHash
+{
+  dax::internal::UInt32Type NumberOfHashes;
+
+  CollidingHash(dax::internal::UInt32Type numberOfHashes)
+    : NumberOfHashes(numberOfHashes) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::internal::UInt32Type operator()(
+      const dax::PointAsEdgeInterpolation &point) const
+  {
+    return static_cast<dax::internal::UInt32Type>(
+          point.EdgeIdFirst + point.EdgeIdSecond) % this->NumberOfHashes;
+  }
+};
+
+//Points on 300 edges, most of them used several times, in a scrambled order.
+std::vector<dax::PointAsEdgeInterpolation> MakeRecords()
+{
+  std::vector<dax::PointAsEdgeInterpolation> records;
+  for (dax::Id use = 0; use < 4; use++)
+    {
+    for (dax::Id edge = 0; edge < 300; edge += (use+1))
+      {
+      const dax::Id scrambled = (edge*97 + use*13) % 300;
+      records.push_back(dax::PointAsEdgeInterpolation(
+                          scrambled, scrambled + 1 + scrambled%7, 0.5f));
+      }
+    }
+  return records;
+}
+
+template<class HashFunctorType>
+void CheckResolve(const std::vector<dax::PointAsEdgeInterpolation> &records,
+                  const HashFunctorType &hash)
+{
+  //the expected unique points are the distinct records in the order they
+  //are first used
+  std::vector<dax::PointAsEdgeInterpolation> expectedUnique;
+  std::vector<dax::Id> expectedConnections;
+  for (std::size_t i = 0; i < records.size(); i++)
+    {
+    const dax::Id found = static_cast<dax::Id>(
+          std::find(expectedUnique.begin(), expectedUnique.end(), records[i])
+          - expectedUnique.begin());
+    if (found == static_cast<dax::Id>(expectedUnique.size()))
+      {
+      expectedUnique.push_back(records[i]);
+      }
+    expectedConnections.push_back(found);
+    }
+
+  RecordsHandleType recordsHandle = dax::cont::make_ArrayHandle(records);
+  RecordsHandleType uniquePoints;
+  IdHandleType connections;
+  dax::cont::dispatcher::ResolveDuplicatePointsByHash<
+      DAX_DEFAULT_DEVICE_ADAPTER_TAG>(recordsHandle, hash,
+                                      uniquePoints, connections);
+
+  DAX_TEST_ASSERT(uniquePoints.GetNumberOfValues() ==
+                  static_cast<dax::Id>(expectedUnique.size()),
+                  "Wrong number of unique points.");
+  for (std::size_t i = 0; i < expectedUnique.size(); i++)
+    {
+    DAX_TEST_ASSERT(uniquePoints.GetPortalConstControl().Get(i) ==
+                    expectedUnique[i],
+                    "Unique points not in the order of first use.");
+    }
+
+  DAX_TEST_ASSERT(connections.GetNumberOfValues() ==
+                  static_cast<dax::Id>(records.size()),
+                  "Wrong number of connections.");
+  for (std::size_t i = 0; i < records.size(); i++)
+    {
+    DAX_TEST_ASSERT(connections.GetPortalConstControl().Get(i) ==
+                    expectedConnections[i],
+                    "Record connected to the wrong point.");
+    }
+}
+
+void TestResolveDuplicatePointsByHash()
+{
+  const std::vector<dax::PointAsEdgeInterpolation> records = MakeRecords();
+
+  std::cout << "Default hash." << std::endl;
+  CheckResolve(records, dax::exec::internal::kernel::PointHashFunctor());
+
+  std::cout << "Hashes colliding in runs of many edges." << std::endl;
+  CheckResolve(records, CollidingHash(7));
+
+  std::cout << "Every hash colliding." << std::endl;
+  CheckResolve(records, CollidingHash(1));
+
+  std::cout << "No records." << std::endl;
+  RecordsHandleType noRecords;
+  noRecords.PrepareForOutput(0);
+  RecordsHandleType uniquePoints;
+  IdHandleType connections;
+  dax::cont::dispatcher::ResolveDuplicatePointsByHash<
+      DAX_DEFAULT_DEVICE_ADAPTER_TAG>(noRecords, uniquePoints, connections);
+  DAX_TEST_ASSERT(uniquePoints.GetNumberOfValues() == 0,
+                  "No records should give no points.");
+  DAX_TEST_ASSERT(connections.GetNumberOfValues() == 0,
+                  "No records should give no connections.");
+}
+
+}
+
+int UnitTestResolveDuplicatePointsByHash(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestResolveDuplicatePointsByHash);
+}
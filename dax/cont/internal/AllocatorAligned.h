@@ -0,0 +1,135 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_AllocatorAligned_h
+#define __dax_cont_internal_AllocatorAligned_h
+
+#include <dax/Types.h>
+
+#include <cstddef>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#include <sys/mman.h>
+#endif
+
+/// The alignment, in bytes, of every array allocated by \c
+/// AllocatorAligned. The default is the size of a cache line on current x86
+/// and ARM processors so that no value straddles two lines and vector loads
+/// of the first values are aligned.
+///
+#ifndef DAX_ALLOCATOR_ALIGNMENT
+#define DAX_ALLOCATOR_ALIGNMENT 64
+#endif
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// The part of \c AllocatorAligned that does not depend on the value type.
+///
+class AllocatorAlignedBase
+{
+public:
+  /// The size of a transparent huge page on x86-64 Linux.
+  static const std::size_t HUGE_PAGE_SIZE = 2*1024*1024;
+
+protected:
+  /// Allocates \c bytes bytes. When \c hugePages is true and the allocation
+  /// is at least \c HUGE_PAGE_SIZE bytes, it is huge page aligned and padded.
+  /// Throws \c std::bad_alloc on failure.
+  ///
+  DAX_CONT_EXPORT static void *AllocateBytes(std::size_t bytes,
+                                             bool hugePages)
+  {
+    std::size_t alignment = DAX_ALLOCATOR_ALIGNMENT;
+    bool useHugePages = false;
+    if (hugePages && (bytes >= HUGE_PAGE_SIZE))
+      {
+      alignment = HUGE_PAGE_SIZE;
+      bytes = ((bytes + HUGE_PAGE_SIZE - 1)/HUGE_PAGE_SIZE)*HUGE_PAGE_SIZE;
+      useHugePages = true;
+      }
+
+    void *memory;
+#ifdef _WIN32
+    memory = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&memory, alignment, bytes) != 0) { memory = NULL; }
+#endif
+    if (memory == NULL) { throw std::bad_alloc(); }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // This is only a hint. If the kernel has transparent huge pages disabled
+    // the memory is simply backed by regular pages.
+    if (useHugePages) { madvise(memory, bytes, MADV_HUGEPAGE); }
+#else
+    (void)useHugePages;
+#endif
+
+    return memory;
+  }
+
+  DAX_CONT_EXPORT static void DeallocateBytes(void *memory)
+  {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+  }
+};
+
+/// \brief An allocator returning cache-line aligned memory.
+///
+/// \c AllocatorAligned has the allocate/deallocate interface of \c
+/// std::allocator but returns memory aligned to \c DAX_ALLOCATOR_ALIGNMENT
+/// bytes. Like \c std::allocator, it does not construct the values.
+///
+/// When \c UseHugePages is true, allocations of at least \c HUGE_PAGE_SIZE
+/// bytes are aligned to and padded out to whole huge pages, and on Linux the
+/// kernel is asked to back them with transparent huge pages (\c
+/// madvise(MADV_HUGEPAGE)). This reduces TLB misses for random access into
+/// large arrays, such as the gathers done through permutation arrays.
+///
+template<typename T, bool UseHugePages = false>
+class AllocatorAligned : public AllocatorAlignedBase
+{
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef std::size_t size_type;
+
+  DAX_CONT_EXPORT pointer allocate(size_type numberOfValues)
+  {
+    return static_cast<pointer>(
+          AllocateBytes(numberOfValues*sizeof(value_type), UseHugePages));
+  }
+
+  DAX_CONT_EXPORT void deallocate(pointer array, size_type)
+  {
+    DeallocateBytes(array);
+  }
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_AllocatorAligned_h
@@ -0,0 +1,365 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ArrayContainerControlCartesianProduct_h
+#define __dax_cont_internal_ArrayContainerControlCartesianProduct_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief An array portal of the cartesian product of three axis portals.
+///
+/// The value at a flat index is the \c dax::Vector3 made from the x, y, and z
+/// axis values at the i, j, and k location of that index, with i varying
+/// fastest. This is the point ordering of a structured grid, so three 1-D
+/// arrays of lengths nx, ny, and nz implicitly define the nx*ny*nz point
+/// coordinates of a rectilinear grid.
+///
+template <class AxisPortalType_>
+class ArrayPortalCartesianProduct
+{
+public:
+  typedef AxisPortalType_ AxisPortalType;
+  typedef dax::Vector3 ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCartesianProduct()
+    : XAxis(), YAxis(), ZAxis(), XDim(0), XYDim(0), NumberOfValues(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCartesianProduct(const AxisPortalType &xAxis,
+                              const AxisPortalType &yAxis,
+                              const AxisPortalType &zAxis)
+    : XAxis(xAxis), YAxis(yAxis), ZAxis(zAxis),
+      XDim(xAxis.GetNumberOfValues()),
+      XYDim(xAxis.GetNumberOfValues()*yAxis.GetNumberOfValues()),
+      NumberOfValues(xAxis.GetNumberOfValues()*yAxis.GetNumberOfValues()
+                     *zAxis.GetNumberOfValues())
+  {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->Get(dax::make_Id3(index % this->XDim,
+                                   (index / this->XDim)
+                                   % this->YAxis.GetNumberOfValues(),
+                                   index / this->XYDim));
+  }
+
+  /// Returns the value at the given i, j, k location (relative to the start
+  /// of each axis) without having to convert from a flat index.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(const dax::Id3 &ijk) const {
+    return dax::make_Vector3(this->XAxis.Get(ijk[0]),
+                             this->YAxis.Get(ijk[1]),
+                             this->ZAxis.Get(ijk[2]));
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalCartesianProduct<AxisPortalType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetXAxis() const { return this->XAxis; }
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetYAxis() const { return this->YAxis; }
+  DAX_EXEC_CONT_EXPORT
+  const AxisPortalType &GetZAxis() const { return this->ZAxis; }
+
+private:
+  AxisPortalType XAxis;
+  AxisPortalType YAxis;
+  AxisPortalType ZAxis;
+  dax::Id XDim;
+  dax::Id XYDim;
+  dax::Id NumberOfValues;
+};
+
+//simple container for the three axis array handles so we can get them
+//inside the array transfer class. It can also be used in the control
+//environment, where it combines the axis values on each Get.
+template<class AxisHandleType>
+struct ArrayPortalConstCartesianProduct
+{
+  typedef dax::Vector3 ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConstCartesianProduct<AxisHandleType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstCartesianProduct() : XAxis(), YAxis(), ZAxis() { }
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstCartesianProduct(AxisHandleType xAxis,
+                                   AxisHandleType yAxis,
+                                   AxisHandleType zAxis)
+    : XAxis(xAxis), YAxis(yAxis), ZAxis(zAxis) { }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->XAxis.GetNumberOfValues() * this->YAxis.GetNumberOfValues()
+        * this->ZAxis.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    const dax::Id xDim = this->XAxis.GetNumberOfValues();
+    const dax::Id yDim = this->YAxis.GetNumberOfValues();
+    return dax::make_Vector3(
+          this->XAxis.GetPortalConstControl().Get(index % xDim),
+          this->YAxis.GetPortalConstControl().Get((index / xDim) % yDim),
+          this->ZAxis.GetPortalConstControl().Get(index / (xDim*yDim)));
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  AxisHandleType XAxis;
+  AxisHandleType YAxis;
+  AxisHandleType ZAxis;
+};
+
+template<class AxisHandleType>
+struct ArrayContainerControlTagCartesianProduct { };
+
+/// This helper struct defines the types for a cartesian product container
+/// of the given axis array handle type.
+///
+template<class AxisHandleType>
+struct ArrayContainerControlCartesianProductTypes {
+  /// The product of three axes is always a 3-vector.
+  ///
+  typedef dax::Vector3 ValueType;
+
+  /// The full type of the internal ArrayContainerControl specialization.
+  ///
+  typedef ArrayContainerControl<
+    ValueType, ArrayContainerControlTagCartesianProduct<AxisHandleType> >
+      ArrayContainerControlType;
+
+  /// The appropriately templated tag.
+  ///
+  typedef ArrayContainerControlTagCartesianProduct<AxisHandleType>
+      ArrayContainerControlTag;
+
+  /// The portal types used with the cartesian product container.
+  ///
+  typedef dax::cont::internal::ArrayPortalConstCartesianProduct<
+      AxisHandleType> PortalControl;
+
+  typedef PortalControl PortalConstControl;
+};
+
+/// The cartesian product container is read-only and, like the implicit
+/// container, holds no data of its own. The axis handles are given to the
+/// ArrayHandle as its user portal.
+///
+template<class AxisHandleType>
+class ArrayContainerControl<
+    dax::Vector3,
+    ArrayContainerControlTagCartesianProduct<AxisHandleType> >
+{
+private:
+  typedef ArrayContainerControlCartesianProductTypes<AxisHandleType>
+      ProductTypes;
+
+public:
+  typedef typename ProductTypes::ValueType ValueType;
+
+  typedef typename ProductTypes::PortalControl PortalType;
+  typedef typename ProductTypes::PortalConstControl PortalConstType;
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product container does not store array portal.  "
+          "Perhaps you did not set the ArrayPortal when "
+          "constructing the ArrayHandle.");
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product container does not store array portal.  "
+          "Perhaps you did not set the ArrayPortal when "
+          "constructing the ArrayHandle.");
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.");
+  }
+};
+
+template<typename T, class AxisHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    T, ArrayContainerControlTagCartesianProduct<AxisHandleType>, DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+template<class AxisHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    dax::Vector3,
+    ArrayContainerControlTagCartesianProduct<AxisHandleType>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControlCartesianProductTypes<AxisHandleType>
+      ProductTypes;
+  typedef typename ProductTypes::ArrayContainerControlType ContainerType;
+
+public:
+  typedef typename ProductTypes::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalCartesianProduct<
+      typename AxisHandleType::PortalConstExecution> PortalConstExecution;
+  typedef PortalConstExecution PortalExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() : PortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->PortalValid);
+    return this->Portal.GetNumberOfValues();
+  }
+
+  /// Only the three axis arrays are moved to the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl portal) {
+    this->Axes = portal;
+    this->Portal = PortalConstExecution(this->Axes.XAxis.PrepareForInput(),
+                                        this->Axes.YAxis.PrepareForInput(),
+                                        this->Axes.ZAxis.PrepareForInput());
+    this->PortalValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl daxNotUsed(portal)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output or in place.");
+  }
+
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &daxNotUsed(controlArray),
+                              dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output.");
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData(ContainerType &daxNotUsed(controlArray)) const {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be used for output.");
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->PortalValid);
+    std::copy(this->Axes.GetIteratorBegin(),
+              this->Axes.GetIteratorEnd(),
+              dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays cannot be resized.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    throw dax::cont::ErrorControlBadValue(
+          "Cartesian product arrays are read-only.  (Get the const portal.)");
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->PortalValid);
+    return this->Portal;
+  }
+
+  //The axis handles manage their own execution resources.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  bool PortalValid;
+  PortalConstControl Axes;
+  PortalConstExecution Portal;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ArrayContainerControlCartesianProduct_h
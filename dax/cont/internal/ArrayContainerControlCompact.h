@@ -0,0 +1,399 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ArrayContainerControlCompact_h
+#define __dax_cont_internal_ArrayContainerControlCompact_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlInternal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief An array portal that decodes values from a compact storage portal.
+///
+/// Each value is stored in the delegate portal in the form given by the
+/// codec (for example a 16-bit half float) and is decoded to the codec's
+/// \c ValueType (for example \c dax::Scalar) on \c Get and encoded on
+/// \c Set.
+///
+template <class StoragePortalType_, class CodecType_>
+class ArrayPortalCompact
+{
+public:
+  typedef StoragePortalType_ StoragePortalType;
+  typedef CodecType_ CodecType;
+  typedef typename CodecType::ValueType ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompact() : StoragePortal(), Codec() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompact(const StoragePortalType &storagePortal,
+                     const CodecType &codec)
+    : StoragePortal(storagePortal), Codec(codec) {  }
+
+  /// Copy constructor for any other ArrayPortalCompact with a storage portal
+  /// type that can be copied to this storage portal type. This allows us to
+  /// do any type casting that the storage portals do (like the non-const to
+  /// const cast).
+  ///
+  template<class OtherP>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalCompact(const ArrayPortalCompact<OtherP,CodecType> &src)
+    : StoragePortal(src.GetStoragePortal()), Codec(src.GetCodec()) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->StoragePortal.GetNumberOfValues();
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->Codec.Decode(this->StoragePortal.Get(index));
+  }
+
+  DAX_EXEC_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    this->StoragePortal.Set(index, this->Codec.Encode(value));
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalCompact<StoragePortalType,CodecType> > IteratorType;
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const StoragePortalType &GetStoragePortal() const {
+    return this->StoragePortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const CodecType &GetCodec() const { return this->Codec; }
+
+private:
+  StoragePortalType StoragePortal;
+  CodecType Codec;
+};
+
+//simple container for the storage array handle and the codec so we can get
+//them inside the array transfer class. It can also be used in the control
+//environment, where it decodes and encodes each value through the storage
+//handle.
+template<class StorageHandleType, class CodecType>
+struct ArrayPortalConstCompact
+{
+  typedef typename CodecType::ValueType ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConstCompact<StorageHandleType,CodecType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstCompact() : Array(), Codec() { }
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstCompact(StorageHandleType handle, CodecType codec)
+    : Array(handle), Codec(codec) { }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->Array.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->Codec.Decode(this->Array.GetPortalConstControl().Get(index));
+  }
+
+  DAX_CONT_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    StorageHandleType array = this->Array;
+    array.GetPortalControl().Set(index, this->Codec.Encode(value));
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  StorageHandleType Array;
+  CodecType Codec;
+};
+
+
+template<class StorageHandleType, class CodecType>
+struct ArrayContainerControlTagCompact { };
+
+/// This helper struct defines the types for a compact container holding the
+/// given storage array handle and codec.
+///
+template<class StorageHandleType, class CodecType>
+struct ArrayContainerControlCompactTypes {
+  /// Compact arrays decode to the value type of their codec.
+  ///
+  typedef typename CodecType::ValueType ValueType;
+
+  /// The full type of the internal ArrayContainerControl specialization.
+  ///
+  typedef ArrayContainerControl<
+    ValueType, ArrayContainerControlTagCompact<StorageHandleType,CodecType> >
+      ArrayContainerControlType;
+
+  /// The appropriately templated tag.
+  ///
+  typedef ArrayContainerControlTagCompact<StorageHandleType,CodecType>
+      ArrayContainerControlTag;
+
+  /// The portal types used with the compact container.
+  ///
+  typedef dax::cont::internal::ArrayPortalConstCompact<
+      StorageHandleType,CodecType> PortalControl;
+
+  typedef PortalControl PortalConstControl;
+};
+
+template<typename T, class StorageHandleType, class CodecType>
+class ArrayContainerControl<
+    T,
+    ArrayContainerControlTagCompact<StorageHandleType,CodecType> >
+{
+  BOOST_STATIC_ASSERT((boost::is_same<T,typename CodecType::ValueType>::value));
+
+private:
+  typedef ArrayContainerControlCompactTypes<StorageHandleType,CodecType>
+      CompactTypes;
+
+public:
+  typedef typename CompactTypes::ValueType ValueType;
+
+  typedef typename CompactTypes::PortalControl PortalType;
+  typedef typename CompactTypes::PortalConstControl PortalConstType;
+
+public:
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Portal() {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(StorageHandleType handle, CodecType codec)
+    : Portal(handle,codec) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    return this->Portal;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->Portal.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlInternal(
+      "The allocate method for the compact control array container should "
+      "never have been called. The allocate is generally only called by "
+      "the execution array manager, and the array transfer for the compact "
+      "container should prevent the execution array manager from being "
+      "directly used.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    this->Portal.Array.Shrink(numberOfValues);
+  }
+
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    this->Portal.Array.ReleaseResources();
+  }
+
+private:
+  PortalType Portal;
+};
+
+template<typename T,
+         class StorageHandleType,
+         class CodecType,
+         class DeviceAdapter>
+class ArrayTransfer<
+    T,
+    ArrayContainerControlTagCompact<StorageHandleType,CodecType>,
+    DeviceAdapter>
+{
+  BOOST_STATIC_ASSERT((boost::is_same<T,typename CodecType::ValueType>::value));
+
+private:
+  typedef ArrayContainerControlCompactTypes<StorageHandleType,CodecType>
+      CompactTypes;
+  typedef typename CompactTypes::ArrayContainerControlType ContainerType;
+
+public:
+  typedef typename CompactTypes::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalCompact<
+      typename StorageHandleType::PortalExecution,CodecType> PortalExecution;
+  typedef ArrayPortalCompact<
+      typename StorageHandleType::PortalConstExecution,CodecType>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() :
+    ExecutionPortalConstValid(false),
+    ExecutionPortalValid(false) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->Array.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl portal) {
+    this->Array = portal.Array;
+    this->Codec = portal.Codec;
+
+    this->ExecutionPortalConst = PortalConstExecution(
+                                   this->Array.PrepareForInput(),
+                                   this->Codec);
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl portal) {
+    this->Array = portal.Array;
+    this->Codec = portal.Codec;
+
+    this->ExecutionPortal = PortalExecution(this->Array.PrepareForInPlace(),
+                                            this->Codec);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  /// Output allocates the storage array, so only the compact values are
+  /// moved to and from the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &controlArray,
+                              dax::Id numberOfValues) {
+    PortalControl portal = controlArray.GetPortal();
+    this->Array = portal.Array;
+    this->Codec = portal.Codec;
+
+    this->ExecutionPortal = PortalExecution(
+                              this->Array.PrepareForOutput(numberOfValues),
+                              this->Codec);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalValid = true;
+    this->ExecutionPortalConstValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData( ContainerType & daxNotUsed(controlArray) ) const {
+    // Nothing to do. The output was written directly into the storage
+    // handle, which manages getting it back to the control environment.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    typedef typename StorageHandleType::PortalConstControl StoragePortalType;
+    StoragePortalType portal = this->Array.GetPortalConstControl();
+    const dax::Id numberOfValues = portal.GetNumberOfValues();
+    for (dax::Id index = 0; index < numberOfValues; index++, dest++)
+      {
+      *dest = this->Codec.Decode(portal.Get(index));
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    this->Array.Shrink(numberOfValues);
+    // The storage array is still valid in the execution environment, so
+    // getting its portals again does not move any data.
+    if (this->ExecutionPortalValid)
+      {
+      this->ExecutionPortal = PortalExecution(this->Array.PrepareForInPlace(),
+                                              this->Codec);
+      this->ExecutionPortalConst = this->ExecutionPortal;
+      }
+    else if (this->ExecutionPortalConstValid)
+      {
+      this->ExecutionPortalConst = PortalConstExecution(
+                                     this->Array.PrepareForInput(),
+                                     this->Codec);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  //The storage handle manages its own execution resources (and may be the
+  //only place the data lives), so do not release them from underneath it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  bool ExecutionPortalConstValid;
+  bool ExecutionPortalValid;
+
+  StorageHandleType Array;
+  CodecType Codec;
+  PortalExecution ExecutionPortal;
+  PortalConstExecution ExecutionPortalConst;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ArrayContainerControlCompact_h
@@ -0,0 +1,498 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ArrayContainerControlConcatenate_h
+#define __dax_cont_internal_ArrayContainerControlConcatenate_h
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlInternal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief An array portal that appends the second array portal to the end of
+/// the first array portal.
+///
+/// Indices less than the length of the first portal refer to the first
+/// portal, all others refer to the second portal. No data is copied.
+///
+template <class P1, class P2>
+class ArrayPortalConcatenate
+{
+public:
+  typedef P1 FirstPortalType;
+  typedef P2 SecondPortalType;
+  typedef typename FirstPortalType::ValueType ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalConcatenate() :
+    FirstPortal(),
+    SecondPortal(),
+    NumberOfValues(0)
+    { }
+
+  DAX_CONT_EXPORT
+  ArrayPortalConcatenate(const FirstPortalType &firstPortal,
+                         const SecondPortalType &secondPortal) :
+    FirstPortal(firstPortal),
+    SecondPortal(secondPortal),
+    NumberOfValues(firstPortal.GetNumberOfValues()
+                   + secondPortal.GetNumberOfValues())
+    {  }
+
+  /// Copy constructor for any other ArrayPortalConcatenate with portal types
+  /// that can be copied to these portal types. This allows us to do any type
+  /// casting that the portals do (like the non-const to const cast).
+  ///
+  template<class OtherP1, class OtherP2>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalConcatenate(const ArrayPortalConcatenate<OtherP1,OtherP2> &src)
+    : FirstPortal(src.GetFirstPortal()),
+      SecondPortal(src.GetSecondPortal()),
+      NumberOfValues(src.GetNumberOfValues())
+  {  }
+
+  template<class OtherP1, class OtherP2>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalConcatenate<P1,P2> &operator=(
+      const ArrayPortalConcatenate<OtherP1,OtherP2> &src)
+  {
+    this->FirstPortal = src.GetFirstPortal();
+    this->SecondPortal = src.GetSecondPortal();
+    this->NumberOfValues = src.GetNumberOfValues();
+    return *this;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Get(dax::Id index) const {
+    const dax::Id firstSize = this->FirstPortal.GetNumberOfValues();
+    return (index < firstSize) ? this->FirstPortal.Get(index)
+                               : this->SecondPortal.Get(index - firstSize);
+  }
+
+  DAX_EXEC_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    const dax::Id firstSize = this->FirstPortal.GetNumberOfValues();
+    if (index < firstSize)
+      {
+      this->FirstPortal.Set(index, value);
+      }
+    else
+      {
+      this->SecondPortal.Set(index - firstSize, value);
+      }
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConcatenate<FirstPortalType,SecondPortalType> > IteratorType;
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const FirstPortalType &GetFirstPortal() const { return this->FirstPortal; }
+  DAX_EXEC_CONT_EXPORT
+  const SecondPortalType &GetSecondPortal() const { return this->SecondPortal; }
+
+  /// Shortens the concatenation without touching either delegate portal.
+  ///
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->NumberOfValues);
+    this->NumberOfValues = numberOfValues;
+  }
+
+private:
+  FirstPortalType FirstPortal;
+  SecondPortalType SecondPortal;
+  dax::Id NumberOfValues;
+};
+
+//simple container for the two array handles
+//so we can get them inside the array transfer class. It can also be read
+//in the control environment, which looks up each value in the handles.
+template<class Handle1Type, class Handle2Type>
+struct ArrayPortalConstConcatenate
+{
+  typedef typename Handle1Type::ValueType ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConstConcatenate<Handle1Type,Handle2Type> > IteratorType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstConcatenate():
+  FirstArray(),
+  SecondArray(),
+  NumberOfValues(0)
+  { }
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstConcatenate(Handle1Type handle1, Handle2Type handle2):
+  FirstArray(handle1),
+  SecondArray(handle2),
+  NumberOfValues(handle1.GetNumberOfValues() + handle2.GetNumberOfValues())
+  { }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    const dax::Id firstSize = this->FirstArray.GetNumberOfValues();
+    return (index < firstSize)
+        ? this->FirstArray.GetPortalConstControl().Get(index)
+        : this->SecondArray.GetPortalConstControl().Get(index - firstSize);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  Handle1Type FirstArray;
+  Handle2Type SecondArray;
+  dax::Id NumberOfValues;
+};
+
+
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+struct ArrayContainerControlTagConcatenate { };
+
+/// This helper struct defines the value type for a concatenate container
+/// containing the given two array handles.
+///
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+struct ArrayContainerControlConcatenateTypes {
+  /// The ValueType, which is what ever the first array holds. The second
+  /// array is expected to hold the same type.
+  ///
+  typedef typename FirstArrayHandleType::ValueType ValueType;
+
+  /// The full type of the internal ArrayContainerControl specialization.
+  ///
+  typedef ArrayContainerControl<
+    ValueType,
+    ArrayContainerControlTagConcatenate<FirstArrayHandleType,
+                                        SecondArrayHandleType> >
+      ArrayContainerControlType;
+
+  /// The appropriately templated tag.
+  ///
+  typedef ArrayContainerControlTagConcatenate<
+      FirstArrayHandleType,SecondArrayHandleType> ArrayContainerControlTag;
+
+  /// The portal types used with the concatenate container.
+  ///
+  typedef dax::cont::internal::ArrayPortalConstConcatenate<
+      FirstArrayHandleType,
+      SecondArrayHandleType> PortalControl;
+
+  typedef PortalControl PortalConstControl;
+};
+
+template<class FirstArrayHandleType, class SecondArrayHandleType>
+class ArrayContainerControl<
+    typename FirstArrayHandleType::ValueType,
+    ArrayContainerControlTagConcatenate<FirstArrayHandleType,
+                                        SecondArrayHandleType> >
+{
+private:
+  typedef ArrayContainerControlConcatenateTypes<
+      FirstArrayHandleType,SecondArrayHandleType> ConcatenateTypes;
+
+public:
+  typedef typename ConcatenateTypes::ValueType ValueType;
+
+  typedef typename ConcatenateTypes::PortalControl PortalType;
+  typedef typename ConcatenateTypes::PortalConstControl PortalConstType;
+
+public:
+  DAX_CONT_EXPORT
+  ArrayContainerControl():
+  Portal()
+  {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(FirstArrayHandleType first,
+                        SecondArrayHandleType second):
+  Portal(first,second)
+  {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    return Portal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    return Portal;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return Portal.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlInternal(
+      "The allocate method for the concatenate control array container "
+      "should never have been called. The allocate is generally only called "
+      "by the execution array manager, and the array transfer for the "
+      "concatenate container should prevent the execution array manager from "
+      "being directly used.");
+  }
+
+  /// Shrinking a concatenation only shortens the range it covers. The
+  /// delegate arrays are left untouched.
+  ///
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->Portal.NumberOfValues);
+    this->Portal.NumberOfValues = numberOfValues;
+  }
+
+  //We don't own the memory, the handles do, so don't deallocate
+  //underneath of them.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  PortalType Portal;
+};
+
+template<typename T,
+         class FirstArrayHandleType,
+         class SecondArrayHandleType,
+         class DeviceAdapter>
+class ArrayTransfer<
+    T,
+    ArrayContainerControlTagConcatenate<FirstArrayHandleType,
+                                        SecondArrayHandleType>,
+    DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+template<class FirstArrayHandleType,
+         class SecondArrayHandleType,
+         class DeviceAdapter>
+class ArrayTransfer<
+    typename ArrayContainerControlConcatenateTypes<
+        FirstArrayHandleType,SecondArrayHandleType>::ValueType,
+    ArrayContainerControlTagConcatenate<FirstArrayHandleType,
+                                        SecondArrayHandleType>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControlConcatenateTypes<
+      FirstArrayHandleType,SecondArrayHandleType> ConcatenateTypes;
+  typedef typename ConcatenateTypes::ArrayContainerControlType ContainerType;
+
+public:
+  typedef typename ConcatenateTypes::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalConcatenate<
+    typename FirstArrayHandleType::PortalExecution,
+    typename SecondArrayHandleType::PortalExecution> PortalExecution;
+  typedef ArrayPortalConcatenate<
+    typename FirstArrayHandleType::PortalConstExecution,
+    typename SecondArrayHandleType::PortalConstExecution> PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() :
+    ExecutionPortalConstValid(false),
+    ExecutionPortalValid(false),
+    NumberOfValues(0) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl portal) {
+    this->SetArrays(portal);
+
+    this->ExecutionPortalConst = PortalConstExecution(
+                                   this->FirstArray.PrepareForInput(),
+                                   this->SecondArray.PrepareForInput());
+    this->ExecutionPortalConst.Shrink(this->NumberOfValues);
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl portal) {
+    this->SetArrays(portal);
+
+    this->ExecutionPortal = PortalExecution(
+                              this->FirstArray.PrepareForInPlace(),
+                              this->SecondArray.PrepareForInPlace());
+    this->ExecutionPortal.Shrink(this->NumberOfValues);
+
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  /// A concatenation can not change the size of the arrays it joins, so
+  /// output is only allowed when it fills exactly both of them. This lets
+  /// an operation write the results of several blocks in a single pass.
+  ///
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType controlArray,
+                              dax::Id numberOfValues) {
+    this->SetArrays(controlArray.GetPortal());
+    if (numberOfValues != this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "An ArrayHandleConcatenate can only be used as an output when the "
+            "number of values matches the length of the concatenation.");
+      }
+
+    this->ExecutionPortal = PortalExecution(
+                              this->FirstArray.PrepareForInPlace(),
+                              this->SecondArray.PrepareForInPlace());
+    this->ExecutionPortal.Shrink(this->NumberOfValues);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalValid = true;
+    this->ExecutionPortalConstValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData( ContainerType & daxNotUsed(controlArray) ) const {
+    // Nothing to do. The output was written directly into the delegate
+    // handles, which manage getting it back to the control environment.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    typedef typename FirstArrayHandleType::PortalConstControl FirstPortalType;
+    typedef typename SecondArrayHandleType::PortalConstControl
+        SecondPortalType;
+
+    FirstPortalType first = this->FirstArray.GetPortalConstControl();
+    const dax::Id numFirst =
+        std::min(this->NumberOfValues, first.GetNumberOfValues());
+    dest = std::copy(first.GetIteratorBegin(),
+                     first.GetIteratorBegin() + numFirst,
+                     dest);
+
+    if (numFirst < this->NumberOfValues)
+      {
+      SecondPortalType second = this->SecondArray.GetPortalConstControl();
+      std::copy(second.GetIteratorBegin(),
+                second.GetIteratorBegin() + (this->NumberOfValues - numFirst),
+                dest);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->NumberOfValues);
+    this->NumberOfValues = numberOfValues;
+    if (this->ExecutionPortalValid)
+      {
+      this->ExecutionPortal.Shrink(numberOfValues);
+      }
+    if (this->ExecutionPortalConstValid)
+      {
+      this->ExecutionPortalConst.Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  //We don't own the memory, the handles do, so don't deallocate
+  //underneath of them.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  DAX_CONT_EXPORT
+  void SetArrays(const PortalConstControl &portal)
+  {
+    if (portal.NumberOfValues > (portal.FirstArray.GetNumberOfValues()
+                                 + portal.SecondArray.GetNumberOfValues()))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandleConcatenate is longer than the arrays it joins. Were "
+            "the delegate arrays shrunk after the concatenation was made?");
+      }
+    this->FirstArray = portal.FirstArray;
+    this->SecondArray = portal.SecondArray;
+    this->NumberOfValues = portal.NumberOfValues;
+  }
+
+  bool ExecutionPortalConstValid;
+  bool ExecutionPortalValid;
+
+  FirstArrayHandleType FirstArray;
+  SecondArrayHandleType SecondArray;
+  dax::Id NumberOfValues;
+  PortalExecution ExecutionPortal;
+  PortalConstExecution ExecutionPortalConst;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ArrayContainerControlConcatenate_h
@@ -0,0 +1,458 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ArrayContainerControlView_h
+#define __dax_cont_internal_ArrayContainerControlView_h
+
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/ArrayPortal.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlInternal.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief An array portal that exposes a contiguous sub-range of another
+/// array portal.
+///
+/// Index \c i of this portal refers to index \c offset + \c i of the
+/// delegate portal. No data is copied.
+///
+template <class P>
+class ArrayPortalView
+{
+public:
+  typedef P DelegatePortalType;
+  typedef typename DelegatePortalType::ValueType ValueType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView() :
+    DelegatePortal(),
+    Offset(0),
+    NumberOfValues(0)
+    { }
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView(const DelegatePortalType &delegatePortal,
+                  dax::Id offset,
+                  dax::Id numberOfValues) :
+    DelegatePortal(delegatePortal),
+    Offset(offset),
+    NumberOfValues(numberOfValues)
+    {  }
+
+  /// Copy constructor for any other ArrayPortalView with a delegate portal
+  /// type that can be copied to this delegate portal type. This allows us to
+  /// do any type casting that the delegates do (like the non-const to const
+  /// cast).
+  ///
+  template<class OtherP>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView(const ArrayPortalView<OtherP> &src)
+    : DelegatePortal(src.GetDelegatePortal()),
+      Offset(src.GetOffset()),
+      NumberOfValues(src.GetNumberOfValues())
+  {  }
+
+  template<class OtherP>
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalView<P> &operator=(const ArrayPortalView<OtherP> &src)
+  {
+    this->DelegatePortal = src.GetDelegatePortal();
+    this->Offset = src.GetOffset();
+    this->NumberOfValues = src.GetNumberOfValues();
+    return *this;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_EXEC_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->DelegatePortal.Get(this->Offset + index);
+  }
+
+  DAX_EXEC_EXPORT
+  void Set(dax::Id index, const ValueType &value) const {
+    this->DelegatePortal.Set(this->Offset + index, value);
+  }
+
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalView<DelegatePortalType> > IteratorType;
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_EXEC_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const DelegatePortalType &GetDelegatePortal() const {
+    return this->DelegatePortal;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetOffset() const { return this->Offset; }
+
+  /// Shortens the view without touching the delegate portal.
+  ///
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->NumberOfValues);
+    this->NumberOfValues = numberOfValues;
+  }
+
+private:
+  DelegatePortalType DelegatePortal;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+};
+
+//simple container for the array handle and the range it views
+//so we can get them inside the array transfer class. It can also be read
+//in the control environment, which looks up each value in the viewed handle.
+template<class HandleType>
+struct ArrayPortalConstView
+{
+  typedef typename HandleType::ValueType ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalConstView<HandleType> > IteratorType;
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstView():
+  Array(),
+  Offset(0),
+  NumberOfValues(0)
+  { }
+
+  DAX_CONT_EXPORT
+  ArrayPortalConstView(HandleType handle,
+                       dax::Id offset,
+                       dax::Id numberOfValues):
+  Array(handle),
+  Offset(offset),
+  NumberOfValues(numberOfValues)
+  { }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->Array.GetPortalConstControl().Get(this->Offset + index);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+  HandleType Array;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+};
+
+
+template<class ArrayHandleType>
+struct ArrayContainerControlTagView { };
+
+/// This helper struct defines the value type for a view container
+/// containing the given array handle.
+///
+template<class ArrayHandleType>
+struct ArrayContainerControlViewTypes {
+  /// The ValueType, which is what ever the viewed array holds
+  ///
+  typedef typename ArrayHandleType::ValueType ValueType;
+
+  /// The full type of the internal ArrayContainerControl specialization.
+  ///
+  typedef ArrayContainerControl<
+    ValueType, ArrayContainerControlTagView<ArrayHandleType> >
+      ArrayContainerControlType;
+
+  /// The appropriately templated tag.
+  ///
+  typedef ArrayContainerControlTagView<ArrayHandleType>
+      ArrayContainerControlTag;
+
+  /// The portal types used with the view container.
+  ///
+  typedef dax::cont::internal::ArrayPortalConstView<ArrayHandleType>
+      PortalControl;
+
+  typedef PortalControl PortalConstControl;
+};
+
+template<class ArrayHandleType>
+class ArrayContainerControl<
+    typename ArrayHandleType::ValueType,
+    ArrayContainerControlTagView<ArrayHandleType> >
+{
+private:
+  typedef ArrayContainerControlViewTypes<ArrayHandleType> ViewTypes;
+
+public:
+  typedef typename ViewTypes::ValueType ValueType;
+
+  typedef typename ViewTypes::PortalControl PortalType;
+  typedef typename ViewTypes::PortalConstControl PortalConstType;
+
+public:
+  DAX_CONT_EXPORT
+  ArrayContainerControl():
+  Portal()
+  {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(ArrayHandleType handle,
+                        dax::Id offset,
+                        dax::Id numberOfValues):
+  Portal(handle,offset,numberOfValues)
+  {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    return Portal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    return Portal;
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return Portal.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlInternal(
+      "The allocate method for the view control array container should "
+      "never have been called. The allocate is generally only called by "
+      "the execution array manager, and the array transfer for the view "
+      "container should prevent the execution array manager from being "
+      "directly used.");
+  }
+
+  /// Shrinking a view only shortens the range it covers. The viewed array is
+  /// left untouched.
+  ///
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->Portal.NumberOfValues);
+    this->Portal.NumberOfValues = numberOfValues;
+  }
+
+  //We don't own the memory, the viewed handle does, so don't deallocate
+  //underneath of it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  PortalType Portal;
+};
+
+template<typename T, class ArrayHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    T, ArrayContainerControlTagView<ArrayHandleType>, DeviceAdapter>
+{
+  // This specialization of ArrayTransfer should never be instantiated, so
+  // you should get a compile error about an undefined class element pointing
+  // to this class if that happens.  You should be getting the specialization
+  // of ArrayTransfer that defines the value type, but an error somewhere,
+  // probably using the wrong type, is preventing that.
+};
+
+template<class ArrayHandleType, class DeviceAdapter>
+class ArrayTransfer<
+    typename ArrayContainerControlViewTypes<ArrayHandleType>::ValueType,
+    ArrayContainerControlTagView<ArrayHandleType>,
+    DeviceAdapter>
+{
+private:
+  typedef ArrayContainerControlViewTypes<ArrayHandleType> ViewTypes;
+  typedef typename ViewTypes::ArrayContainerControlType ContainerType;
+
+public:
+  typedef typename ViewTypes::ValueType ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalView<typename ArrayHandleType::PortalExecution>
+      PortalExecution;
+  typedef ArrayPortalView<typename ArrayHandleType::PortalConstExecution>
+      PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() :
+    ExecutionPortalConstValid(false),
+    ExecutionPortalValid(false),
+    Offset(0),
+    NumberOfValues(0) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    return this->NumberOfValues;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl portal) {
+    this->SetRange(portal);
+
+    this->ExecutionPortalConst = PortalConstExecution(
+                                   this->Array.PrepareForInput(),
+                                   this->Offset,
+                                   this->NumberOfValues);
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl portal) {
+    this->SetRange(portal);
+
+    this->ExecutionPortal = PortalExecution(this->Array.PrepareForInPlace(),
+                                            this->Offset,
+                                            this->NumberOfValues);
+
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalConstValid = true;
+    this->ExecutionPortalValid = true;
+  }
+
+  /// A view can not change the size of the array it looks into, so output
+  /// is only allowed when it fills exactly the viewed range. The values
+  /// outside of the range are preserved.
+  ///
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType controlArray,
+                              dax::Id numberOfValues) {
+    this->SetRange(controlArray.GetPortal());
+    if (numberOfValues != this->NumberOfValues)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "An ArrayHandleView can only be used as an output when the "
+            "number of values matches the length of the view.");
+      }
+
+    this->ExecutionPortal = PortalExecution(this->Array.PrepareForInPlace(),
+                                            this->Offset,
+                                            this->NumberOfValues);
+    this->ExecutionPortalConst = this->ExecutionPortal;
+    this->ExecutionPortalValid = true;
+    this->ExecutionPortalConstValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData( ContainerType & daxNotUsed(controlArray) ) const {
+    // Nothing to do. The output was written directly into the viewed handle,
+    // which manages getting it back to the control environment.
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    typedef typename ArrayHandleType::PortalConstControl DelegatePortalType;
+    DelegatePortalType portal = this->Array.GetPortalConstControl();
+    std::copy(portal.GetIteratorBegin() + this->Offset,
+              portal.GetIteratorBegin() + this->Offset + this->NumberOfValues,
+              dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id numberOfValues) {
+    DAX_ASSERT_CONT(numberOfValues <= this->NumberOfValues);
+    this->NumberOfValues = numberOfValues;
+    if (this->ExecutionPortalValid)
+      {
+      this->ExecutionPortal.Shrink(numberOfValues);
+      }
+    if (this->ExecutionPortalConstValid)
+      {
+      this->ExecutionPortalConst.Shrink(numberOfValues);
+      }
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    DAX_ASSERT_CONT(this->ExecutionPortalValid);
+    return this->ExecutionPortal;
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  //We don't own the memory, the viewed handle does, so don't deallocate
+  //underneath of it.
+  DAX_CONT_EXPORT
+  void ReleaseResources() { }
+
+private:
+  DAX_CONT_EXPORT
+  void SetRange(const PortalConstControl &portal)
+  {
+    if (   (portal.Offset < 0)
+        || (portal.NumberOfValues < 0)
+        || (portal.Offset + portal.NumberOfValues
+            > portal.Array.GetNumberOfValues()) )
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "ArrayHandleView range extends past the end of the viewed array.");
+      }
+    this->Array = portal.Array;
+    this->Offset = portal.Offset;
+    this->NumberOfValues = portal.NumberOfValues;
+  }
+
+  bool ExecutionPortalConstValid;
+  bool ExecutionPortalValid;
+
+  ArrayHandleType Array;
+  dax::Id Offset;
+  dax::Id NumberOfValues;
+  PortalExecution ExecutionPortal;
+  PortalConstExecution ExecutionPortalConst;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ArrayContainerControlView_h
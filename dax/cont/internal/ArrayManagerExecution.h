@@ -125,6 +125,22 @@ public:
   ///
   DAX_CONT_EXPORT void Shrink(dax::Id numberOfValues);
 
+  /// \brief Changes the size of the array, keeping its values.
+  ///
+  /// Unlike Shrink, this method can also grow the array. The array is
+  /// reallocated in the execution environment. If control and execution share
+  /// memory, the reallocation should be done in \c controlArray. Growing
+  /// should reserve extra capacity so that repeated growth is amortized.
+  ///
+  DAX_CONT_EXPORT void Resize(ContainerType &controlArray,
+                              dax::Id numberOfValues);
+
+  /// Makes sure the array can hold at least \c numberOfValues without being
+  /// reallocated. The values and size of the array are not changed.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues);
+
   /// Returns an array portal that can be used in the execution environment.
   /// This portal was defined in either LoadDataForInput or
   /// AllocateArrayForOutput. If control and environment share memory space,
@@ -131,6 +131,40 @@ public:
       }
   }
 
+  /// Resizes the array in \c controlArray, which is shared with the execution
+  /// environment, keeping its values. The saved portals are updated to point
+  /// to the (possibly moved) array, so no data has to be transferred.
+  ///
+  DAX_CONT_EXPORT void Resize(ContainerType &controlArray,
+                              dax::Id numberOfValues)
+  {
+    controlArray.Resize(numberOfValues);
+
+    this->Portal = controlArray.GetPortal();
+    this->PortalValid = true;
+
+    this->ConstPortal = controlArray.GetPortalConst();
+    this->ConstPortalValid = true;
+  }
+
+  /// Reserves space in \c controlArray, which is shared with the execution
+  /// environment, keeping its values. The saved portals are updated to point
+  /// to the (possibly moved) array.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues)
+  {
+    DAX_ASSERT_CONT(this->ConstPortalValid);
+    const dax::Id size = this->ConstPortal.GetNumberOfValues();
+    controlArray.Reserve(numberOfValues);
+
+    this->ConstPortal = PortalConstType(controlArray.GetPortalConst(), size);
+    if (this->PortalValid)
+      {
+      this->Portal = PortalType(controlArray.GetPortal(), size);
+      }
+  }
+
   /// Returns the portal previously saved from an \c ArrayContainerControl.
   ///
   DAX_CONT_EXPORT PortalType GetPortal()
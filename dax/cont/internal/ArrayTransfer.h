@@ -142,6 +142,29 @@ public:
     this->ArrayManager.Shrink(numberOfValues);
   }
 
+  /// \brief Changes the size of the array in the execution environment.
+  ///
+  /// The values already in the array are kept. The array is reallocated in
+  /// the execution environment, so nothing is transferred to the control
+  /// environment. If control and execution share memory, the reallocation is
+  /// done in the given \c controlArray.
+  ///
+  DAX_CONT_EXPORT void Resize(ContainerType &controlArray,
+                              dax::Id numberOfValues)
+  {
+    this->ArrayManager.Resize(controlArray, numberOfValues);
+  }
+
+  /// Makes sure the array in the execution environment can hold at least \c
+  /// numberOfValues without reallocating. The values and size of the array
+  /// are not changed.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &controlArray,
+                               dax::Id numberOfValues)
+  {
+    this->ArrayManager.Reserve(controlArray, numberOfValues);
+  }
+
   /// Returns an array portal that can be used in the execution environment.
   /// This portal was defined in either LoadDataForInput or
   /// AllocateArrayForOutput. If control and environment share memory space,
@@ -0,0 +1,84 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_ComputeBounds_h
+#define __dax_cont_internal_ComputeBounds_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/exec/internal/kernel/BoundsWorklets.h>
+
+#include <dax/math/Compare.h>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Computes the axis aligned bounds of an array of coordinates. The device
+/// adapter has no reduce, so the bounds of blocks of points are computed in
+/// parallel and the few block bounds are then combined in the control
+/// environment. The array must not be empty.
+///
+template<class Container, class DeviceAdapterTag>
+DAX_CONT_EXPORT
+void ComputeBounds(
+    const dax::cont::ArrayHandle<dax::Vector3,Container,DeviceAdapterTag>
+        &coordinates,
+    dax::Vector3 &minBounds,
+    dax::Vector3 &maxBounds)
+{
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef dax::cont::ArrayHandle<dax::Vector3,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> BoundsArrayType;
+
+  const dax::Id numberOfPoints = coordinates.GetNumberOfValues();
+  const dax::Id blockSize = 1024;
+  const dax::Id numberOfBlocks = (numberOfPoints + blockSize - 1)/blockSize;
+
+  BoundsArrayType minBlockBounds;
+  BoundsArrayType maxBlockBounds;
+  dax::exec::internal::kernel::BlockBoundsFunctor<
+      typename dax::cont::ArrayHandle<dax::Vector3,Container,DeviceAdapterTag>
+          ::PortalConstExecution,
+      typename BoundsArrayType::PortalExecution>
+      boundsFunctor(coordinates.PrepareForInput(),
+                    minBlockBounds.PrepareForOutput(numberOfBlocks),
+                    maxBlockBounds.PrepareForOutput(numberOfBlocks),
+                    blockSize);
+  Algorithm::Schedule(boundsFunctor, numberOfBlocks);
+
+  typename BoundsArrayType::PortalConstControl minPortal =
+      minBlockBounds.GetPortalConstControl();
+  typename BoundsArrayType::PortalConstControl maxPortal =
+      maxBlockBounds.GetPortalConstControl();
+  minBounds = minPortal.Get(0);
+  maxBounds = maxPortal.Get(0);
+  for (dax::Id block = 1; block < numberOfBlocks; block++)
+    {
+    minBounds = dax::math::Min(minBounds, minPortal.Get(block));
+    maxBounds = dax::math::Max(maxBounds, maxPortal.Get(block));
+    }
+}
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_ComputeBounds_h
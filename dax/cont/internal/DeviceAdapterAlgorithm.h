@@ -180,6 +180,18 @@ struct DeviceAdapterAlgorithm
   DAX_CONT_EXPORT static void Schedule(Functor functor,
                                        dax::Id3 rangeMax);
 
+  /// \brief Schedule many instances of a function to run on concurrent threads
+  /// over a two dimensional range.
+  ///
+  /// Behaves like the dax::Id3 version of Schedule with a third dimension of
+  /// size 1. There is one invocation for every i, j value between [0, 0] and
+  /// \c rangeMax. Device adapters that support 3D indices pass the functor a
+  /// 3D index whose k component is always 0.
+  ///
+  template<class Functor, class IndiceType>
+  DAX_CONT_EXPORT static void Schedule(Functor functor,
+                                       dax::Id2 rangeMax);
+
   /// \brief Unstable ascending sort of input array.
   ///
   /// Sorts the contents of \c values so that they in ascending value. Doesn't
@@ -20,6 +20,7 @@
 #include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/ArrayHandleCounting.h>
 #include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/internal/ArrayHandleZip.h>
 
 #include <dax/Functional.h>
@@ -338,6 +339,9 @@ public:
       const dax::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
       dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+          "DeviceAdapterAlgorithm::ScanExclusive");
+
     typedef dax::cont::ArrayHandle<
         T,dax::cont::ArrayContainerControlTagBasic,DeviceAdapterTag>
         TempArrayType;
@@ -576,6 +580,9 @@ public:
       dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &values,
       CompareType compare)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+          "DeviceAdapterAlgorithm::Sort");
+
     typedef typename dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> ArrayHandleType;
     typedef typename ArrayHandleType::PortalConstExecution ValuesInputPortalType;
     typedef typename ArrayHandleType::PortalExecution ValuesOutputPortalType;
@@ -772,6 +779,9 @@ public:
       const dax::cont::ArrayHandle<U,CStencil,DeviceAdapterTag>& stencil,
       dax::cont::ArrayHandle<T,COut,DeviceAdapterTag>& output)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+          "DeviceAdapterAlgorithm::StreamCompact");
+
     DAX_ASSERT_CONT(input.GetNumberOfValues() == stencil.GetNumberOfValues());
     dax::Id arrayLength = stencil.GetNumberOfValues();
 
@@ -905,6 +915,9 @@ public:
   DAX_CONT_EXPORT static void Unique(
       dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &values)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+          "DeviceAdapterAlgorithm::Unique");
+
     dax::cont::ArrayHandle<
         dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
         stencilArray;
@@ -931,6 +944,9 @@ public:
       dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &values,
       Compare comp)
   {
+    dax::cont::MemoryTrackerScope memoryScope(
+          "DeviceAdapterAlgorithm::Unique");
+
     dax::cont::ArrayHandle<
         dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
         stencilArray;
@@ -175,6 +175,35 @@ public:
       }
   }
 
+  template<class FunctorType>
+  DAX_CONT_EXPORT
+  static void Schedule(FunctorType functor, dax::Id2 rangeMax)
+  {
+    const dax::Id MESSAGE_SIZE = 1024;
+    char errorString[MESSAGE_SIZE];
+    errorString[0] = '\0';
+    dax::exec::internal::ErrorMessageBuffer
+        errorMessage(errorString, MESSAGE_SIZE);
+
+    functor.SetErrorMessageBuffer(errorMessage);
+
+    dax::exec::internal::IJKIndex index(
+          dax::make_Id3(rangeMax[0], rangeMax[1], 1));
+    for( dax::Id j=0; j!=rangeMax[1]; ++j)
+      {
+      index.SetJ(j);
+      for (dax::Id i=0; i < rangeMax[0]; ++i)
+        {
+        index.SetI(i);
+        functor(index);
+        }
+      }
+    if (errorMessage.IsErrorRaised())
+      {
+      throw dax::cont::ErrorExecution(errorString);
+      }
+  }
+
   template<typename T, class Container>
   DAX_CONT_EXPORT static void Sort(
       dax::cont::ArrayHandle<T,Container,DeviceAdapterTagSerial>& values)
@@ -31,11 +31,29 @@ struct UnstructuredGridTag {  };
 template<class _CellTag>
 struct UnstructuredGridOfCell : UnstructuredGridTag { };
 
+/// A subtag of UnstructuredGridTag that specifies the grid holds cells of
+/// different types, identified per cell by a shapes array.
+///
+struct UnstructuredGridMixedTag : UnstructuredGridTag { };
+
 
 /// A tag you can use to identify when a grid is a uniform grid.
 ///
 struct UniformGridTag {  };
 
+/// A tag you can use to identify when a grid is a 2D uniform grid.
+///
+struct UniformGrid2DTag {  };
+
+/// A tag you can use to identify when a grid is a rectilinear grid.
+///
+struct RectilinearGridTag {  };
+
+/// A tag you can use to identify when a grid is a structured (curvilinear)
+/// grid.
+///
+struct StructuredGridTag {  };
+
 
 /// A tag you can use to state you don't have a grid.
 /// Mainly used by algorithms and dispatchers to state they work on all grid
@@ -0,0 +1,98 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_SpinLock_h
+#define __dax_cont_internal_SpinLock_h
+
+#include <dax/internal/ExportMacros.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedExchange)
+#endif
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// \brief A lock for short sections of control code.
+///
+/// Host threads of the TBB and OpenMP device adapters, or several dispatchers
+/// run from different threads, may call into shared control-side state. This
+/// lock busy waits on an atomic exchange, which needs no threading library, so
+/// it should only guard a few quick operations. It is not recursive.
+///
+class SpinLock
+{
+public:
+  DAX_CONT_EXPORT SpinLock() : Locked(0) {  }
+
+  DAX_CONT_EXPORT void Lock()
+  {
+    while (Exchange(&this->Locked, 1) != 0)
+      {
+      while (this->Locked != 0) {  }
+      }
+  }
+
+  DAX_CONT_EXPORT void Unlock()
+  {
+#if defined(_MSC_VER)
+    Exchange(&this->Locked, 0);
+#else
+    __sync_lock_release(&this->Locked);
+#endif
+  }
+
+private:
+  SpinLock(const SpinLock &);  // Not implemented.
+  void operator=(const SpinLock &);  // Not implemented.
+
+  DAX_CONT_EXPORT static long Exchange(volatile long *target, long value)
+  {
+#if defined(_MSC_VER)
+    return _InterlockedExchange(target, value);
+#else
+    return __sync_lock_test_and_set(target, value);
+#endif
+  }
+
+  volatile long Locked;
+};
+
+/// \brief Holds a \c SpinLock for its lifetime.
+///
+class SpinLockScope
+{
+public:
+  DAX_CONT_EXPORT explicit SpinLockScope(SpinLock &lock) : Lock(lock)
+  {
+    this->Lock.Lock();
+  }
+
+  DAX_CONT_EXPORT ~SpinLockScope() { this->Lock.Unlock(); }
+
+private:
+  SpinLockScope(const SpinLockScope &);  // Not implemented.
+  void operator=(const SpinLockScope &);  // Not implemented.
+
+  SpinLock &Lock;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_SpinLock_h
@@ -463,6 +463,36 @@ private:
                       "Got bad value for scheduled dax::Id3 kernels.");
       }
     } //release memory
+
+    //verify that the schedule call works with id2
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing Schedule with dax::Id2" << std::endl;
+
+    {
+    std::cout << "Allocating execution array" << std::endl;
+    IdContainer container;
+    IdArrayManagerExecution manager;
+    dax::Id DIM_SIZE = dax::math::Ceil(dax::math::Sqrt(ARRAY_SIZE));
+    manager.AllocateArrayForOutput(container, DIM_SIZE * DIM_SIZE);
+    dax::Id2 maxRange(DIM_SIZE);
+
+    std::cout << "Running clear." << std::endl;
+    Algorithm::Schedule(ClearArrayKernel(manager.GetPortal()), maxRange);
+
+    std::cout << "Running add." << std::endl;
+    Algorithm::Schedule(AddArrayKernel(manager.GetPortal()), maxRange);
+
+    std::cout << "Checking results." << std::endl;
+    manager.RetrieveOutputData(container);
+
+    const dax::Id maxId = DIM_SIZE * DIM_SIZE;
+    for (dax::Id index = 0; index < maxId; index++)
+      {
+      dax::Id value = container.GetPortalConst().Get(index);
+      DAX_TEST_ASSERT(value == index + OFFSET,
+                      "Got bad value for scheduled dax::Id2 kernels.");
+      }
+    } //release memory
   }
 
   static DAX_CONT_EXPORT void TestDispatcher()
@@ -24,8 +24,11 @@
 #include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/StructuredGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
+#include <dax/cont/UnstructuredGridMixed.h>
 
 #include <dax/cont/testing/Testing.h>
 
@@ -66,6 +69,16 @@ private:
     std::vector<dax::Id> topology;
     std::vector<dax::Vector3> points;
     };
+  template<class RCCT, class DAT>
+  struct GridStorage<dax::cont::RectilinearGrid<RCCT,DAT> >
+    {
+    std::vector<dax::Scalar> axis;
+    };
+  template<class SCCT, class DAT>
+  struct GridStorage<dax::cont::StructuredGrid<SCCT,DAT> >
+    {
+    std::vector<dax::Vector3> points;
+    };
   GridStorage<GridType> Info;
 
   typedef typename GridType::TopologyStructConstExecution TopoType;
@@ -183,8 +196,39 @@ private:
   ComputeCellConnections(const dax::cont::UniformGrid<DeviceAdapterTag> &uniform,
                          dax::Id cell_index) const
   {
-    dax::Id3 ijk = uniform.ComputeCellLocation(cell_index);
-    dax::Id3 dims = dax::extentDimensions(uniform.GetExtent());
+    return this->ComputeVoxelConnections(uniform.GetExtent(), cell_index);
+  }
+
+  // ................................................... ComputeCellConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeCellConnections(
+      const dax::cont::RectilinearGrid<
+          ArrayContainerControlTag,DeviceAdapterTag> &rectilinear,
+      dax::Id cell_index) const
+  {
+    return this->ComputeVoxelConnections(rectilinear.GetExtent(), cell_index);
+  }
+
+  // ................................................... ComputeCellConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeCellConnections(
+      const dax::cont::StructuredGrid<
+          ArrayContainerControlTag,DeviceAdapterTag> &structured,
+      dax::Id cell_index) const
+  {
+    return this->ComputeVoxelConnections(structured.GetExtent(), cell_index);
+  }
+
+  // .................................................. ComputeVoxelConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeVoxelConnections(const dax::Extent3 &extent,
+                          dax::Id cell_index) const
+  {
+    dax::Id3 ijk = dax::flatIndexToIndex3Cell(cell_index, extent) - extent.Min;
+    dax::Id3 dims = dax::extentDimensions(extent);
     dax::Id firstPointIndex =
                       ijk[0] + ijk[1] * dims[0] + ijk[2] * dims[0] * dims[1];
     dax::Id secondPointIndex = firstPointIndex + (dims[0] * dims[1]);
@@ -262,6 +306,39 @@ private:
     grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(Size-1, Size-1, Size-1));
     }
 
+  // .......................................................... RectilinearGrid
+  void BuildGrid(
+    dax::cont::RectilinearGrid<ArrayContainerControlTag,DeviceAdapterTag> &grid)
+    {
+    // Use the same point positions as the uniform grid so that the expected
+    // results of the tests hold for both structured grid types.
+    this->Info.axis.clear();
+    for (dax::Id i = 0; i < Size; ++i)
+      {
+      this->Info.axis.push_back(static_cast<dax::Scalar>(i));
+      }
+    grid.SetCoordinates(this->MakeArrayHandle(this->Info.axis),
+                        this->MakeArrayHandle(this->Info.axis),
+                        this->MakeArrayHandle(this->Info.axis));
+    }
+
+  // ........................................................... StructuredGrid
+  void BuildGrid(
+    dax::cont::StructuredGrid<ArrayContainerControlTag,DeviceAdapterTag> &grid)
+    {
+    // Use the same point positions as the uniform grid so that the expected
+    // results of the tests hold for all grid types.
+    dax::cont::UniformGrid<DeviceAdapterTag> uniform;
+    this->BuildGrid(uniform);
+
+    this->MakeInfoPoints(uniform);
+
+    grid = dax::cont::StructuredGrid<
+           ArrayContainerControlTag,
+           DeviceAdapterTag>(uniform.GetExtent(),
+                             this->MakeArrayHandle(this->Info.points));
+    }
+
   // ............................................................... Hexahedron
   void BuildGrid(
     dax::cont::UnstructuredGrid<
@@ -526,6 +603,112 @@ private:
 };
 
 
+/// Builds a dax::cont::UnstructuredGridMixed on a \p dim cubed lattice of
+/// points with unit spacing. The cells of the lattice cycle through a
+/// hexahedron filling the lattice cell, a wedge filling half of it and a
+/// tetrahedron in its corner, so that all the cell types supported by mixed
+/// grids are interleaved.
+///
+template<class DeviceAdapterTag>
+dax::cont::UnstructuredGridMixed<DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+                                 DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+                                 DeviceAdapterTag>
+MakeMixedGrid(dax::Id dim, DeviceAdapterTag)
+{
+  const dax::Extent3 extent(dax::make_Id3(0, 0, 0),
+                            dax::make_Id3(dim-1, dim-1, dim-1));
+
+  std::vector<dax::Vector3> points;
+  for (dax::Id pointIndex = 0;
+       pointIndex < dim*dim*dim;
+       pointIndex++)
+    {
+    const dax::Id3 ijk = dax::flatIndexToIndex3(pointIndex, extent);
+    points.push_back(dax::make_Vector3(static_cast<dax::Scalar>(ijk[0]),
+                                       static_cast<dax::Scalar>(ijk[1]),
+                                       static_cast<dax::Scalar>(ijk[2])));
+    }
+
+  // Vertices of each cell type as indices into the voxel vertices.
+  const int hexahedronVertices[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const int wedgeVertices[6] = { 0, 3, 1, 4, 7, 5 };
+  const int tetrahedronVertices[4] = { 0, 1, 3, 4 };
+  const dax::Id3 voxelVertices[8] = {
+    dax::make_Id3(0, 0, 0),
+    dax::make_Id3(1, 0, 0),
+    dax::make_Id3(1, 1, 0),
+    dax::make_Id3(0, 1, 0),
+    dax::make_Id3(0, 0, 1),
+    dax::make_Id3(1, 0, 1),
+    dax::make_Id3(1, 1, 1),
+    dax::make_Id3(0, 1, 1)
+  };
+
+  std::vector<dax::Id> shapes;
+  std::vector<dax::Id> offsets;
+  std::vector<dax::Id> connections;
+  const dax::Id3 cellDims = dax::extentCellDimensions(extent);
+  for (dax::Id cellIndex = 0;
+       cellIndex < cellDims[0]*cellDims[1]*cellDims[2];
+       cellIndex++)
+    {
+    const dax::Id3 ijk = dax::flatIndexToIndex3Cell(cellIndex, extent);
+    const int *vertices;
+    int numVertices;
+    switch (cellIndex % 3)
+      {
+      case 0:
+        shapes.push_back(static_cast<dax::Id>(
+            dax::CellTraits<dax::CellTagHexahedron>::CELL_SHAPE));
+        vertices = hexahedronVertices;
+        numVertices = 8;
+        break;
+      case 1:
+        shapes.push_back(static_cast<dax::Id>(
+            dax::CellTraits<dax::CellTagWedge>::CELL_SHAPE));
+        vertices = wedgeVertices;
+        numVertices = 6;
+        break;
+      default:
+        shapes.push_back(static_cast<dax::Id>(
+            dax::CellTraits<dax::CellTagTetrahedron>::CELL_SHAPE));
+        vertices = tetrahedronVertices;
+        numVertices = 4;
+        break;
+      }
+    offsets.push_back(static_cast<dax::Id>(connections.size()));
+    for (int vertex = 0; vertex < numVertices; vertex++)
+      {
+      connections.push_back(dax::index3ToFlatIndex(
+                              ijk + voxelVertices[vertices[vertex]], extent));
+      }
+    }
+
+  // Copy the data into arrays owned by the handles, as the local vectors go
+  // out of scope.
+  typedef dax::cont::UnstructuredGridMixed<
+      DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+      DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+      DeviceAdapterTag> GridType;
+  typename GridType::ShapesType shapesHandle;
+  typename GridType::OffsetsType offsetsHandle;
+  typename GridType::CellConnectionsType connectionsHandle;
+  typename GridType::PointCoordinatesType pointsHandle;
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG container;
+  DeviceAdapterTag device;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(shapes, container, device),
+                  shapesHandle);
+  Algorithm::Copy(dax::cont::make_ArrayHandle(offsets, container, device),
+                  offsetsHandle);
+  Algorithm::Copy(dax::cont::make_ArrayHandle(connections, container, device),
+                  connectionsHandle);
+  Algorithm::Copy(dax::cont::make_ArrayHandle(points, container, device),
+                  pointsHandle);
+
+  return GridType(shapesHandle, offsetsHandle, connectionsHandle, pointsHandle);
+}
+
 struct GridTesting
 {
 private:
@@ -551,6 +734,11 @@ private:
       // This will probably have to change if we support 2D uniform grids.
       dax::cont::UniformGrid<DeviceAdapterTag> grid;
       this->Functor(grid);
+
+      // Rectilinear grids have the same voxel cells as uniform grids.
+      dax::cont::RectilinearGrid<ArrayContainerControlTag,DeviceAdapterTag>
+          rectilinearGrid;
+      this->Functor(rectilinearGrid);
     }
     template<class CellTag>
     void CallFunctor(CellTag, GridTagUnstructured)
@@ -562,6 +750,20 @@ private:
           DeviceAdapterTag> grid;
       this->Functor(grid);
     }
+    void CallFunctor(dax::CellTagHexahedron, GridTagUnstructured)
+    {
+      dax::cont::UnstructuredGrid<
+          dax::CellTagHexahedron,
+          ArrayContainerControlTag,
+          ArrayContainerControlTag,
+          DeviceAdapterTag> grid;
+      this->Functor(grid);
+
+      // Structured grids have the same hexahedra with implicit connections.
+      dax::cont::StructuredGrid<ArrayContainerControlTag,DeviceAdapterTag>
+          structuredGrid;
+      this->Functor(structuredGrid);
+    }
   };
 
 public:
@@ -58,6 +58,13 @@ struct TemplatedTests
     return true;
   }
 
+  template<class ContainerType>
+  bool IsAligned(ContainerType &array, std::size_t alignment)
+  {
+    const ValueType *pointer = &(*array.GetPortal().GetIteratorBegin());
+    return (reinterpret_cast<std::size_t>(pointer) % alignment) == 0;
+  }
+
   typename dax::VectorTraits<ValueType>::ComponentType STOLEN_ARRAY_VALUE() {
     return 4529;
   }
@@ -107,6 +114,8 @@ struct TemplatedTests
     arrayContainer.Allocate(ARRAY_SIZE);
     DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == ARRAY_SIZE,
                     "Array not properly allocated.");
+    DAX_TEST_ASSERT(IsAligned(arrayContainer, DAX_ALLOCATOR_ALIGNMENT),
+                    "Array not aligned to a cache line.");
 
     const ValueType BASIC_ALLOC_VALUE = dax::cont::VectorFill<ValueType>(548);
     SetContainer(arrayContainer, BASIC_ALLOC_VALUE);
@@ -134,12 +143,78 @@ struct TemplatedTests
     catch(dax::cont::ErrorControlBadValue){}
   }
 
+  void GrowingAllocation()
+  {
+    ArrayContainerType arrayContainer;
+
+    arrayContainer.Reserve(ARRAY_SIZE);
+    DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == 0,
+                    "Reserve changed number of values.");
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() == ARRAY_SIZE,
+                    "Reserve did not allocate.");
+
+    arrayContainer.Resize(ARRAY_SIZE);
+    const ValueType GROW_VALUE = dax::cont::VectorFill<ValueType>(87);
+    SetContainer(arrayContainer, GROW_VALUE);
+
+    arrayContainer.Resize(ARRAY_SIZE + 1);
+    DAX_TEST_ASSERT(arrayContainer.GetNumberOfValues() == ARRAY_SIZE + 1,
+                    "Resize did not grow array.");
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() >= 2*ARRAY_SIZE,
+                    "Resize did not grow capacity geometrically.");
+    arrayContainer.Shrink(ARRAY_SIZE);
+    DAX_TEST_ASSERT(CheckContainer(arrayContainer, GROW_VALUE),
+                    "Resize did not keep values.");
+
+    arrayContainer.Shrink(0);
+    arrayContainer.ReleaseResources();
+    DAX_TEST_ASSERT(arrayContainer.GetCapacity() == 0,
+                    "Array not released correctly.");
+  }
+
+  void HugePageAllocation()
+  {
+    typedef dax::cont::internal::ArrayContainerControl<
+        T, dax::cont::ArrayContainerControlTagHugePages> HugeContainerType;
+    typedef typename HugeContainerType::AllocatorType AllocatorType;
+
+    const dax::Id hugeSize =
+        AllocatorType::HUGE_PAGE_SIZE/sizeof(ValueType) + 1;
+    HugeContainerType hugeContainer;
+    hugeContainer.Allocate(hugeSize);
+    DAX_TEST_ASSERT(IsAligned(hugeContainer, AllocatorType::HUGE_PAGE_SIZE),
+                    "Large array not aligned to a huge page.");
+
+    // Make sure the whole array is usable.
+    const ValueType HUGE_VALUE = dax::cont::VectorFill<ValueType>(37);
+    for (dax::Id index = 0; index < hugeSize; index++)
+      {
+      hugeContainer.GetPortal().Set(index, HUGE_VALUE);
+      }
+    for (dax::Id index = 0; index < hugeSize; index++)
+      {
+      DAX_TEST_ASSERT(test_equal(hugeContainer.GetPortalConst().Get(index),
+                                 HUGE_VALUE),
+                      "Huge page array not holding value.");
+      }
+
+    // The huge pages are a property of the container, not a global setting.
+    ArrayContainerType basicContainer;
+    basicContainer.Allocate(hugeSize);
+    DAX_TEST_ASSERT(IsAligned(basicContainer, DAX_ALLOCATOR_ALIGNMENT),
+                    "Large array not aligned to a cache line.");
+  }
+
   void operator()()
   {
     ValueType *stolenArray = StealArray1();
 
     BasicAllocation();
 
+    GrowingAllocation();
+
+    HugePageAllocation();
+
     StealArray2(stolenArray);
   }
 };
@@ -53,6 +53,86 @@ bool CheckValues(const dax::cont::ArrayHandle<T> &handle)
                      handle.GetPortalConstControl().GetIteratorEnd());
 }
 
+void TestArrayHandleResize()
+{
+  typedef dax::cont::ArrayHandle<dax::Scalar> HandleType;
+
+  std::cout << "Grow an array in the control environment." << std::endl;
+  HandleType arrayHandle;
+  arrayHandle.Reserve(ARRAY_SIZE);
+  DAX_TEST_ASSERT(arrayHandle.GetNumberOfValues() == 0,
+                  "Reserve changed the size of the array.");
+  arrayHandle.Resize(ARRAY_SIZE/2);
+  {
+  HandleType::PortalControl portal = arrayHandle.GetPortalControl();
+  for (dax::Id index = 0; index < ARRAY_SIZE/2; index++)
+    {
+    portal.Set(index, TestValue(index));
+    }
+  }
+  arrayHandle.Resize(ARRAY_SIZE);
+  {
+  HandleType::PortalControl portal = arrayHandle.GetPortalControl();
+  for (dax::Id index = ARRAY_SIZE/2; index < ARRAY_SIZE; index++)
+    {
+    portal.Set(index, TestValue(index));
+    }
+  }
+  DAX_TEST_ASSERT(arrayHandle.GetNumberOfValues() == ARRAY_SIZE,
+                  "Array did not grow correctly.");
+  DAX_TEST_ASSERT(CheckValues(arrayHandle),
+                  "Resize did not keep values.");
+
+  std::cout << "Grow an array in the execution environment." << std::endl;
+  arrayHandle.PrepareForInPlace();
+  arrayHandle.Resize(ARRAY_SIZE*2);
+  {
+  HandleType::PortalExecution executionPortal =
+      arrayHandle.PrepareForInPlace();
+  DAX_TEST_ASSERT(executionPortal.GetNumberOfValues() == ARRAY_SIZE*2,
+                  "Execution array did not grow correctly.");
+  for (dax::Id index = ARRAY_SIZE; index < ARRAY_SIZE*2; index++)
+    {
+    executionPortal.Set(index, TestValue(index));
+    }
+  }
+  DAX_TEST_ASSERT(arrayHandle.GetNumberOfValues() == ARRAY_SIZE*2,
+                  "Array did not grow correctly.");
+  DAX_TEST_ASSERT(CheckValues(arrayHandle),
+                  "Resize in execution did not keep values.");
+
+  std::cout << "Append arrays." << std::endl;
+  dax::Scalar array[ARRAY_SIZE];
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    array[index] = TestValue(index + ARRAY_SIZE*2);
+    }
+  arrayHandle.Append(dax::cont::make_ArrayHandle(array, ARRAY_SIZE));
+  arrayHandle.Append(HandleType());
+  DAX_TEST_ASSERT(arrayHandle.GetNumberOfValues() == ARRAY_SIZE*3,
+                  "Append did not grow array correctly.");
+  DAX_TEST_ASSERT(CheckValues(arrayHandle),
+                  "Append did not copy values.");
+
+  std::cout << "Resize to a smaller array." << std::endl;
+  arrayHandle.Resize(ARRAY_SIZE);
+  DAX_TEST_ASSERT(arrayHandle.GetNumberOfValues() == ARRAY_SIZE,
+                  "Array size did not shrink correctly.");
+  DAX_TEST_ASSERT(CheckValues(arrayHandle),
+                  "Resize did not keep values.");
+
+  std::cout << "Check that user arrays can not be resized." << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandle(array, ARRAY_SIZE).Resize(ARRAY_SIZE*2);
+    DAX_TEST_FAIL("Resize did not fail for user array.");
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
 void TestArrayHandle()
 {
   std::cout << "Create array handle." << std::endl;
@@ -145,6 +225,8 @@ void TestArrayHandle()
     DAX_TEST_ASSERT(test_equal(array[index], TestValue(index) + 1),
                     "Did not get result from in place operation.");
     }
+
+  TestArrayHandleResize();
 }
 
 }
@@ -0,0 +1,211 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+//This sets up the ArrayHandle semantics to allocate pointers and share memory
+//between control and execution.
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleCompact.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+
+#include <dax/math/Sign.h>
+
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+void TestCodecHalf()
+{
+  std::cout << "Encoding and decoding half floats." << std::endl;
+  dax::cont::CompactCodecHalf codec;
+
+  // Values exactly representable as halfs.
+  const dax::Scalar exact[] = { 0, 1, -1, 0.5, 2048, -65504, 0.099975586f,
+                                6.1035156e-5f, 5.9604645e-8f };
+  for (unsigned int index = 0; index < sizeof(exact)/sizeof(dax::Scalar);
+       index++)
+    {
+    DAX_TEST_ASSERT(codec.Decode(codec.Encode(exact[index])) == exact[index],
+                    "Half float did not round trip.");
+    }
+
+  DAX_TEST_ASSERT(codec.Encode(1) == 0x3c00, "Bad encoding of 1.");
+  DAX_TEST_ASSERT(codec.Encode(-2) == 0xc000, "Bad encoding of -2.");
+  DAX_TEST_ASSERT(codec.Encode(65504) == 0x7bff, "Bad encoding of max.");
+  DAX_TEST_ASSERT(codec.Encode(1.0e6f) == 0x7c00,
+                  "Large value did not encode to infinity.");
+  DAX_TEST_ASSERT(codec.Encode(1.0e-10f) == 0, "Tiny value did not flush.");
+
+  // Values that need rounding have about 3 decimal digits.
+  for (dax::Scalar value = -100; value < 100; value += 0.37f)
+    {
+    DAX_TEST_ASSERT(test_equal(codec.Decode(codec.Encode(value)), value, 0.001),
+                    "Half float rounded too far.");
+    }
+}
+
+void TestCodecQuantized()
+{
+  std::cout << "Encoding and decoding quantized values." << std::endl;
+  typedef dax::cont::CompactCodecQuantized<unsigned char> CodecType;
+  CodecType codec = CodecType::FromRange(-1, 1);
+
+  DAX_TEST_ASSERT(codec.Encode(-1) == 0, "Bad encoding of min.");
+  DAX_TEST_ASSERT(codec.Encode(1) == 255, "Bad encoding of max.");
+  DAX_TEST_ASSERT(codec.Encode(-5) == 0, "Value below range not clamped.");
+  DAX_TEST_ASSERT(codec.Encode(5) == 255, "Value above range not clamped.");
+  DAX_TEST_ASSERT(test_equal(codec.Decode(255), dax::Scalar(1)),
+                  "Bad decoding of max.");
+
+  for (dax::Scalar value = -1; value <= 1; value += 0.01f)
+    {
+    const dax::Scalar roundTrip = codec.Decode(codec.Encode(value));
+    DAX_TEST_ASSERT(dax::math::Abs(roundTrip - value)
+                    <= 0.5*codec.GetScale() + 0.0001,
+                    "Quantized value rounded too far.");
+    }
+
+  CodecType integers(1, 0);
+  for (int value = 0; value < 256; value++)
+    {
+    DAX_TEST_ASSERT(integers.Decode(integers.Encode(value)) == value,
+                    "Integer did not round trip.");
+    }
+}
+
+void TestCodecId()
+{
+  std::cout << "Narrowing and widening ids." << std::endl;
+  typedef dax::cont::CompactCodecId<dax::internal::Int32Type> CodecType;
+  BOOST_STATIC_ASSERT((boost::is_same<CodecType::ValueType,dax::Id>::value));
+  BOOST_STATIC_ASSERT((boost::is_same<CodecType::StorageType,
+                                      dax::internal::Int32Type>::value));
+  CodecType codec;
+
+  for (dax::Id value = 0; value < ARRAY_SIZE; value++)
+    {
+    DAX_TEST_ASSERT(codec.Decode(codec.Encode(value)) == value,
+                    "Id did not round trip.");
+    }
+}
+
+void TestCompactInput()
+{
+  std::cout << "Reading values through a compact array." << std::endl;
+  typedef dax::cont::ArrayHandleCompact<dax::cont::CompactCodecHalf>
+      CompactHandleType;
+  dax::cont::CompactCodecHalf codec;
+
+  std::vector<unsigned short> encoded(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    encoded[index] = codec.Encode(index);
+    }
+  CompactHandleType::StorageHandleType storage;
+  dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        dax::cont::make_ArrayHandle(encoded), storage);
+
+  CompactHandleType compact = dax::cont::make_ArrayHandleCompact(storage,
+                                                                 codec);
+  DAX_TEST_ASSERT(compact.GetNumberOfValues() == ARRAY_SIZE,
+                  "Compact array has wrong number of values.");
+
+  CompactHandleType::PortalConstExecution portal = compact.PrepareForInput();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == index, "Bad decoded value.");
+    }
+
+  std::vector<dax::Scalar> copied(ARRAY_SIZE);
+  compact.CopyInto(copied.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(copied[index] == index, "Bad copied value.");
+    }
+
+  std::cout << "Writing values through the control portal." << std::endl;
+  compact.GetPortalControl().Set(0, 42);
+  DAX_TEST_ASSERT(storage.GetPortalConstControl().Get(0) == codec.Encode(42),
+                  "Control portal did not encode into storage.");
+  DAX_TEST_ASSERT(compact.GetPortalConstControl().Get(0) == 42,
+                  "Control portal did not decode from storage.");
+}
+
+void TestCompactDispatch()
+{
+  std::cout << "Using compact arrays as worklet input and output."
+            << std::endl;
+  typedef dax::cont::CompactCodecQuantized<unsigned short> CodecType;
+  typedef dax::cont::ArrayHandleCompact<CodecType> CompactHandleType;
+
+  std::vector<dax::Scalar> inBuffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    inBuffer[index] = static_cast<dax::Scalar>(index);
+    }
+
+  // Copying a scalar array into a compact array encodes it.
+  CompactHandleType input((CodecType(1, 0)));
+  dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        dax::cont::make_ArrayHandle(inBuffer), input);
+  DAX_TEST_ASSERT(input.GetStorage().GetNumberOfValues() == ARRAY_SIZE,
+                  "Copy did not fill the storage array.");
+
+  CompactHandleType output((CodecType(1, 0)));
+  dax::cont::DispatcherMapField<dax::worklet::Square>().Invoke(input, output);
+
+  DAX_TEST_ASSERT(output.GetNumberOfValues() == ARRAY_SIZE,
+                  "Output has wrong number of values.");
+  CompactHandleType::StorageHandleType storage = output.GetStorage();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(output.GetPortalConstControl().Get(index) == index*index,
+                    "Bad squared value.");
+    DAX_TEST_ASSERT(storage.GetPortalConstControl().Get(index) == index*index,
+                    "Output was not stored encoded.");
+    }
+
+  std::cout << "Shrinking the output." << std::endl;
+  output.Shrink(ARRAY_SIZE/2);
+  DAX_TEST_ASSERT(output.GetNumberOfValues() == ARRAY_SIZE/2,
+                  "Compact array has wrong number of values after shrink.");
+  DAX_TEST_ASSERT(storage.GetNumberOfValues() == ARRAY_SIZE/2,
+                  "Shrink did not shrink the storage array.");
+}
+
+void TestArrayHandleCompact()
+{
+  TestCodecHalf();
+  TestCodecQuantized();
+  TestCodecId();
+  TestCompactInput();
+  TestCompactDispatch();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleCompact(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleCompact);
+}
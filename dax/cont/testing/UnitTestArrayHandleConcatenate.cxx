@@ -0,0 +1,165 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+//This sets up the ArrayHandle semantics to allocate pointers and share memory
+//between control and execution.
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleConcatenate.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id FIRST_SIZE = 4;
+const dax::Id SECOND_SIZE = 6;
+const dax::Id ARRAY_SIZE = FIRST_SIZE + SECOND_SIZE;
+
+void TestConcatenateInput()
+{
+  std::cout << "Reading a concatenation of two arrays." << std::endl;
+  typedef dax::cont::ArrayHandleCounting<dax::Id> CountingHandleType;
+  typedef dax::cont::ArrayHandle<dax::Id> BasicHandleType;
+  typedef dax::cont::ArrayHandleConcatenate<CountingHandleType,BasicHandleType>
+      ConcatenateHandleType;
+
+  std::vector<dax::Id> buffer(SECOND_SIZE);
+  for (dax::Id index = 0; index < SECOND_SIZE; index++)
+    {
+    buffer[index] = FIRST_SIZE + index;
+    }
+
+  ConcatenateHandleType concatenate = dax::cont::make_ArrayHandleConcatenate(
+        CountingHandleType(dax::Id(0), FIRST_SIZE),
+        dax::cont::make_ArrayHandle(buffer));
+
+  DAX_TEST_ASSERT(concatenate.GetNumberOfValues() == ARRAY_SIZE,
+                  "Concatenation has wrong number of values.");
+
+  ConcatenateHandleType::PortalConstExecution portal =
+      concatenate.PrepareForInput();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE,
+                  "Concatenation portal has wrong number of values.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == index,
+                    "Concatenation has wrong value.");
+    }
+
+  std::vector<dax::Id> copied(ARRAY_SIZE);
+  concatenate.CopyInto(copied.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(copied[index] == index,
+                    "Concatenation copied wrong value.");
+    }
+
+  std::cout << "Shrinking into the first array." << std::endl;
+  concatenate.Shrink(FIRST_SIZE-1);
+  DAX_TEST_ASSERT(concatenate.GetNumberOfValues() == FIRST_SIZE-1,
+                  "Concatenation has wrong number of values after shrink.");
+  copied.assign(ARRAY_SIZE, -1);
+  concatenate.CopyInto(copied.begin());
+  DAX_TEST_ASSERT(copied[FIRST_SIZE-2] == FIRST_SIZE-2,
+                  "Shrunk concatenation copied wrong value.");
+  DAX_TEST_ASSERT(copied[FIRST_SIZE-1] == -1,
+                  "Shrunk concatenation copied too many values.");
+}
+
+void TestConcatenateDispatch()
+{
+  std::cout << "Using concatenations as worklet input and output."
+            << std::endl;
+  typedef dax::cont::ArrayHandle<dax::Scalar> HandleType;
+
+  std::vector<dax::Scalar> firstBuffer(FIRST_SIZE);
+  std::vector<dax::Scalar> secondBuffer(SECOND_SIZE);
+  for (dax::Id index = 0; index < FIRST_SIZE; index++)
+    {
+    firstBuffer[index] = static_cast<dax::Scalar>(index);
+    }
+  for (dax::Id index = 0; index < SECOND_SIZE; index++)
+    {
+    secondBuffer[index] = static_cast<dax::Scalar>(FIRST_SIZE + index);
+    }
+
+  HandleType firstOut;
+  firstOut.PrepareForOutput(FIRST_SIZE);
+  HandleType secondOut;
+  secondOut.PrepareForOutput(SECOND_SIZE);
+
+  dax::cont::DispatcherMapField<dax::worklet::Square>().Invoke(
+        dax::cont::make_ArrayHandleConcatenate(
+          dax::cont::make_ArrayHandle(firstBuffer),
+          dax::cont::make_ArrayHandle(secondBuffer)),
+        dax::cont::make_ArrayHandleConcatenate(firstOut, secondOut));
+
+  DAX_TEST_ASSERT(firstOut.GetNumberOfValues() == FIRST_SIZE,
+                  "First output array changed size.");
+  DAX_TEST_ASSERT(secondOut.GetNumberOfValues() == SECOND_SIZE,
+                  "Second output array changed size.");
+
+  HandleType::PortalConstControl firstPortal = firstOut.GetPortalConstControl();
+  for (dax::Id index = 0; index < FIRST_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(firstPortal.Get(index),
+                               static_cast<dax::Scalar>(index*index)),
+                    "Got bad value in first output array.");
+    }
+  HandleType::PortalConstControl secondPortal =
+      secondOut.GetPortalConstControl();
+  for (dax::Id index = 0; index < SECOND_SIZE; index++)
+    {
+    const dax::Id value = FIRST_SIZE + index;
+    DAX_TEST_ASSERT(test_equal(secondPortal.Get(index),
+                               static_cast<dax::Scalar>(value*value)),
+                    "Got bad value in second output array.");
+    }
+
+  std::cout << "Checking that a concatenation must match the output size."
+            << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandleConcatenate(firstOut, secondOut)
+        .PrepareForOutput(ARRAY_SIZE+1);
+    DAX_TEST_FAIL("Concatenation did not complain about bad output size.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestArrayHandleConcatenate()
+{
+  TestConcatenateInput();
+  TestConcatenateDispatch();
+}
+
+} // annonymous namespace
+
+int UnitTestArrayHandleConcatenate(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleConcatenate);
+}
@@ -0,0 +1,140 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+//This sets up the ArrayHandle semantics to allocate pointers and share memory
+//between control and execution.
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandleView.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 10;
+const dax::Id VIEW_OFFSET = 3;
+const dax::Id VIEW_SIZE = 5;
+
+void TestViewInput()
+{
+  std::cout << "Reading a view of a counting array." << std::endl;
+  typedef dax::cont::ArrayHandleCounting<dax::Id> CountingHandleType;
+  typedef dax::cont::ArrayHandleView<CountingHandleType> ViewHandleType;
+
+  CountingHandleType counting(dax::Id(0), ARRAY_SIZE);
+  ViewHandleType view =
+      dax::cont::make_ArrayHandleView(counting, VIEW_OFFSET, VIEW_SIZE);
+
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == VIEW_SIZE,
+                  "View has wrong number of values.");
+
+  ViewHandleType::PortalConstExecution portal = view.PrepareForInput();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == VIEW_SIZE,
+                  "View portal has wrong number of values.");
+  for (dax::Id index = 0; index < VIEW_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(portal.Get(index) == VIEW_OFFSET + index,
+                    "View has wrong value.");
+    }
+
+  std::vector<dax::Id> copied(VIEW_SIZE);
+  view.CopyInto(copied.begin());
+  for (dax::Id index = 0; index < VIEW_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(copied[index] == VIEW_OFFSET + index,
+                    "View copied wrong value.");
+    }
+
+  std::cout << "Shrinking the view." << std::endl;
+  view.Shrink(VIEW_SIZE-1);
+  DAX_TEST_ASSERT(view.GetNumberOfValues() == VIEW_SIZE-1,
+                  "View has wrong number of values after shrink.");
+  DAX_TEST_ASSERT(counting.GetNumberOfValues() == ARRAY_SIZE,
+                  "Shrinking view changed the viewed array.");
+}
+
+void TestViewDispatch()
+{
+  std::cout << "Using views as worklet input and output." << std::endl;
+  std::vector<dax::Scalar> inBuffer(ARRAY_SIZE);
+  std::vector<dax::Scalar> outBuffer(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    inBuffer[index] = static_cast<dax::Scalar>(index);
+    outBuffer[index] = -1;
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> inHandle =
+      dax::cont::make_ArrayHandle(inBuffer);
+
+  // Copy the output buffer into an array we own so we can write into it.
+  dax::cont::ArrayHandle<dax::Scalar> outHandle;
+  outHandle.PrepareForOutput(ARRAY_SIZE);
+  std::copy(outBuffer.begin(), outBuffer.end(),
+            outHandle.GetPortalControl().GetIteratorBegin());
+
+  dax::cont::DispatcherMapField<dax::worklet::Square>().Invoke(
+        dax::cont::make_ArrayHandleView(inHandle, VIEW_OFFSET, VIEW_SIZE),
+        dax::cont::make_ArrayHandleView(outHandle, VIEW_OFFSET, VIEW_SIZE));
+
+  dax::cont::ArrayHandle<dax::Scalar>::PortalConstControl portal =
+      outHandle.GetPortalConstControl();
+  DAX_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE,
+                  "Writing into view changed size of array.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    dax::Scalar expected = -1;
+    if ((index >= VIEW_OFFSET) && (index < VIEW_OFFSET + VIEW_SIZE))
+      {
+      expected = static_cast<dax::Scalar>(index*index);
+      }
+    DAX_TEST_ASSERT(test_equal(portal.Get(index), expected),
+                    "Got bad value writing through view.");
+    }
+
+  std::cout << "Checking that a view must match the output size." << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandleView(outHandle, VIEW_OFFSET, VIEW_SIZE)
+        .PrepareForOutput(VIEW_SIZE+1);
+    DAX_TEST_FAIL("View did not complain about bad output size.");
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestArrayHandleView()
+{
+  TestViewInput();
+  TestViewDispatch();
+}
+
+} // annonymous namespace
+
+int UnitTestArrayHandleView(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleView);
+}
@@ -22,6 +22,7 @@
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapterSerial.h>
 #include <dax/cont/DispatcherReduceKeysValues.h>
+#include <dax/cont/ReductionPlan.h>
 
 #include <dax/exec/WorkletReduceKeysValues.h>
 
@@ -162,6 +163,72 @@ void CheckKeyMap(const ArrayType &inputKeys, KeyMapType serialMap)
     }
 }
 
+void CheckReductionPlan(const ArrayType &inputKeys, KeyMapType serialMap)
+{
+  std::cout << "Build a reduction plan" << std::endl;
+  typedef dax::cont::ReductionPlan<ArrayType, DeviceAdapter> PlanType;
+  PlanType plan(inputKeys);
+  DAX_TEST_ASSERT(plan.IsValid(), "Plan not valid after build.");
+  DAX_TEST_ASSERT(plan.GetNumberOfValues() == inputKeys.GetNumberOfValues(),
+                  "Plan has wrong number of values.");
+  DAX_TEST_ASSERT(plan.GetNumberOfReductions() ==
+                  static_cast<dax::Id>(serialMap.size()),
+                  "Plan has wrong number of reductions.");
+
+  ArrayType::PortalConstControl keys =
+      plan.GetReductionKeys().GetPortalConstControl();
+  PlanType::ReductionMapType::PortalConstControl counts =
+      plan.GetReductionCounts().GetPortalConstControl();
+  PlanType::ReductionMapType::PortalConstControl offsets =
+      plan.GetReductionOffsets().GetPortalConstControl();
+  PlanType::ReductionMapType::PortalConstControl indices =
+      plan.GetReductionIndices().GetPortalConstControl();
+  dax::Id reduction = 0;
+  for (KeyMapType::const_iterator serElem = serialMap.begin();
+       serElem != serialMap.end();
+       ++serElem, ++reduction)
+    {
+    DAX_TEST_ASSERT(keys.Get(reduction) == serElem->first, "Bad plan key.");
+    DAX_TEST_ASSERT(counts.Get(reduction) ==
+                    static_cast<dax::Id>(serElem->second.size()),
+                    "Bad plan count.");
+    std::set<dax::Id> group;
+    for (dax::Id index = 0; index < counts.Get(reduction); index++)
+      {
+      group.insert(indices.Get(offsets.Get(reduction) + index));
+      }
+    DAX_TEST_ASSERT(group == serElem->second, "Bad plan indices.");
+    }
+
+  std::cout << "Share the plan between dispatchers" << std::endl;
+  typedef dax::cont::ArrayHandleCounting<dax::Id, DeviceAdapter> CountingHandle;
+  for (int dispatch = 0; dispatch < 2; dispatch++)
+    {
+    TrackReduceWorklet track;
+    dax::cont::DispatcherReduceKeysValues< TrackReduceWorklet,
+          ArrayType, DeviceAdapter > reduceKeyValues(plan, track);
+    reduceKeyValues.Invoke( CountingHandle(0,inputKeys.GetNumberOfValues()) );
+
+    // The worklet records the groups by work id, which is the rank of the
+    // key among the unique keys.
+    const KeyMapType &daxKeyMap = *track.KeyValues.get();
+    DAX_TEST_ASSERT(daxKeyMap.size() == serialMap.size(),
+                    "Shared plan gave wrong number of groups.");
+    KeyMapType::const_iterator serElem = serialMap.begin();
+    for (KeyMapType::const_iterator daxElem = daxKeyMap.begin();
+         daxElem != daxKeyMap.end();
+         ++daxElem, ++serElem)
+      {
+      DAX_TEST_ASSERT(daxElem->second == serElem->second,
+                      "Shared plan gave wrong key map.");
+      }
+    DAX_TEST_ASSERT(plan.IsValid(), "Dispatcher released a shared plan.");
+    }
+
+  plan.ReleaseResources();
+  DAX_TEST_ASSERT(!plan.IsValid(), "Plan still valid after release.");
+}
+
 void RunBuildReductionMap()
 {
   srand(static_cast<unsigned int>(time(NULL)));
@@ -169,6 +236,7 @@ void RunBuildReductionMap()
   ArrayType randomKeyInput = MakeInputArray();
   KeyMapType serialMap = BuildSerialKeyMap(randomKeyInput);
   CheckKeyMap(randomKeyInput, serialMap);
+  CheckReductionPlan(randomKeyInput, serialMap);
 }
 
 } // anonymous namespace
@@ -0,0 +1,141 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/CellLocator.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/exec/ParametricCoordinates.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 6;
+
+struct FindCellWorklet : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, UserObject, FieldOut, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  template<typename LocatorType>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Vector3 &point,
+                  const LocatorType &locator,
+                  dax::Id &cellIndex,
+                  dax::Vector3 &pcoords) const
+  {
+    cellIndex = locator.FindCell(point, pcoords);
+  }
+};
+
+template<typename CellTag>
+void TestCellLocatorForCell()
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+  dax::cont::testing::TestGrid<GridType> grid(DIM);
+
+  std::cout << "Build the cell locator." << std::endl;
+  dax::cont::CellLocator<CellTag> locator(grid.GetRealGrid());
+  DAX_TEST_ASSERT(!locator.IsValid(), "Locator valid before being built.");
+  locator.Build();
+  DAX_TEST_ASSERT(locator.IsValid(), "Locator not valid after being built.");
+  dax::Id3 binDimensions = locator.GetBinDimensions();
+  DAX_TEST_ASSERT((binDimensions[0] > 1) && (binDimensions[1] > 1)
+                  && (binDimensions[2] > 1),
+                  "The grid should be split in every direction.");
+
+  // Query the center of every cell, which is only inside of that cell, and a
+  // couple of points outside of the grid.
+  const dax::Vector3 center = dax::exec::ParametricCoordinates<CellTag>::Center();
+  std::vector<dax::Vector3> queries;
+  for (dax::Id cellIndex = 0; cellIndex < grid->GetNumberOfCells(); cellIndex++)
+    {
+    dax::exec::CellField<dax::Vector3,CellTag> vertexCoordinates(
+          grid.GetCellVertexCoordinates(cellIndex));
+    queries.push_back(dax::exec::ParametricCoordinatesToWorldCoordinates(
+                        vertexCoordinates, center, CellTag()));
+    }
+  queries.push_back(dax::make_Vector3(-1.0, 0.5, 0.5));
+  queries.push_back(dax::make_Vector3(0.5, 0.5, 1000.0));
+
+  std::cout << "Find the cells." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> cellHandle;
+  dax::cont::ArrayHandle<dax::Vector3> pcoordsHandle;
+  dax::cont::DispatcherMapField<FindCellWorklet>().Invoke(
+        dax::cont::make_ArrayHandle(queries),
+        locator.PrepareExecutionObject(),
+        cellHandle,
+        pcoordsHandle);
+
+  std::cout << "Check the cells." << std::endl;
+  DAX_TEST_ASSERT(cellHandle.GetNumberOfValues() == dax::Id(queries.size()),
+                  "Wrong number of results.");
+  for (dax::Id cellIndex = 0; cellIndex < grid->GetNumberOfCells(); cellIndex++)
+    {
+    DAX_TEST_ASSERT(
+          cellHandle.GetPortalConstControl().Get(cellIndex) == cellIndex,
+          "Found the wrong cell.");
+    DAX_TEST_ASSERT(
+          test_equal(pcoordsHandle.GetPortalConstControl().Get(cellIndex),
+                     center),
+          "Wrong parametric coordinates.");
+    }
+  for (dax::Id index = grid->GetNumberOfCells();
+       index < dax::Id(queries.size());
+       index++)
+    {
+    DAX_TEST_ASSERT(cellHandle.GetPortalConstControl().Get(index) == -1,
+                    "Found a cell for a point outside of the grid.");
+    }
+}
+
+void TestCellLocator()
+{
+  std::cout << "*** Hexahedron grid" << std::endl;
+  TestCellLocatorForCell<dax::CellTagHexahedron>();
+  std::cout << "*** Tetrahedron grid" << std::endl;
+  TestCellLocatorForCell<dax::CellTagTetrahedron>();
+  std::cout << "*** Wedge grid" << std::endl;
+  TestCellLocatorForCell<dax::CellTagWedge>();
+
+  std::cout << "Check the locator must be built." << std::endl;
+  bool gotError = false;
+  try
+    {
+    dax::cont::CellLocator<dax::CellTagHexahedron> locator;
+    locator.PrepareExecutionObject();
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Using an unbuilt locator did not fail.");
+}
+
+} // anonymous namespace
+
+int UnitTestCellLocator(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestCellLocator);
+}
@@ -73,6 +73,13 @@ public:
     Algorithm::Schedule(functor, rangeMax);
   }
 
+  template<class Functor>
+  DAX_CONT_EXPORT static void Schedule(Functor functor,
+                                       dax::Id2 rangeMax)
+  {
+    Algorithm::Schedule(functor, rangeMax);
+  }
+
   DAX_CONT_EXPORT static void Synchronize()
   {
     Algorithm::Synchronize();
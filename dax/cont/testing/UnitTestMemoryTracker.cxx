@@ -0,0 +1,153 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/MemoryTracker.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/testing/Testing.h>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+typedef dax::cont::ArrayHandle<dax::Id> IdArrayHandleType;
+
+void TestDisabled()
+{
+  std::cout << "Checking that nothing is recorded when disabled." << std::endl;
+  dax::cont::MemoryTracker::Reset();
+  dax::cont::MemoryTracker::Disable();
+
+  IdArrayHandleType array;
+  array.PrepareForOutput(ARRAY_SIZE);
+
+  DAX_TEST_ASSERT(
+        dax::cont::MemoryTracker::GetStatistics().NumberOfAllocations == 0,
+        "Allocation recorded while the tracker is disabled.");
+  DAX_TEST_ASSERT(dax::cont::MemoryTracker::GetTagStatistics().empty(),
+                  "Call site recorded while the tracker is disabled.");
+}
+
+void TestTotals()
+{
+  std::cout << "Checking current and peak byte counts." << std::endl;
+  dax::cont::MemoryTracker::Reset();
+  dax::cont::MemoryTracker::Enable();
+
+  const std::size_t arrayBytes = ARRAY_SIZE*sizeof(dax::Id);
+  {
+  IdArrayHandleType array1;
+  array1.PrepareForOutput(ARRAY_SIZE);
+  DAX_TEST_ASSERT(
+        dax::cont::MemoryTracker::GetStatistics().CurrentBytes == arrayBytes,
+        "Wrong number of current bytes.");
+
+  {
+  IdArrayHandleType array2;
+  array2.PrepareForOutput(ARRAY_SIZE);
+  }
+
+  const dax::cont::MemoryTracker::Statistics &stats =
+      dax::cont::MemoryTracker::GetStatistics();
+  DAX_TEST_ASSERT(stats.CurrentBytes == arrayBytes,
+                  "Destroyed array not removed from current bytes.");
+  DAX_TEST_ASSERT(stats.PeakBytes == 2*arrayBytes, "Wrong peak bytes.");
+  DAX_TEST_ASSERT(stats.NumberOfAllocations == 2,
+                  "Wrong number of allocations.");
+  DAX_TEST_ASSERT(stats.AllocatedBytes == 2*arrayBytes,
+                  "Wrong number of allocated bytes.");
+  }
+
+  DAX_TEST_ASSERT(dax::cont::MemoryTracker::GetStatistics().CurrentBytes == 0,
+                  "Destroyed arrays not removed from current bytes.");
+
+  dax::cont::MemoryTracker::ResetPeak();
+  DAX_TEST_ASSERT(dax::cont::MemoryTracker::GetStatistics().PeakBytes == 0,
+                  "Peak not reset.");
+  DAX_TEST_ASSERT(
+        dax::cont::MemoryTracker::GetStatistics().NumberOfAllocations == 0,
+        "Allocation count not reset.");
+  DAX_TEST_ASSERT(
+        dax::cont::MemoryTracker::GetStatistics().AllocatedBytes == 0,
+        "Allocated bytes not reset.");
+
+  dax::cont::MemoryTracker::Disable();
+}
+
+void TestScopes()
+{
+  std::cout << "Checking call site names." << std::endl;
+  dax::cont::MemoryTracker::Reset();
+  dax::cont::MemoryTracker::Enable();
+
+  IdArrayHandleType outside;
+  outside.PrepareForOutput(ARRAY_SIZE);
+
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+
+  IdArrayHandleType values;
+  {
+  dax::cont::MemoryTrackerScope scope("TestScopes");
+  Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0), ARRAY_SIZE),
+                  values);
+  Algorithm::Unique(values);
+  }
+
+  const dax::cont::MemoryTracker::TagStatisticsType &tags =
+      dax::cont::MemoryTracker::GetTagStatistics();
+  for (dax::cont::MemoryTracker::TagStatisticsType::const_iterator tag =
+         tags.begin();
+       tag != tags.end();
+       tag++)
+    {
+    std::cout << "  '" << tag->first << "' peak " << tag->second.PeakBytes
+              << " allocations " << tag->second.NumberOfAllocations
+              << std::endl;
+    }
+
+  DAX_TEST_ASSERT(tags.find("") != tags.end(),
+                  "Allocation outside of scope not recorded.");
+  DAX_TEST_ASSERT(tags.find("TestScopes") != tags.end(),
+                  "Allocation in scope not recorded.");
+  DAX_TEST_ASSERT(
+        tags.find("TestScopes/DeviceAdapterAlgorithm::Unique") != tags.end(),
+        "Nested call site not recorded.");
+  DAX_TEST_ASSERT(
+        tags.find("TestScopes")->second.PeakBytes
+        == ARRAY_SIZE*sizeof(dax::Id),
+        "Wrong bytes for scope.");
+
+  dax::cont::MemoryTracker::Disable();
+  dax::cont::MemoryTracker::Reset();
+}
+
+void TestMemoryTracker()
+{
+  TestDisabled();
+  TestTotals();
+  TestScopes();
+}
+
+} // anonymous namespace
+
+int UnitTestMemoryTracker(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestMemoryTracker);
+}
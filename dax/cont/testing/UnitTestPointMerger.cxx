@@ -0,0 +1,211 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/PointMerger.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 4;
+const dax::Scalar TOLERANCE = 0.1f;
+
+// Builds a triangle soup of a DIM x DIM square split in triangles, where
+// every triangle has its own copy of its points. The copies are jittered by
+// much less than the tolerance and sit in the middle of a lattice cell.
+void MakeTriangleSoup(std::vector<dax::Vector3> &points,
+                      std::vector<dax::Id> &connections)
+{
+  for (dax::Id j = 0; j < DIM; j++)
+    {
+    for (dax::Id i = 0; i < DIM; i++)
+      {
+      const dax::Id corners[2][3][2] = {
+        { {i, j}, {i+1, j}, {i+1, j+1} },
+        { {i, j}, {i+1, j+1}, {i, j+1} } };
+      for (int triangle = 0; triangle < 2; triangle++)
+        {
+        for (int vertex = 0; vertex < 3; vertex++)
+          {
+          const dax::Scalar jitter =
+              0.001f*static_cast<dax::Scalar>((points.size()%3)) - 0.001f;
+          connections.push_back(static_cast<dax::Id>(points.size()));
+          points.push_back(dax::make_Vector3(
+              corners[triangle][vertex][0] + 0.05f + jitter,
+              corners[triangle][vertex][1] + 0.05f - jitter,
+              0.05f));
+          }
+        }
+      }
+    }
+}
+
+dax::Id PointValue(const dax::Vector3 &point)
+{
+  return static_cast<dax::Id>(point[0] + 0.5f)
+      + 10*static_cast<dax::Id>(point[1] + 0.5f);
+}
+
+void TestPointMerger()
+{
+  typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> GridType;
+  std::vector<dax::Vector3> points;
+  std::vector<dax::Id> connections;
+  MakeTriangleSoup(points, connections);
+
+  GridType grid;
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+  const dax::Id numberOfCells = grid.GetNumberOfCells();
+
+  std::vector<dax::Id> values;
+  for (std::size_t index = 0; index < points.size(); index++)
+    {
+    values.push_back(PointValue(points[index]));
+    }
+
+  std::cout << "Merge the points." << std::endl;
+  dax::cont::PointMerger<> merger(TOLERANCE);
+  merger.Merge(grid);
+
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == numberOfCells,
+                  "Merging changed the number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == (DIM+1)*(DIM+1),
+                  "Wrong number of merged points.");
+  DAX_TEST_ASSERT(merger.GetNumberOfMergedPoints() == (DIM+1)*(DIM+1),
+                  "Wrong number of merged point ids.");
+  DAX_TEST_ASSERT(merger.GetPointMap().GetNumberOfValues()
+                  == dax::Id(points.size()),
+                  "Point map has the wrong size.");
+
+  std::cout << "Check the connections." << std::endl;
+  std::vector<dax::Id> mergedConnections(connections.size());
+  grid.GetCellConnections().CopyInto(mergedConnections.begin());
+  for (std::size_t index = 0; index < connections.size(); index++)
+    {
+    const dax::Vector3 merged =
+        grid.ComputePointCoordinates(mergedConnections[index]);
+    const dax::Vector3 expected = points[connections[index]];
+    DAX_TEST_ASSERT(dax::dot(merged - expected, merged - expected)
+                    < TOLERANCE*TOLERANCE,
+                    "Merged point moved too far.");
+    }
+  for (std::size_t index = 0; index < mergedConnections.size(); index += 3)
+    {
+    DAX_TEST_ASSERT((mergedConnections[index] != mergedConnections[index+1])
+                    && (mergedConnections[index] != mergedConnections[index+2])
+                    && (mergedConnections[index+1] != mergedConnections[index+2]),
+                    "Merging collapsed a triangle.");
+    }
+
+  std::cout << "Check compacting a point field." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> mergedValues;
+  merger.CompactPointField(dax::cont::make_ArrayHandle(values), mergedValues);
+  DAX_TEST_ASSERT(mergedValues.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Compacted field has the wrong size.");
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(mergedValues.GetPortalConstControl().Get(index)
+                    == PointValue(grid.ComputePointCoordinates(index)),
+                    "Compacted field does not match the merged points.");
+    }
+
+  std::cout << "Check a bad tolerance." << std::endl;
+  bool gotError = false;
+  try
+    {
+    merger.SetTolerance(0);
+    merger.Merge(grid);
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Merging with zero tolerance did not fail.");
+}
+
+// Points far from the origin, where the lattice coordinates counted from the
+// origin would not fit in a 32-bit dax::Id at the default tolerance.
+void TestPointMergerLargeCoordinates()
+{
+  typedef dax::cont::UnstructuredGrid<dax::CellTagTriangle> GridType;
+  const dax::Vector3 offset = dax::make_Vector3(100000, -100000, 50000);
+  std::vector<dax::Vector3> points;
+  std::vector<dax::Id> connections;
+  MakeTriangleSoup(points, connections);
+  for (std::size_t index = 0; index < points.size(); index++)
+    {
+    // Drop the jitter, which is below the precision of the coordinates.
+    points[index] = dax::make_Vector3(
+          static_cast<dax::Id>(points[index][0] + 0.5f),
+          static_cast<dax::Id>(points[index][1] + 0.5f),
+          0) + offset;
+    }
+
+  GridType grid;
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+
+  std::cout << "Merge points far from the origin." << std::endl;
+  dax::cont::PointMerger<> merger;
+  merger.Merge(grid);
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == (DIM+1)*(DIM+1),
+                  "Wrong number of merged points far from the origin.");
+  std::vector<dax::Id> mergedConnections(connections.size());
+  grid.GetCellConnections().CopyInto(mergedConnections.begin());
+  for (std::size_t index = 0; index < connections.size(); index++)
+    {
+    DAX_TEST_ASSERT(test_equal(
+                      grid.ComputePointCoordinates(mergedConnections[index]),
+                      points[connections[index]]),
+                    "Merged point far from the origin moved.");
+    }
+
+  std::cout << "Check bounds too large for the tolerance." << std::endl;
+  points[0] = dax::make_Vector3(1e25f, 0, 0);
+  grid.SetPointCoordinates(dax::cont::make_ArrayHandle(points));
+  grid.SetCellConnections(dax::cont::make_ArrayHandle(connections));
+  bool gotError = false;
+  try
+    {
+    merger.Merge(grid);
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Merging overflowing lattice keys did not fail.");
+}
+
+void TestPointMergers()
+{
+  TestPointMerger();
+  TestPointMergerLargeCoordinates();
+}
+
+} // anonymous namespace
+
+int UnitTestPointMerger(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestPointMergers);
+}
@@ -0,0 +1,179 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/RectilinearGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIMX = 4;
+const dax::Id DIMY = 5;
+const dax::Id DIMZ = 6;
+
+// Build axes with non-uniform spacing so that the coordinates cannot be
+// mistaken for those of a uniform grid.
+std::vector<dax::Scalar> MakeAxis(dax::Id size, dax::Scalar start)
+{
+  std::vector<dax::Scalar> axis(size);
+  for (dax::Id i = 0; i < size; i++)
+    {
+    axis[i] = start + static_cast<dax::Scalar>(i*i) * 0.5f;
+    }
+  return axis;
+}
+
+void TestRectilinearGrid()
+{
+  typedef dax::cont::RectilinearGrid<> GridType;
+
+  std::vector<dax::Scalar> xAxis = MakeAxis(DIMX, -1.0f);
+  std::vector<dax::Scalar> yAxis = MakeAxis(DIMY, 0.0f);
+  std::vector<dax::Scalar> zAxis = MakeAxis(DIMZ, 2.0f);
+
+  GridType grid(dax::cont::make_ArrayHandle(xAxis),
+                dax::cont::make_ArrayHandle(yAxis),
+                dax::cont::make_ArrayHandle(zAxis));
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIMX-1)*(DIMY-1)*(DIMZ-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIMX*DIMY*DIMZ,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetExtent().Max == dax::make_Id3(DIMX-1,DIMY-1,DIMZ-1),
+                  "Wrong extent.");
+
+  std::cout << "Test point indices and coordinates." << std::endl;
+  dax::Id index = 0;
+  dax::Id3 ijk;
+  for (ijk[2] = 0; ijk[2] < DIMZ; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIMY; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIMX; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputePointIndex(ijk) == index,
+                        "Unexpected point index.");
+        DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ijk,
+                        "Unexpected point location.");
+        dax::Vector3 expected =
+            dax::make_Vector3(xAxis[ijk[0]], yAxis[ijk[1]], zAxis[ijk[2]]);
+        DAX_TEST_ASSERT(test_equal(grid.ComputePointCoordinates(index),
+                                   expected),
+                        "Unexpected point coordinates.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test cell indices." << std::endl;
+  index = 0;
+  for (ijk[2] = 0; ijk[2] < DIMZ-1; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIMY-1; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIMX-1; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputeCellIndex(ijk) == index,
+                        "Unexpected cell index.");
+        DAX_TEST_ASSERT(grid.ComputeCellLocation(index) == ijk,
+                        "Unexpected cell location.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test point coordinates portal." << std::endl;
+  GridType::PointCoordinatesType coords = grid.GetPointCoordinates();
+  DAX_TEST_ASSERT(coords.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Wrong number of point coordinates.");
+  GridType::PointCoordinatesType::PortalConstControl coordsPortal =
+      coords.GetPortalConstControl();
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    dax::Vector3 gridCoords = grid.ComputePointCoordinates(index);
+    dax::Vector3 portalCoords = coordsPortal.Get(index);
+    DAX_TEST_ASSERT(gridCoords == portalCoords,
+                    "Point coordinates seem wrong.");
+    }
+
+  std::cout << "Test point coordinates in execution environment." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> copiedCoords;
+  dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        coords, copiedCoords);
+  DAX_TEST_ASSERT(copiedCoords.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Wrong number of copied point coordinates.");
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(copiedCoords.GetPortalConstControl().Get(index)
+                    == grid.ComputePointCoordinates(index),
+                    "Point coordinates wrong in execution environment.");
+    }
+
+  bool gotError = false;
+  try
+    {
+    coords.PrepareForOutput(10);
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Point coordinates should be read-only.");
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  GridType::TopologyStructConstExecution topology = grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.GetNumberOfPoints() == grid.GetNumberOfPoints(),
+                  "Topology has wrong number of points.");
+  DAX_TEST_ASSERT(topology.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Topology has wrong number of cells.");
+
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(topology.GetPointCoordiantes(index)
+                    == grid.ComputePointCoordinates(index),
+                    "Topology point coordinates wrong.");
+    }
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+        topology.GetCellConnections(index);
+    dax::Id3 cellLocation = grid.ComputeCellLocation(index);
+    DAX_TEST_ASSERT(vertices[0] == grid.ComputePointIndex(cellLocation),
+                    "Bad first cell vertex.");
+    DAX_TEST_ASSERT(vertices[6] == grid.ComputePointIndex(
+                      cellLocation + dax::make_Id3(1,1,1)),
+                    "Bad last cell vertex.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestRectilinearGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestRectilinearGrid);
+}
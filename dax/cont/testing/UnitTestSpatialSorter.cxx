@@ -0,0 +1,143 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/SpatialSorter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/cont/internal/ComputeBounds.h>
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 6;
+
+template<typename CellTag>
+void TestSpatialSorterForCell()
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  dax::cont::testing::TestGrid<GridType> testGrid(DIM);
+  const GridType original = testGrid.GetRealGrid();
+  GridType grid = original;
+
+  std::cout << "Sort the grid." << std::endl;
+  dax::cont::SpatialSorter<> sorter;
+  sorter.Sort(grid);
+
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == original.GetNumberOfPoints(),
+                  "Sorting changed the number of points.");
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == original.GetNumberOfCells(),
+                  "Sorting changed the number of cells.");
+
+  std::cout << "Check the point order." << std::endl;
+  const dax::Id numberOfPoints = grid.GetNumberOfPoints();
+  std::vector<dax::Id> pointPermutation(numberOfPoints);
+  sorter.GetPointPermutation().CopyInto(pointPermutation.begin());
+  std::vector<bool> pointUsed(numberOfPoints, false);
+  dax::Vector3 minBounds;
+  dax::Vector3 maxBounds;
+  dax::cont::internal::ComputeBounds(original.GetPointCoordinates(),
+                                     minBounds,
+                                     maxBounds);
+  const dax::exec::internal::kernel::MortonCodeOfCoordinates
+      mortonCode(minBounds, maxBounds);
+  dax::Id previousCode = 0;
+  for (dax::Id index = 0; index < numberOfPoints; index++)
+    {
+    const dax::Id oldIndex = pointPermutation[index];
+    DAX_TEST_ASSERT(!pointUsed[oldIndex], "Point used twice.");
+    pointUsed[oldIndex] = true;
+    const dax::Vector3 coordinates = grid.ComputePointCoordinates(index);
+    DAX_TEST_ASSERT(
+          test_equal(coordinates, original.ComputePointCoordinates(oldIndex)),
+          "Point permutation does not match the coordinates.");
+    const dax::Id code = mortonCode(coordinates);
+    DAX_TEST_ASSERT(code >= previousCode, "Points not in Morton order.");
+    previousCode = code;
+    }
+
+  std::cout << "Check the cells." << std::endl;
+  const dax::Id numberOfCells = grid.GetNumberOfCells();
+  std::vector<dax::Id> cellPermutation(numberOfCells);
+  sorter.GetCellPermutation().CopyInto(cellPermutation.begin());
+  std::vector<dax::Id> connections(numberOfCells*NUM_VERTICES);
+  grid.GetCellConnections().CopyInto(connections.begin());
+  std::vector<dax::Id> originalConnections(numberOfCells*NUM_VERTICES);
+  original.GetCellConnections().CopyInto(originalConnections.begin());
+  std::vector<bool> cellUsed(numberOfCells, false);
+  for (dax::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+    {
+    const dax::Id oldCellIndex = cellPermutation[cellIndex];
+    DAX_TEST_ASSERT(!cellUsed[oldCellIndex], "Cell used twice.");
+    cellUsed[oldCellIndex] = true;
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++)
+      {
+      DAX_TEST_ASSERT(
+            test_equal(
+              grid.ComputePointCoordinates(
+                connections[cellIndex*NUM_VERTICES + vertex]),
+              original.ComputePointCoordinates(
+                originalConnections[oldCellIndex*NUM_VERTICES + vertex])),
+            "Cell vertices do not match.");
+      }
+    }
+
+  std::cout << "Check reordering fields." << std::endl;
+  dax::cont::ArrayHandle<dax::Id> pointField;
+  sorter.ReorderPointField(
+        dax::cont::make_ArrayHandleCounting(dax::Id(0), numberOfPoints),
+        pointField);
+  dax::cont::ArrayHandle<dax::Id> cellField;
+  sorter.ReorderCellField(
+        dax::cont::make_ArrayHandleCounting(dax::Id(0), numberOfCells),
+        cellField);
+  for (dax::Id index = 0; index < numberOfPoints; index++)
+    {
+    DAX_TEST_ASSERT(pointField.GetPortalConstControl().Get(index)
+                    == pointPermutation[index],
+                    "Bad reordered point field.");
+    }
+  for (dax::Id index = 0; index < numberOfCells; index++)
+    {
+    DAX_TEST_ASSERT(cellField.GetPortalConstControl().Get(index)
+                    == cellPermutation[index],
+                    "Bad reordered cell field.");
+    }
+}
+
+void TestSpatialSorter()
+{
+  std::cout << "*** Hexahedron grid" << std::endl;
+  TestSpatialSorterForCell<dax::CellTagHexahedron>();
+  std::cout << "*** Tetrahedron grid" << std::endl;
+  TestSpatialSorterForCell<dax::CellTagTetrahedron>();
+  std::cout << "*** Triangle grid" << std::endl;
+  TestSpatialSorterForCell<dax::CellTagTriangle>();
+}
+
+} // anonymous namespace
+
+int UnitTestSpatialSorter(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestSpatialSorter);
+}
@@ -0,0 +1,148 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/StructuredGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/math/Trig.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id3 MIN_EXTENT = dax::make_Id3(-1, 2, 0);
+const dax::Id3 MAX_EXTENT = dax::make_Id3(3, 5, 5);
+
+// A curvilinear mapping of the i, j, k indices to part of a cylindrical shell.
+dax::Vector3 WarpedCoordinates(const dax::Id3 &ijk)
+{
+  const dax::Scalar radius = 2.0f + 0.5f*static_cast<dax::Scalar>(ijk[0]);
+  const dax::Scalar angle = 0.2f*static_cast<dax::Scalar>(ijk[1]);
+  return dax::make_Vector3(radius*dax::math::Cos(angle),
+                           radius*dax::math::Sin(angle),
+                           static_cast<dax::Scalar>(ijk[2]));
+}
+
+void TestStructuredGrid()
+{
+  typedef dax::cont::StructuredGrid<> GridType;
+
+  const dax::Extent3 extent(MIN_EXTENT, MAX_EXTENT);
+  const dax::Id3 dims = dax::extentDimensions(extent);
+
+  std::vector<dax::Vector3> points;
+  dax::Id3 ijk;
+  for (ijk[2] = MIN_EXTENT[2]; ijk[2] <= MAX_EXTENT[2]; ijk[2]++)
+    {
+    for (ijk[1] = MIN_EXTENT[1]; ijk[1] <= MAX_EXTENT[1]; ijk[1]++)
+      {
+      for (ijk[0] = MIN_EXTENT[0]; ijk[0] <= MAX_EXTENT[0]; ijk[0]++)
+        {
+        points.push_back(WarpedCoordinates(ijk));
+        }
+      }
+    }
+
+  GridType grid(extent, dax::cont::make_ArrayHandle(points));
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == dims[0]*dims[1]*dims[2],
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() ==
+                  (dims[0]-1)*(dims[1]-1)*(dims[2]-1),
+                  "Wrong number of cells.");
+
+  std::cout << "Test point indices and coordinates." << std::endl;
+  dax::Id index = 0;
+  for (ijk[2] = MIN_EXTENT[2]; ijk[2] <= MAX_EXTENT[2]; ijk[2]++)
+    {
+    for (ijk[1] = MIN_EXTENT[1]; ijk[1] <= MAX_EXTENT[1]; ijk[1]++)
+      {
+      for (ijk[0] = MIN_EXTENT[0]; ijk[0] <= MAX_EXTENT[0]; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputePointIndex(ijk) == index,
+                        "Unexpected point index.");
+        DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ijk,
+                        "Unexpected point location.");
+        DAX_TEST_ASSERT(grid.ComputePointCoordinates(ijk)
+                        == WarpedCoordinates(ijk),
+                        "Unexpected point coordinates.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test cell indices." << std::endl;
+  index = 0;
+  for (ijk[2] = MIN_EXTENT[2]; ijk[2] < MAX_EXTENT[2]; ijk[2]++)
+    {
+    for (ijk[1] = MIN_EXTENT[1]; ijk[1] < MAX_EXTENT[1]; ijk[1]++)
+      {
+      for (ijk[0] = MIN_EXTENT[0]; ijk[0] < MAX_EXTENT[0]; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputeCellIndex(ijk) == index,
+                        "Unexpected cell index.");
+        DAX_TEST_ASSERT(grid.ComputeCellLocation(index) == ijk,
+                        "Unexpected cell location.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  GridType::TopologyStructConstExecution topology = grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.GetNumberOfPoints() == grid.GetNumberOfPoints(),
+                  "Topology has wrong number of points.");
+  DAX_TEST_ASSERT(topology.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Topology has wrong number of cells.");
+
+  const dax::Id3 cellVertexToPointIndex[8] = {
+    dax::make_Id3(0, 0, 0),
+    dax::make_Id3(1, 0, 0),
+    dax::make_Id3(1, 1, 0),
+    dax::make_Id3(0, 1, 0),
+    dax::make_Id3(0, 0, 1),
+    dax::make_Id3(1, 0, 1),
+    dax::make_Id3(1, 1, 1),
+    dax::make_Id3(0, 1, 1)
+  };
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::exec::CellVertices<dax::CellTagHexahedron> vertices =
+        topology.GetCellConnections(index);
+    dax::Id3 cellLocation = grid.ComputeCellLocation(index);
+    for (int vertex = 0; vertex < 8; vertex++)
+      {
+      DAX_TEST_ASSERT(vertices[vertex] == grid.ComputePointIndex(
+                        cellLocation + cellVertexToPointIndex[vertex]),
+                      "Bad cell vertex.");
+      }
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestStructuredGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestStructuredGrid);
+}
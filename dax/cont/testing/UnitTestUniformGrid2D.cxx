@@ -0,0 +1,125 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/UniformGrid2D.h>
+
+#include <dax/cont/testing/Testing.h>
+
+namespace {
+
+void TestUniformGrid2D()
+{
+  const dax::Id DIMX = 5;
+  const dax::Id DIMY = 7;
+
+  dax::cont::UniformGrid2D<> grid;
+  grid.SetExtent(dax::Id2(-1, 2), dax::Id2(DIMX-2, DIMY+1));
+  grid.SetOrigin(dax::make_Vector3(0.5, -1.0, 4.0));
+  grid.SetSpacing(dax::make_Vector2(2.0, 0.25));
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIMX-1)*(DIMY-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIMX*DIMY,
+                  "Wrong number of points.");
+
+  std::cout << "Test point indices." << std::endl;
+  dax::Id index = 0;
+  dax::Id2 ij;
+  for (ij[1] = 2; ij[1] < DIMY+2; ij[1]++)
+    {
+    for (ij[0] = -1; ij[0] < DIMX-1; ij[0]++)
+      {
+      DAX_TEST_ASSERT(grid.ComputePointIndex(ij) == index,
+                      "Unexpected point index.");
+      DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ij,
+                      "Unexpected point location.");
+      index++;
+      }
+    }
+
+  std::cout << "Test cell indices." << std::endl;
+  index = 0;
+  for (ij[1] = 2; ij[1] < DIMY+1; ij[1]++)
+    {
+    for (ij[0] = -1; ij[0] < DIMX-2; ij[0]++)
+      {
+      DAX_TEST_ASSERT(grid.ComputeCellIndex(ij) == index,
+                      "Unexpected cell index.");
+      DAX_TEST_ASSERT(grid.ComputeCellLocation(index) == ij,
+                      "Unexpected cell location.");
+      index++;
+      }
+    }
+
+  std::cout << "Test point coordinates portal." << std::endl;
+  dax::cont::UniformGrid2D<>::PointCoordinatesType coords =
+      grid.GetPointCoordinates();
+  dax::cont::UniformGrid2D<>::PointCoordinatesType::PortalConstControl
+      coordsPortal = coords.GetPortalConstControl();
+  DAX_TEST_ASSERT(coordsPortal.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Wrong number of point coordinates.");
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    dax::Vector3 gridCoords = grid.ComputePointCoordinates(index);
+    dax::Vector3 portalCoords = coordsPortal.Get(index);
+    DAX_TEST_ASSERT(gridCoords == portalCoords,
+                    "Point coordinates seem wrong.");
+    DAX_TEST_ASSERT(gridCoords[2] == grid.GetOrigin()[2],
+                    "Point is not in the image plane.");
+    }
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  dax::cont::UniformGrid2D<>::TopologyStructConstExecution topology =
+      grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Origin == grid.GetOrigin(),
+                  "Topology origin wrong.");
+  DAX_TEST_ASSERT(topology.Spacing == grid.GetSpacing(),
+                  "Topology spacing wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+
+  std::cout << "Test cell connections" << std::endl;
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::Id2 cellLocation = grid.ComputeCellLocation(index);
+    dax::exec::CellVertices<dax::CellTagQuadrilateral> connections =
+        topology.GetCellConnections(index);
+    DAX_TEST_ASSERT(connections[0] == grid.ComputePointIndex(cellLocation),
+                    "Bad first point of cell.");
+    DAX_TEST_ASSERT(
+          connections[1] ==
+          grid.ComputePointIndex(cellLocation + dax::Id2(1, 0)),
+          "Bad second point of cell.");
+    DAX_TEST_ASSERT(
+          connections[2] ==
+          grid.ComputePointIndex(cellLocation + dax::Id2(1, 1)),
+          "Bad third point of cell.");
+    DAX_TEST_ASSERT(
+          connections[3] ==
+          grid.ComputePointIndex(cellLocation + dax::Id2(0, 1)),
+          "Bad fourth point of cell.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestUniformGrid2D(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestUniformGrid2D);
+}
@@ -16,6 +16,9 @@
 
 #include <dax/cont/UnstructuredGrid.h>
 
+#include <dax/cont/ArrayHandleCompact.h>
+#include <dax/cont/DeviceAdapter.h>
+
 #include <dax/CellTag.h>
 #include <dax/CellTraits.h>
 
@@ -56,6 +59,85 @@ void TestUnstructuredGrid()
     DAX_TEST_ASSERT(connections.Get(index)==topology.CellConnections.Get(index),
                     "Bad connection.");
     }
+
+  std::cout << "Test point to cell links." << std::endl;
+  DAX_TEST_ASSERT(!grid.GetPointToCellLinks().IsValid(),
+                  "Links should not be built until requested.");
+  const GridType::PointToCellLinksType &links = grid.BuildPointToCellLinks();
+  DAX_TEST_ASSERT(links.IsValid(), "Links not built.");
+  DAX_TEST_ASSERT(links.GetNumberOfPoints() == grid.GetNumberOfPoints(),
+                  "Links have wrong number of points.");
+  DAX_TEST_ASSERT(links.GetCellIds().GetNumberOfValues() ==
+                  connections.GetNumberOfValues(),
+                  "Links have wrong number of cell ids.");
+
+  GridType::PointToCellLinksType::LinksArrayType::PortalConstControl counts =
+      links.GetCounts().GetPortalConstControl();
+  GridType::PointToCellLinksType::LinksArrayType::PortalConstControl offsets =
+      links.GetOffsets().GetPortalConstControl();
+  GridType::PointToCellLinksType::LinksArrayType::PortalConstControl cellIds =
+      links.GetCellIds().GetPortalConstControl();
+  const dax::Id NUM_VERTICES =
+      dax::CellTraits<dax::CellTagHexahedron>::NUM_VERTICES;
+  dax::Id expectedOffset = 0;
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    DAX_TEST_ASSERT(offsets.Get(pointIndex) == expectedOffset,
+                    "Bad link offset.");
+    dax::Id expectedCount = 0;
+    for (dax::Id index = 0; index < connections.GetNumberOfValues(); index++)
+      {
+      if (connections.Get(index) == pointIndex) { expectedCount++; }
+      }
+    DAX_TEST_ASSERT(counts.Get(pointIndex) == expectedCount,
+                    "Bad link count.");
+    for (dax::Id linkIndex = 0; linkIndex < expectedCount; linkIndex++)
+      {
+      const dax::Id cellIndex = cellIds.Get(expectedOffset + linkIndex);
+      bool cellHasPoint = false;
+      for (dax::Id vertex = 0; vertex < NUM_VERTICES; vertex++)
+        {
+        cellHasPoint |=
+            (connections.Get(cellIndex*NUM_VERTICES + vertex) == pointIndex);
+        }
+      DAX_TEST_ASSERT(cellHasPoint, "Linked cell does not use point.");
+      }
+    expectedOffset += expectedCount;
+    }
+
+  grid.SetCellConnections(grid.GetCellConnections());
+  DAX_TEST_ASSERT(!grid.GetPointToCellLinks().IsValid(),
+                  "Links not discarded with new connections.");
+
+  std::cout << "Test 32-bit connections." << std::endl;
+  typedef dax::cont::UnstructuredGrid<
+      dax::CellTagHexahedron,
+      dax::cont::ArrayContainerControlCompactId<
+          dax::internal::Int32Type>::ArrayContainerControlTag> CompactGridType;
+  CompactGridType::CellConnectionsType compactConnections;
+  dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        grid.GetCellConnections(), compactConnections);
+  CompactGridType compactGrid(compactConnections, grid.GetPointCoordinates());
+  DAX_TEST_ASSERT(compactGrid.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Compact grid has wrong number of cells.");
+
+  CompactGridType::TopologyStructConstExecution compactTopology =
+      compactGrid.PrepareForInput();
+  for (dax::Id index = 0; index < connections.GetNumberOfValues(); index++)
+    {
+    DAX_TEST_ASSERT(connections.Get(index) ==
+                    static_cast<dax::Id>(
+                      compactTopology.CellConnections.Get(index)),
+                    "Bad compact connection.");
+    }
+
+  const CompactGridType::PointToCellLinksType &compactLinks =
+      compactGrid.BuildPointToCellLinks();
+  DAX_TEST_ASSERT(compactLinks.GetCellIds().GetNumberOfValues() ==
+                  connections.GetNumberOfValues(),
+                  "Compact links have wrong number of cell ids.");
 }
 
 } // anonymous namespace
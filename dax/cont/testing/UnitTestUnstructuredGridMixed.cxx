@@ -0,0 +1,120 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/UnstructuredGridMixed.h>
+
+#include <dax/cont/ArrayHandle.h>
+
+#include <dax/cont/testing/Testing.h>
+#include <dax/cont/testing/TestingGridGenerator.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 4;
+
+template<class CellTag, class GridType>
+void CheckCellsOfType(const GridType &grid)
+{
+  typename GridType::template TopologyOfCell<CellTag>::type topology =
+      grid.template PrepareForInput<CellTag>();
+  DAX_TEST_ASSERT(topology.GetNumberOfPoints() == grid.GetNumberOfPoints(),
+                  "Topology has wrong number of points.");
+  DAX_TEST_ASSERT(topology.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Topology has wrong number of cells.");
+
+  const dax::Id shape = dax::CellTraits<CellTag>::CELL_SHAPE;
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  dax::Id numberOfCellsOfType = 0;
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    if (grid.GetShapes().GetPortalConstControl().Get(cellIndex) != shape)
+      {
+      continue;
+      }
+    numberOfCellsOfType++;
+
+    const dax::Id offset =
+        grid.GetOffsets().GetPortalConstControl().Get(cellIndex);
+    dax::exec::CellVertices<CellTag> vertices =
+        topology.GetCellConnections(cellIndex);
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++)
+      {
+      DAX_TEST_ASSERT(vertices[vertex] ==
+                      grid.GetCellConnections().GetPortalConstControl()
+                      .Get(offset + vertex),
+                      "Bad cell vertex.");
+      }
+    }
+  DAX_TEST_ASSERT(numberOfCellsOfType > 0, "No cells of expected type.");
+}
+
+void TestUnstructuredGridMixed()
+{
+  typedef dax::cont::UnstructuredGridMixed<> GridType;
+  GridType grid = dax::cont::testing::MakeMixedGrid(
+        DIM, DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIM*DIM*DIM,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIM-1)*(DIM-1)*(DIM-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetOffsets().GetNumberOfValues()
+                  == grid.GetNumberOfCells(),
+                  "Wrong number of offsets.");
+
+  std::cout << "Test offsets." << std::endl;
+  dax::Id expectedOffset = 0;
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    DAX_TEST_ASSERT(grid.GetOffsets().GetPortalConstControl().Get(cellIndex)
+                    == expectedOffset,
+                    "Unexpected offset.");
+    switch (grid.GetShapes().GetPortalConstControl().Get(cellIndex))
+      {
+      case dax::CellTraits<dax::CellTagHexahedron>::CELL_SHAPE:
+        expectedOffset += 8;
+        break;
+      case dax::CellTraits<dax::CellTagWedge>::CELL_SHAPE:
+        expectedOffset += 6;
+        break;
+      case dax::CellTraits<dax::CellTagTetrahedron>::CELL_SHAPE:
+        expectedOffset += 4;
+        break;
+      default:
+        DAX_TEST_FAIL("Unexpected cell shape.");
+      }
+    }
+  DAX_TEST_ASSERT(grid.GetCellConnections().GetNumberOfValues()
+                  == expectedOffset,
+                  "Wrong number of cell connections.");
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  CheckCellsOfType<dax::CellTagHexahedron>(grid);
+  CheckCellsOfType<dax::CellTagWedge>(grid);
+  CheckCellsOfType<dax::CellTagTetrahedron>(grid);
+}
+
+} // anonymous namespace
+
+int UnitTestUnstructuredGridMixed(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestUnstructuredGridMixed);
+}
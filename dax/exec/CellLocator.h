@@ -0,0 +1,256 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_CellLocator_h
+#define __dax_exec_CellLocator_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellField.h>
+#include <dax/exec/ExecutionObjectBase.h>
+#include <dax/exec/ParametricCoordinates.h>
+
+#include <dax/math/Compare.h>
+#include <dax/math/Precision.h>
+
+#include <boost/static_assert.hpp>
+
+namespace dax {
+namespace exec {
+
+namespace internal {
+
+/// Describes the regular grid of bins used by dax::exec::CellLocator. The bins
+/// cover the bounds of the points of the located grid.
+///
+struct CellLocatorBins
+{
+  dax::Vector3 Origin;
+  dax::Vector3 InverseBinSize;
+  dax::Id3 Dimensions;
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfBins() const {
+    return this->Dimensions[0]*this->Dimensions[1]*this->Dimensions[2];
+  }
+
+  /// Returns the i, j, k location of the bin containing the given point,
+  /// clamped to the bins.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id3 FindBinClamped(const dax::Vector3 &point) const {
+    const dax::Vector3 binCoords =
+        dax::math::Floor((point - this->Origin) * this->InverseBinSize);
+    dax::Id3 bin;
+    for (int dim = 0; dim < 3; dim++)
+      {
+      const dax::Id index = static_cast<dax::Id>(binCoords[dim]);
+      bin[dim] = (index < 0) ? 0 :
+          ((index >= this->Dimensions[dim]) ? this->Dimensions[dim]-1 : index);
+      }
+    return bin;
+  }
+
+  /// Returns the flat index of the bin containing the given point or -1 if
+  /// the point is outside of the bins.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id FindBin(const dax::Vector3 &point) const {
+    const dax::Vector3 binCoords =
+        dax::math::Floor((point - this->Origin) * this->InverseBinSize);
+    dax::Id3 bin;
+    for (int dim = 0; dim < 3; dim++)
+      {
+      bin[dim] = static_cast<dax::Id>(binCoords[dim]);
+      // Points exactly on the upper bound belong to the last bin.
+      if (bin[dim] == this->Dimensions[dim]
+          && point[dim] <= this->Origin[dim]
+                           + this->Dimensions[dim]/this->InverseBinSize[dim])
+        {
+        bin[dim]--;
+        }
+      if ((bin[dim] < 0) || (bin[dim] >= this->Dimensions[dim])) { return -1; }
+      }
+    return this->GetBinIndex(bin);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetBinIndex(const dax::Id3 &bin) const {
+    return bin[0] + this->Dimensions[0]*(bin[1] + this->Dimensions[1]*bin[2]);
+  }
+};
+
+/// Returns true if the parametric coordinates are inside the canonical cell
+/// (within a small tolerance to accept points on shared faces).
+///
+DAX_EXEC_EXPORT
+bool ParametricCoordinatesInCell(const dax::Vector3 &pcoords,
+                                 dax::CellTagHexahedron)
+{
+  const dax::Scalar tolerance = dax::Scalar(1e-4);
+  return (pcoords[0] >= -tolerance) && (pcoords[0] <= 1 + tolerance) &&
+         (pcoords[1] >= -tolerance) && (pcoords[1] <= 1 + tolerance) &&
+         (pcoords[2] >= -tolerance) && (pcoords[2] <= 1 + tolerance);
+}
+
+DAX_EXEC_EXPORT
+bool ParametricCoordinatesInCell(const dax::Vector3 &pcoords,
+                                 dax::CellTagWedge)
+{
+  const dax::Scalar tolerance = dax::Scalar(1e-4);
+  return (pcoords[0] >= -tolerance) && (pcoords[1] >= -tolerance) &&
+         (pcoords[0] + pcoords[1] <= 1 + tolerance) &&
+         (pcoords[2] >= -tolerance) && (pcoords[2] <= 1 + tolerance);
+}
+
+DAX_EXEC_EXPORT
+bool ParametricCoordinatesInCell(const dax::Vector3 &pcoords,
+                                 dax::CellTagTetrahedron)
+{
+  const dax::Scalar tolerance = dax::Scalar(1e-4);
+  return (pcoords[0] >= -tolerance) && (pcoords[1] >= -tolerance) &&
+         (pcoords[2] >= -tolerance) &&
+         (pcoords[0] + pcoords[1] + pcoords[2] <= 1 + tolerance);
+}
+
+} // namespace internal
+
+/// \brief Finds the cell of an unstructured grid containing a point.
+///
+/// The cells are sorted into a regular grid of bins that covers the grid
+/// bounds. Each bin lists the cells whose bounding box overlaps it, so a query
+/// only tests the few cells in the bin of the point. CellLocator is an
+/// execution object, so it can be passed to a worklet as a \c UserObject. It
+/// is created in the control environment by dax::cont::CellLocator.
+///
+/// Only cells with three topological dimensions are supported.
+///
+template<class CellTag,
+         class ConnectionsPortalType,
+         class CoordinatesPortalType,
+         class IdPortalType>
+class CellLocator : public dax::exec::ExecutionObjectBase
+{
+  BOOST_STATIC_ASSERT(dax::CellTraits<CellTag>::TOPOLOGICAL_DIMENSIONS == 3);
+  typedef typename dax::CellTraits<CellTag>::CanonicalCellTag CanonicalCellTag;
+
+public:
+  DAX_EXEC_CONT_EXPORT
+  CellLocator() {  }
+
+  DAX_CONT_EXPORT
+  CellLocator(const ConnectionsPortalType &connections,
+              const CoordinatesPortalType &coordinates,
+              const IdPortalType &binCounts,
+              const IdPortalType &binOffsets,
+              const IdPortalType &binCellIds,
+              const dax::exec::internal::CellLocatorBins &bins)
+    : Connections(connections),
+      Coordinates(coordinates),
+      BinCounts(binCounts),
+      BinOffsets(binOffsets),
+      BinCellIds(binCellIds),
+      Bins(bins) {  }
+
+  /// Returns the index of the cell containing \c point and sets \c pcoords to
+  /// the parametric coordinates of the point in that cell. Returns -1 if no
+  /// cell contains the point.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id FindCell(const dax::Vector3 &point, dax::Vector3 &pcoords) const
+  {
+    const dax::Id bin = this->Bins.FindBin(point);
+    if (bin < 0) { return -1; }
+
+    const dax::Id start = this->BinOffsets.Get(bin);
+    const dax::Id end = start + this->BinCounts.Get(bin);
+    for (dax::Id index = start; index < end; index++)
+      {
+      const dax::Id cellIndex = this->BinCellIds.Get(index);
+      dax::exec::CellField<dax::Vector3,CellTag> vertexCoordinates =
+          this->GetCellVertexCoordinates(cellIndex);
+
+      // Newton's method is expensive, so reject cells whose bounds do not
+      // contain the point first.
+      dax::Vector3 minCoords = vertexCoordinates[0];
+      dax::Vector3 maxCoords = vertexCoordinates[0];
+      for (int vertex = 1; vertex < vertexCoordinates.NUM_VERTICES; vertex++)
+        {
+        minCoords = dax::math::Min(minCoords, vertexCoordinates[vertex]);
+        maxCoords = dax::math::Max(maxCoords, vertexCoordinates[vertex]);
+        }
+      if ((point[0] < minCoords[0]) || (point[0] > maxCoords[0]) ||
+          (point[1] < minCoords[1]) || (point[1] > maxCoords[1]) ||
+          (point[2] < minCoords[2]) || (point[2] > maxCoords[2]))
+        {
+        continue;
+        }
+
+      pcoords = dax::exec::WorldCoordinatesToParametricCoordinates(
+            vertexCoordinates, point, CellTag());
+      if (dax::exec::internal::ParametricCoordinatesInCell(
+            pcoords, CanonicalCellTag()))
+        {
+        return cellIndex;
+        }
+      }
+    return -1;
+  }
+
+  /// Returns the index of the cell containing \c point or -1 if no cell
+  /// contains the point.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id FindCell(const dax::Vector3 &point) const
+  {
+    dax::Vector3 pcoords;
+    return this->FindCell(point, pcoords);
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const dax::exec::internal::CellLocatorBins &GetBins() const {
+    return this->Bins;
+  }
+
+private:
+  DAX_EXEC_EXPORT
+  dax::exec::CellField<dax::Vector3,CellTag>
+  GetCellVertexCoordinates(dax::Id cellIndex) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    dax::exec::CellField<dax::Vector3,CellTag> vertexCoordinates;
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++)
+      {
+      vertexCoordinates[vertex] = this->Coordinates.Get(
+            this->Connections.Get(cellIndex*NUM_VERTICES + vertex));
+      }
+    return vertexCoordinates;
+  }
+
+  ConnectionsPortalType Connections;
+  CoordinatesPortalType Coordinates;
+  IdPortalType BinCounts;
+  IdPortalType BinOffsets;
+  IdPortalType BinCellIds;
+  dax::exec::internal::CellLocatorBins Bins;
+};
+
+}
+}
+
+#endif //__dax_exec_CellLocator_h
@@ -0,0 +1,73 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletMapPoint_h
+#define __dax_exec_WorkletMapPoint_h
+
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/sig/KeyGroup.h>
+#include <dax/cont/sig/Tag.h>
+
+namespace dax {
+namespace exec {
+
+///----------------------------------------------------------------------------
+/// Superclass for worklets that map cells to points. The worklet is invoked
+/// once per point of an unstructured grid and can read the values of a cell
+/// field for all the cells incident to that point. Use this with
+/// dax::cont::DispatcherMapPoint, which gets the incident cells from the
+/// point to cell links of the grid.
+///
+class WorkletMapPoint : public dax::exec::internal::WorkletBase
+{
+public:
+  typedef dax::cont::sig::Point DomainType;
+
+  DAX_EXEC_EXPORT WorkletMapPoint() { }
+protected:
+  typedef dax::cont::sig::Point Point;
+  typedef dax::cont::sig::Cell Cell;
+
+#ifndef FieldIn
+# define FieldIn dax::cont::arg::Field(*)(In)
+# define FieldOut dax::cont::arg::Field(*)(Out)
+#endif
+
+#ifndef FieldPoint
+# define FieldPointIn dax::cont::arg::Field(*)(In,Point)
+# define FieldInPoint dax::cont::arg::Field(*)(In,Point)
+# define FieldPointOut dax::cont::arg::Field(*)(Out,Point)
+# define FieldOutPoint dax::cont::arg::Field(*)(Out,Point)
+#endif
+
+#ifndef FieldCell
+# define FieldCellIn dax::cont::arg::Field(*)(In,Cell)
+# define FieldInCell dax::cont::arg::Field(*)(In,Cell)
+# define FieldCellOut dax::cont::arg::Field(*)(Out,Cell)
+# define FieldOutCell dax::cont::arg::Field(*)(Out,Cell)
+#endif
+
+/// Passes the values of a FieldCellIn argument for all the cells incident to
+/// the point as a dax::exec::KeyGroup.
+#ifndef AsIncidentCells
+# define AsIncidentCells(arg) dax::cont::sig::KeyGroup(*)(arg)
+#endif
+};
+
+}
+}
+
+#endif //__dax_exec_WorkletMapPoint_h
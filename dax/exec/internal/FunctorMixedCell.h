@@ -0,0 +1,95 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+# ifndef __dax_exec_internal_FunctorMixedCell_h
+# define __dax_exec_internal_FunctorMixedCell_h
+
+# include <dax/CellTag.h>
+# include <dax/CellTraits.h>
+# include <dax/Types.h>
+# include <dax/exec/internal/ErrorMessageBuffer.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// \headerfile FunctorMixedCell.h dax/exec/internal/FunctorMixedCell.h
+/// \brief Worklet invocation functor for grids with mixed cell types
+///
+/// Holds one dax::exec::internal::Functor per supported cell type, each bound
+/// to a view of the grid with that cell type, and forwards every cell index
+/// to the functor matching the shape of the cell. The switch over the
+/// supported tags is resolved at compile time, so the worklet is instantiated
+/// once per cell type and all cells are processed in a single schedule.
+///
+/// The supported cell types are the volumetric unstructured cells:
+/// hexahedra, wedges and tetrahedra.
+///
+template<class ShapesPortalType,
+         class HexahedronFunctor,
+         class WedgeFunctor,
+         class TetrahedronFunctor>
+class FunctorMixedCell
+{
+public:
+  DAX_CONT_EXPORT
+  FunctorMixedCell(const ShapesPortalType &shapes,
+                   const HexahedronFunctor &hexahedronFunctor,
+                   const WedgeFunctor &wedgeFunctor,
+                   const TetrahedronFunctor &tetrahedronFunctor)
+    : Shapes(shapes),
+      Hexahedron(hexahedronFunctor),
+      Wedge(wedgeFunctor),
+      Tetrahedron(tetrahedronFunctor) {  }
+
+  DAX_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorBuffer)
+  {
+    this->ErrorMessage = errorBuffer;
+    this->Hexahedron.SetErrorMessageBuffer(errorBuffer);
+    this->Wedge.SetErrorMessageBuffer(errorBuffer);
+    this->Tetrahedron.SetErrorMessageBuffer(errorBuffer);
+  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const
+  {
+    switch (this->Shapes.Get(index))
+      {
+      case dax::CellTraits<dax::CellTagHexahedron>::CELL_SHAPE:
+        this->Hexahedron(index);
+        break;
+      case dax::CellTraits<dax::CellTagWedge>::CELL_SHAPE:
+        this->Wedge(index);
+        break;
+      case dax::CellTraits<dax::CellTagTetrahedron>::CELL_SHAPE:
+        this->Tetrahedron(index);
+        break;
+      default:
+        this->ErrorMessage.RaiseError(
+              "Encountered unsupported cell shape in mixed grid.");
+      }
+  }
+
+private:
+  ShapesPortalType Shapes;
+  HexahedronFunctor Hexahedron;
+  WedgeFunctor Wedge;
+  TetrahedronFunctor Tetrahedron;
+  dax::exec::internal::ErrorMessageBuffer ErrorMessage;
+};
+
+}}} // namespace dax::exec::internal
+
+# endif //__dax_exec_internal_FunctorMixedCell_h
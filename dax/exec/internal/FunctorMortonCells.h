@@ -0,0 +1,103 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+# ifndef __dax_exec_internal_FunctorMortonCells_h
+# define __dax_exec_internal_FunctorMortonCells_h
+
+# include <dax/Types.h>
+# include <dax/exec/internal/ErrorMessageBuffer.h>
+# include <dax/exec/internal/IJKIndex.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// \headerfile FunctorMortonCells.h dax/exec/internal/FunctorMortonCells.h
+/// \brief Visits the cells of a structured grid in Morton order over bricks
+///
+/// The cells are split into cubic bricks of MORTON_BRICK_WIDTH cells per
+/// axis. Bricks are visited in row-major order and the cells within each
+/// brick are visited in Morton (Z-curve) order, so cells that are scheduled
+/// together share the planes of points they read. The wrapped functor is
+/// still given the dax::exec::internal::IJKIndex of the cell, so results are
+/// written at the canonical flat cell index.
+///
+/// Schedule this functor with GetNumberOfInstances() instances. Instances
+/// that land in the part of a brick outside the grid do nothing.
+///
+template<class FunctorType>
+class FunctorMortonCells
+{
+public:
+  enum { MORTON_BRICK_BITS = 3 };
+  enum { MORTON_BRICK_WIDTH = 1 << MORTON_BRICK_BITS };
+  enum { MORTON_BRICK_CELLS = 1 << (3*MORTON_BRICK_BITS) };
+
+  DAX_CONT_EXPORT
+  FunctorMortonCells(const FunctorType &functor, const dax::Id3 &cellDims)
+    : Functor(functor),
+      CellDims(cellDims),
+      BrickDims((cellDims[0] + MORTON_BRICK_WIDTH - 1) / MORTON_BRICK_WIDTH,
+                (cellDims[1] + MORTON_BRICK_WIDTH - 1) / MORTON_BRICK_WIDTH,
+                (cellDims[2] + MORTON_BRICK_WIDTH - 1) / MORTON_BRICK_WIDTH)
+  {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfInstances() const
+  {
+    return this->BrickDims[0]*this->BrickDims[1]*this->BrickDims[2]
+        * MORTON_BRICK_CELLS;
+  }
+
+  DAX_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorBuffer)
+  {
+    this->Functor.SetErrorMessageBuffer(errorBuffer);
+  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const
+  {
+    dax::Id brick = index >> (3*MORTON_BRICK_BITS);
+    const dax::Id code = index & (MORTON_BRICK_CELLS - 1);
+
+    dax::Id3 ijk;
+    ijk[0] = brick % this->BrickDims[0];
+    brick /= this->BrickDims[0];
+    ijk[1] = brick % this->BrickDims[1];
+    ijk[2] = brick / this->BrickDims[1];
+
+    for (int axis = 0; axis < 3; axis++)
+      {
+      dax::Id local = 0;
+      for (int bit = 0; bit < MORTON_BRICK_BITS; bit++)
+        {
+        local |= ((code >> (3*bit + axis)) & dax::Id(1)) << bit;
+        }
+      ijk[axis] = ijk[axis]*MORTON_BRICK_WIDTH + local;
+      if (ijk[axis] >= this->CellDims[axis]) { return; }
+      }
+
+    this->Functor(dax::exec::internal::IJKIndex(this->CellDims, ijk));
+  }
+
+private:
+  FunctorType Functor;
+  dax::Id3 CellDims;
+  dax::Id3 BrickDims;
+};
+
+}}} // namespace dax::exec::internal
+
+# endif //__dax_exec_internal_FunctorMortonCells_h
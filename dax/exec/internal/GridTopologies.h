@@ -16,7 +16,11 @@
 #ifndef __dax__exec__internal__GridTopologies_h
 #define __dax__exec__internal__GridTopologies_h
 
+#include <dax/exec/internal/TopologyRectilinear.h>
+#include <dax/exec/internal/TopologyStructured.h>
 #include <dax/exec/internal/TopologyUniform.h>
+#include <dax/exec/internal/TopologyUniform2D.h>
 #include <dax/exec/internal/TopologyUnstructured.h>
+#include <dax/exec/internal/TopologyUnstructuredMixed.h>
 
 #endif //__dax__internal__GridTopologies_h
@@ -31,7 +31,7 @@ struct IJKIndex
                         (this->IJK[1] + this->Dims[1]* this->IJK[2]);
     }
 
-  DAX_CONT_EXPORT
+  DAX_EXEC_CONT_EXPORT
   IJKIndex(dax::Id3 dims, dax::Id3 ijk):
     IJK(ijk),
     Dims(dims)
@@ -0,0 +1,65 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_MortonCode_h
+#define __dax_exec_internal_MortonCode_h
+
+#include <dax/Types.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// The number of bits of each index that fit in a Morton code stored in a
+/// dax::Id without touching the sign bit: 10 for 32 bit ids, 21 for 64 bit
+/// ids.
+///
+enum { MORTON_BITS_PER_AXIS = (sizeof(dax::Id)*8 - 1)/3 };
+
+/// Interleaves the bits of the three indices into a Morton (Z-order) code,
+/// with bit n of i, j and k going to bits 3n, 3n+1 and 3n+2. Indices must be
+/// non negative and smaller than 2^MORTON_BITS_PER_AXIS.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id MortonCode(const dax::Id3 &ijk)
+{
+  dax::Id code = 0;
+  for (int bit = 0; bit < MORTON_BITS_PER_AXIS; bit++)
+    {
+    for (int axis = 0; axis < 3; axis++)
+      {
+      code |= ((ijk[axis] >> bit) & dax::Id(1)) << (3*bit + axis);
+      }
+    }
+  return code;
+}
+
+/// The inverse of MortonCode.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id3 MortonDecode(dax::Id code)
+{
+  dax::Id3 ijk(0, 0, 0);
+  for (int bit = 0; bit < MORTON_BITS_PER_AXIS; bit++)
+    {
+    for (int axis = 0; axis < 3; axis++)
+      {
+      ijk[axis] |= ((code >> (3*bit + axis)) & dax::Id(1)) << bit;
+      }
+    }
+  return ijk;
+}
+
+}}} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_MortonCode_h
@@ -0,0 +1,131 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyRectilinear_h
+#define __dax__exec__internal__TopologyRectilinear_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/IJKIndex.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// The basic data describing the topology of a rectilinear grid. A
+/// rectilinear grid is axis aligned like a uniform grid, but the spacing
+/// between points can vary along each axis, so the point positions are given
+/// by three 1-D coordinate arrays (one per axis). The connectivity is
+/// identical to that of a uniform grid with the same extent and is computed
+/// implicitly.
+///
+template<class AxisPortalT>
+struct TopologyRectilinear
+{
+  typedef dax::CellTagVoxel CellTag;
+  typedef AxisPortalT AxisPortalType;
+
+  Extent3 Extent;
+  AxisPortalType XCoordinates;
+  AxisPortalType YCoordinates;
+  AxisPortalType ZCoordinates;
+
+  /// Returns the number of points in a rectilinear grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    dax::Id3 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the number of cells in a rectilinear grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    dax::Id3 dims = dax::extentCellDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the point position in a rectilinear grid for a given i, j, and
+  /// k value stored in /c ijk
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordiantes(dax::Id3 ijk) const
+  {
+    ijk = ijk - this->Extent.Min;
+    return dax::make_Vector3(this->XCoordinates.Get(ijk[0]),
+                             this->YCoordinates.Get(ijk[1]),
+                             this->ZCoordinates.Get(ijk[2]));
+  }
+
+  /// Returns the point position in a rectilinear grid for a given index
+  /// which is represented by /c pointIndex
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordiantes(dax::Id pointIndex) const
+  {
+    dax::Id3 ijk = flatIndexToIndex3(pointIndex, this->Extent);
+    return this->GetPointCoordiantes(ijk);
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<dax::CellTagVoxel>
+  ComputeImplictVertices(const dax::Id& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
+    return ReturnType( dax::extentDimensions(this->Extent),
+                       dax::indexToConnectivityIndex(cellIndex,this->Extent));
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<dax::CellTagVoxel>
+  ComputeImplictVertices(const dax::exec::internal::IJKIndex& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
+    return ReturnType(dax::extentDimensions(this->Extent), cellIndex);
+  }
+
+  template< class IndexType >
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(const IndexType& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
+    ReturnType indices = this->ComputeImplictVertices(cellIndex);
+
+    dax::exec::CellVertices<CellTag> values;
+
+    values[0] = indices.FirstPointIndex;
+    values[1] = indices.FirstPointIndex + 1;
+    values[2] = indices.FirstPointIndex + indices.XDim + 1;
+    values[3] = indices.FirstPointIndex + indices.XDim;
+    values[4] = indices.SecondPointIndex;
+    values[5] = indices.SecondPointIndex + 1;
+    values[6] = indices.SecondPointIndex + indices.XDim + 1;
+    values[7] = indices.SecondPointIndex + indices.XDim;
+    return values;
+  }
+};
+
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyRectilinear_h
@@ -0,0 +1,106 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyStructured_h
+#define __dax__exec__internal__TopologyStructured_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/IJKIndex.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// The basic data describing the topology of a structured (curvilinear)
+/// grid. The cells of a structured grid are hexahedra whose vertices are
+/// numbered like those of a uniform grid, so the connections are computed
+/// from the extent rather than stored. Like TopologyUnstructured, the point
+/// coordinates are not part of the topology and are passed separately.
+///
+struct TopologyStructured
+{
+  typedef dax::CellTagHexahedron CellTag;
+
+  Extent3 Extent;
+
+  /// Returns the number of points in a structured grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    dax::Id3 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the number of cells in a structured grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    dax::Id3 dims = dax::extentCellDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<CellTag>
+  ComputeImplictVertices(const dax::Id& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
+    return ReturnType( dax::extentDimensions(this->Extent),
+                       dax::indexToConnectivityIndex(cellIndex,this->Extent));
+  }
+
+  DAX_EXEC_EXPORT
+  detail::ImplicitCellVertices<CellTag>
+  ComputeImplictVertices(const dax::exec::internal::IJKIndex& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
+    return ReturnType(dax::extentDimensions(this->Extent), cellIndex);
+  }
+
+  /// Returns the point indices for all vertices. The hexahedron vertex order
+  /// is the same as that of a voxel in a uniform grid.
+  ///
+  template< class IndexType >
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(const IndexType& cellIndex) const
+  {
+    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
+    ReturnType indices = this->ComputeImplictVertices(cellIndex);
+
+    dax::exec::CellVertices<CellTag> values;
+
+    values[0] = indices.FirstPointIndex;
+    values[1] = indices.FirstPointIndex + 1;
+    values[2] = indices.FirstPointIndex + indices.XDim + 1;
+    values[3] = indices.FirstPointIndex + indices.XDim;
+    values[4] = indices.SecondPointIndex;
+    values[5] = indices.SecondPointIndex + 1;
+    values[6] = indices.SecondPointIndex + indices.XDim + 1;
+    values[7] = indices.SecondPointIndex + indices.XDim;
+    return values;
+  }
+};
+
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyStructured_h
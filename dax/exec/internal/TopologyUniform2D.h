@@ -0,0 +1,123 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyUniform2D_h
+#define __dax__exec__internal__TopologyUniform2D_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/internal/IJKIndex.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a 2D
+/// uniform grid (an image). The cells are pixels, which are represented as
+/// quadrilaterals since the counterclockwise order of the pixel vertices
+/// matches the quadrilateral vertex order.
+///
+DAX_ALIGN_BEGIN(DAX_SIZE_SCALAR) struct TopologyUniform2D {
+  typedef dax::CellTagQuadrilateral CellTag;
+
+  Vector3 Origin;
+  Vector2 Spacing;
+  Extent2 Extent;
+
+  /// Returns the number of points in a 2D uniform grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    dax::Id2 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1];
+  }
+
+  /// Returns the number of cells in a 2D uniform grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    dax::Id2 dims = dax::extentCellDimensions(this->Extent);
+    return dims[0]*dims[1];
+  }
+
+  /// Returns the point position in the grid for a given i and j value stored
+  /// in /c ij
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordiantes(dax::Id2 ij) const
+  {
+    return dax::make_Vector3(this->Origin[0] + ij[0] * this->Spacing[0],
+                             this->Origin[1] + ij[1] * this->Spacing[1],
+                             this->Origin[2]);
+  }
+
+  /// Returns the point position in the grid for a given index which is
+  /// represented by /c pointIndex
+  ///
+  DAX_EXEC_EXPORT
+  dax::Vector3 GetPointCoordiantes(dax::Id pointIndex) const
+  {
+    dax::Id2 ij = flatIndexToIndex2(pointIndex, this->Extent);
+    return this->GetPointCoordiantes(ij);
+  }
+
+  /// Returns the index of the first point of the given cell.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id ComputeFirstPointIndex(const dax::Id& cellIndex) const
+  {
+    const dax::Id cellsPerRow = this->Extent.Max[0] - this->Extent.Min[0];
+    return cellIndex + cellIndex / cellsPerRow;
+  }
+
+  /// Returns the index of the first point of the given cell. The Id2
+  /// schedulers give the i, j location of the cell in the first two
+  /// components of the index.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id ComputeFirstPointIndex(
+      const dax::exec::internal::IJKIndex& cellIndex) const
+  {
+    const dax::Id3 &ijk = cellIndex.GetIJK();
+    const dax::Id pointsPerRow = this->Extent.Max[0] - this->Extent.Min[0] + 1;
+    return ijk[0] + ijk[1] * pointsPerRow;
+  }
+
+  template< class IndexType >
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(const IndexType& cellIndex) const
+  {
+    const dax::Id pointsPerRow = this->Extent.Max[0] - this->Extent.Min[0] + 1;
+    const dax::Id firstPointIndex = this->ComputeFirstPointIndex(cellIndex);
+
+    dax::exec::CellVertices<CellTag> values;
+    values[0] = firstPointIndex;
+    values[1] = firstPointIndex + 1;
+    values[2] = firstPointIndex + pointsPerRow + 1;
+    values[3] = firstPointIndex + pointsPerRow;
+    return values;
+  }
+} DAX_ALIGN_END(DAX_SIZE_SCALAR);
+
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyUniform2D_h
@@ -84,7 +84,9 @@ struct TopologyUnstructured
     return this->NumberOfPoints;
   }
 
-  /// Returns the point indices for all vertices.
+  /// Returns the point indices for all vertices. The connections portal may
+  /// hold its indices in a narrower type than dax::Id (see
+  /// dax::cont::CompactCodecId); they are widened as they are fetched.
   ///
   template<typename IndexType>
   DAX_EXEC_EXPORT
@@ -95,8 +97,8 @@ struct TopologyUnstructured
     dax::exec::CellVertices<CellTag> vertices;
     for (dax::Id vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
       {
-      vertices[vertexIndex] =
-          this->CellConnections.Get(startConnectionIndex + vertexIndex);
+      vertices[vertexIndex] = static_cast<dax::Id>(
+          this->CellConnections.Get(startConnectionIndex + vertexIndex));
       }
     return vertices;
   }
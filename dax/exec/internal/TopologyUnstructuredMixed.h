@@ -0,0 +1,109 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyUnstructuredMixed_h
+#define __dax__exec__internal__TopologyUnstructuredMixed_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/exec/CellVertices.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// The topology of a mixed unstructured grid as seen by cells of a single
+/// type. A mixed grid stores an offsets array giving, for each cell, the
+/// index of its first point id in the cell connections array. This structure
+/// reads the connections of a cell assuming it is of type \c CellTag, so it
+/// must only be used on cells whose shape matches \c CellTag. The dispatcher
+/// takes care of that by switching on the shape of each cell (see
+/// dax::exec::internal::FunctorMixedCell).
+///
+template<typename T, class OffsetsPortalT, class ConnectionsPortalT>
+struct TopologyUnstructuredMixed
+{
+  typedef T CellTag;
+  typedef OffsetsPortalT CellOffsetsPortalType;
+  typedef ConnectionsPortalT CellConnectionsPortalType;
+
+  TopologyUnstructuredMixed()
+    : CellOffsets(CellOffsetsPortalType()),
+      CellConnections(CellConnectionsPortalType()),
+      NumberOfPoints(0)
+    {
+    }
+
+  /// Create a topology with the given descriptive arrays.
+  ///
+  /// \param cellOffsets An array containing for each cell the index in \c
+  /// cellConnections of its first vertex.
+  /// \param cellConnections An array containing a list for each cell giving
+  /// the point index for each vertex of the cell.
+  /// \param numberOfPoints The number of points in the grid.
+  ///
+  TopologyUnstructuredMixed(CellOffsetsPortalType cellOffsets,
+                            CellConnectionsPortalType cellConnections,
+                            dax::Id numberOfPoints)
+    : CellOffsets(cellOffsets),
+      CellConnections(cellConnections),
+      NumberOfPoints(numberOfPoints)
+  {
+  }
+
+  CellOffsetsPortalType CellOffsets;
+  CellConnectionsPortalType CellConnections;
+  dax::Id NumberOfPoints;
+
+  /// Returns the number of cells (of all types) in the grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return this->CellOffsets.GetNumberOfValues();
+  }
+
+  /// Returns the number of points in the grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return this->NumberOfPoints;
+  }
+
+  /// Returns the point indices for all vertices.
+  ///
+  template<typename IndexType>
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag> GetCellConnections(const IndexType& cellIndex) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    dax::Id startConnectionIndex = this->CellOffsets.Get(cellIndex);
+    dax::exec::CellVertices<CellTag> vertices;
+    for (dax::Id vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      vertices[vertexIndex] =
+          this->CellConnections.Get(startConnectionIndex + vertexIndex);
+      }
+    return vertices;
+  }
+};
+
+} //internal
+} //exec
+} //dax
+
+#endif // __dax__exec__internal__TopologyUnstructuredMixed_h
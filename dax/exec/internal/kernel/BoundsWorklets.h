@@ -0,0 +1,77 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_BoundsWorklets_h
+#define __dax_exec_internal_kernel_BoundsWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/math/Compare.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Computes the bounds of a block of consecutive points. Every instance
+/// handles \c BlockSize points, so scheduling a few thousand blocks computes
+/// the bounds of all the points in parallel.
+///
+template<class CoordinatesPortalType, class BoundsPortalType>
+struct BlockBoundsFunctor : public dax::exec::internal::WorkletBase
+{
+  CoordinatesPortalType Coordinates;
+  BoundsPortalType MinBounds;
+  BoundsPortalType MaxBounds;
+  dax::Id BlockSize;
+
+  DAX_CONT_EXPORT
+  BlockBoundsFunctor(const CoordinatesPortalType &coordinates,
+                     const BoundsPortalType &minBounds,
+                     const BoundsPortalType &maxBounds,
+                     dax::Id blockSize)
+    : Coordinates(coordinates),
+      MinBounds(minBounds),
+      MaxBounds(maxBounds),
+      BlockSize(blockSize) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id block) const
+  {
+    const dax::Id begin = block*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->Coordinates.GetNumberOfValues())
+      {
+      end = this->Coordinates.GetNumberOfValues();
+      }
+    dax::Vector3 minBounds = this->Coordinates.Get(begin);
+    dax::Vector3 maxBounds = minBounds;
+    for (dax::Id index = begin+1; index < end; index++)
+      {
+      const dax::Vector3 coords = this->Coordinates.Get(index);
+      minBounds = dax::math::Min(minBounds, coords);
+      maxBounds = dax::math::Max(maxBounds, coords);
+      }
+    this->MinBounds.Set(block, minBounds);
+    this->MaxBounds.Set(block, maxBounds);
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_BoundsWorklets_h
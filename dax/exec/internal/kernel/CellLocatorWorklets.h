@@ -0,0 +1,160 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_CellLocatorWorklets_h
+#define __dax_exec_internal_kernel_CellLocatorWorklets_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/exec/CellLocator.h>
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/math/Compare.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Shared code of the functors that bin cells: finds the range of bins
+/// overlapped by the bounding box of a cell.
+///
+template<class CellTag, class ConnectionsPortalType, class CoordinatesPortalType>
+struct CellLocatorBinRange
+{
+  ConnectionsPortalType Connections;
+  CoordinatesPortalType Coordinates;
+  dax::exec::internal::CellLocatorBins Bins;
+
+  DAX_CONT_EXPORT
+  CellLocatorBinRange(const ConnectionsPortalType &connections,
+                      const CoordinatesPortalType &coordinates,
+                      const dax::exec::internal::CellLocatorBins &bins)
+    : Connections(connections), Coordinates(coordinates), Bins(bins) {  }
+
+  DAX_EXEC_EXPORT
+  void GetBinRange(dax::Id cellIndex, dax::Id3 &minBin, dax::Id3 &maxBin) const
+  {
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+    const dax::Id firstConnection = cellIndex*NUM_VERTICES;
+    dax::Vector3 minCoords =
+        this->Coordinates.Get(this->Connections.Get(firstConnection));
+    dax::Vector3 maxCoords = minCoords;
+    for (int vertex = 1; vertex < NUM_VERTICES; vertex++)
+      {
+      const dax::Vector3 coords =
+          this->Coordinates.Get(this->Connections.Get(firstConnection+vertex));
+      minCoords = dax::math::Min(minCoords, coords);
+      maxCoords = dax::math::Max(maxCoords, coords);
+      }
+    minBin = this->Bins.FindBinClamped(minCoords);
+    maxBin = this->Bins.FindBinClamped(maxCoords);
+  }
+};
+
+/// Counts the number of bins overlapped by each cell.
+///
+template<class CellTag,
+         class ConnectionsPortalType,
+         class CoordinatesPortalType,
+         class IdPortalType>
+struct CellLocatorCountBinsFunctor
+    : public dax::exec::internal::WorkletBase,
+      public CellLocatorBinRange<CellTag,
+                                 ConnectionsPortalType,
+                                 CoordinatesPortalType>
+{
+  IdPortalType Counts;
+
+  DAX_CONT_EXPORT
+  CellLocatorCountBinsFunctor(const ConnectionsPortalType &connections,
+                              const CoordinatesPortalType &coordinates,
+                              const dax::exec::internal::CellLocatorBins &bins,
+                              const IdPortalType &counts)
+    : CellLocatorBinRange<CellTag,
+                          ConnectionsPortalType,
+                          CoordinatesPortalType>(connections, coordinates, bins),
+      Counts(counts) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    dax::Id3 minBin, maxBin;
+    this->GetBinRange(cellIndex, minBin, maxBin);
+    this->Counts.Set(cellIndex, (maxBin[0]-minBin[0]+1)
+                               *(maxBin[1]-minBin[1]+1)
+                               *(maxBin[2]-minBin[2]+1));
+  }
+};
+
+/// Writes a bin id and cell id pair for every bin overlapped by each cell,
+/// starting at the offset of the cell.
+///
+template<class CellTag,
+         class ConnectionsPortalType,
+         class CoordinatesPortalType,
+         class IdPortalConstType,
+         class IdPortalType>
+struct CellLocatorFillBinsFunctor
+    : public dax::exec::internal::WorkletBase,
+      public CellLocatorBinRange<CellTag,
+                                 ConnectionsPortalType,
+                                 CoordinatesPortalType>
+{
+  IdPortalConstType Offsets;
+  IdPortalType BinIds;
+  IdPortalType CellIds;
+
+  DAX_CONT_EXPORT
+  CellLocatorFillBinsFunctor(const ConnectionsPortalType &connections,
+                             const CoordinatesPortalType &coordinates,
+                             const dax::exec::internal::CellLocatorBins &bins,
+                             const IdPortalConstType &offsets,
+                             const IdPortalType &binIds,
+                             const IdPortalType &cellIds)
+    : CellLocatorBinRange<CellTag,
+                          ConnectionsPortalType,
+                          CoordinatesPortalType>(connections, coordinates, bins),
+      Offsets(offsets),
+      BinIds(binIds),
+      CellIds(cellIds) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id cellIndex) const
+  {
+    dax::Id3 minBin, maxBin;
+    this->GetBinRange(cellIndex, minBin, maxBin);
+    dax::Id outIndex = this->Offsets.Get(cellIndex);
+    dax::Id3 bin;
+    for (bin[2] = minBin[2]; bin[2] <= maxBin[2]; bin[2]++)
+      {
+      for (bin[1] = minBin[1]; bin[1] <= maxBin[1]; bin[1]++)
+        {
+        for (bin[0] = minBin[0]; bin[0] <= maxBin[0]; bin[0]++)
+          {
+          this->BinIds.Set(outIndex, this->Bins.GetBinIndex(bin));
+          this->CellIds.Set(outIndex, cellIndex);
+          outIndex++;
+          }
+        }
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_CellLocatorWorklets_h
@@ -99,6 +99,108 @@ struct InterpolateFieldToField
     OutPortalType Output;
   };
 
+//Interpolates NumFields fields of the same type at once, so that each
+//interpolation weight is read a single time for all of them.
+template<class InPortalType,
+         class InterpolationPortalType,
+         class OutPortalType,
+         int NumFields>
+struct InterpolateFieldsToFields : dax::exec::internal::WorkletBase
+{
+  typedef dax::Tuple<InPortalType,NumFields> InPortalsType;
+  typedef dax::Tuple<OutPortalType,NumFields> OutPortalsType;
+
+  DAX_CONT_EXPORT
+  InterpolateFieldsToFields(const InPortalsType &inPortals,
+                            const InterpolationPortalType &interpPortal,
+                            const OutPortalsType &outPortals)
+    : Inputs(inPortals), Interpolation(interpPortal), Outputs(outPortals) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::PointAsEdgeInterpolation interpolationInfo =
+        this->Interpolation.Get(index);
+
+    typedef typename InPortalType::ValueType InValueType;
+    for (int field = 0; field < NumFields; field++)
+      {
+      const InValueType first =
+          this->Inputs[field].Get(interpolationInfo.EdgeIdFirst);
+      const InValueType second =
+          this->Inputs[field].Get(interpolationInfo.EdgeIdSecond);
+      this->Outputs[field].Set(
+            index, dax::math::Lerp(first,second,interpolationInfo.Weight));
+      }
+  }
+
+  InPortalsType Inputs;
+  InterpolationPortalType Interpolation;
+  OutPortalsType Outputs;
+};
+
+//Copies the values at the given ids of NumFields fields of the same type at
+//once, so that each id is read a single time for all of them.
+template<class InPortalType,
+         class IdPortalType,
+         class OutPortalType,
+         int NumFields>
+struct GatherFieldsToFields : dax::exec::internal::WorkletBase
+{
+  typedef dax::Tuple<InPortalType,NumFields> InPortalsType;
+  typedef dax::Tuple<OutPortalType,NumFields> OutPortalsType;
+
+  DAX_CONT_EXPORT
+  GatherFieldsToFields(const InPortalsType &inPortals,
+                       const IdPortalType &idPortal,
+                       const OutPortalsType &outPortals)
+    : Inputs(inPortals), Ids(idPortal), Outputs(outPortals) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::Id inputIndex = this->Ids.Get(index);
+    for (int field = 0; field < NumFields; field++)
+      {
+      this->Outputs[field].Set(index, this->Inputs[field].Get(inputIndex));
+      }
+  }
+
+  InPortalsType Inputs;
+  IdPortalType Ids;
+  OutPortalsType Outputs;
+};
+
+//The input cell of an output of a generate with a fixed number of outputs
+//per input cell.
+struct FanoutInputCellFunctor
+{
+  dax::Id CountPerCell;
+
+  DAX_EXEC_CONT_EXPORT
+  FanoutInputCellFunctor(dax::Id countPerCell = 1)
+    : CountPerCell(countPerCell) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id operator()(dax::Id outputIndex) const {
+    return outputIndex / this->CountPerCell;
+  }
+};
+
+//The visit index of an output of a generate with a fixed number of outputs
+//per input cell.
+struct FanoutVisitIndexFunctor
+{
+  dax::Id CountPerCell;
+
+  DAX_EXEC_CONT_EXPORT
+  FanoutVisitIndexFunctor(dax::Id countPerCell = 1)
+    : CountPerCell(countPerCell) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id operator()(dax::Id outputIndex) const {
+    return outputIndex % this->CountPerCell;
+  }
+};
+
 template< typename ReductionMapType >
 struct Offset2CountFunctor : dax::exec::internal::WorkletBase
 {
@@ -0,0 +1,228 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_PointHashWorklets_h
+#define __dax_exec_internal_kernel_PointHashWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <dax/cont/internal/EdgeInterpolatedGrid.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Hashes the edge of an interpolated point. Two interpolated points are
+/// duplicates when they lie on the same edge, so the weight is ignored.
+///
+DAX_EXEC_CONT_EXPORT
+dax::internal::UInt32Type PointHash(
+    const dax::PointAsEdgeInterpolation &point)
+{
+  typedef dax::internal::UInt32Type UInt32;
+  UInt32 hash = static_cast<UInt32>(point.EdgeIdFirst) * 0x9E3779B1u;
+  hash ^= static_cast<UInt32>(point.EdgeIdSecond) * 0x85EBCA77u
+      + (hash << 6) + (hash >> 2);
+  return hash ^ (hash >> 15);
+}
+
+/// PointHash as a functor, the default hash of the point records.
+///
+struct PointHashFunctor
+{
+  DAX_EXEC_CONT_EXPORT
+  dax::internal::UInt32Type operator()(
+      const dax::PointAsEdgeInterpolation &point) const
+  {
+    return dax::exec::internal::kernel::PointHash(point);
+  }
+};
+
+/// Writes a sort key for each point record: the hash of the record in the
+/// high 32 bits and the index of the record in the low 32 bits. Sorting the
+/// keys groups the records by hash, with the records of each hash in index
+/// order, without carrying a separate array of indices through the sort.
+///
+template<class RecordsPortalType, class HashFunctorType, class KeysPortalType>
+struct PointHashKeysFunctor : public dax::exec::internal::WorkletBase
+{
+  RecordsPortalType Records;
+  HashFunctorType Hash;
+  KeysPortalType Keys;
+
+  DAX_CONT_EXPORT
+  PointHashKeysFunctor(const RecordsPortalType &records,
+                       const HashFunctorType &hash,
+                       const KeysPortalType &keys)
+    : Records(records), Hash(hash), Keys(keys) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    typedef dax::internal::UInt64Type UInt64;
+    this->Keys.Set(index,
+                   (static_cast<UInt64>(this->Hash(this->Records.Get(index)))
+                    << 32) | static_cast<UInt64>(index));
+  }
+};
+
+/// The hash part of a sort key made by PointHashKeysFunctor.
+///
+DAX_EXEC_CONT_EXPORT
+dax::internal::UInt32Type PointHashOfKey(dax::internal::UInt64Type key)
+{
+  return static_cast<dax::internal::UInt32Type>(key >> 32);
+}
+
+/// The record index part of a sort key made by PointHashKeysFunctor.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id PointHashRecordOfKey(dax::internal::UInt64Type key)
+{
+  return static_cast<dax::Id>(key & 0xFFFFFFFFu);
+}
+
+/// Flags the first sorted key of each run of equal hashes.
+///
+template<class KeysPortalType, class FlagsPortalType>
+struct PointHashRunStartFlagsFunctor : public dax::exec::internal::WorkletBase
+{
+  KeysPortalType SortedKeys;
+  FlagsPortalType Flags;
+
+  DAX_CONT_EXPORT
+  PointHashRunStartFlagsFunctor(const KeysPortalType &sortedKeys,
+                                const FlagsPortalType &flags)
+    : SortedKeys(sortedKeys), Flags(flags) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const bool runStart = (index == 0) ||
+        (PointHashOfKey(this->SortedKeys.Get(index)) !=
+         PointHashOfKey(this->SortedKeys.Get(index-1)));
+    this->Flags.Set(index, runStart ? 1 : 0);
+  }
+};
+
+/// Finds the owners of the records of one run of equal hashes, the record
+/// with the smallest index among the equal records. The records of a run
+/// are in index order, so when they are all equal, which is the case unless
+/// hashes collide, the first one owns the whole run and one pass over the
+/// run is enough. Only a run with colliding hashes compares each record
+/// with the ones before it. Each instance writes the owners of its own run.
+///
+template<class KeysPortalType,
+         class RunStartsPortalType,
+         class RecordsPortalType,
+         class OwnersPortalType>
+struct PointHashOwnersFunctor : public dax::exec::internal::WorkletBase
+{
+  KeysPortalType SortedKeys;
+  RunStartsPortalType RunStarts;
+  RecordsPortalType Records;
+  OwnersPortalType Owners;
+
+  DAX_CONT_EXPORT
+  PointHashOwnersFunctor(const KeysPortalType &sortedKeys,
+                         const RunStartsPortalType &runStarts,
+                         const RecordsPortalType &records,
+                         const OwnersPortalType &owners)
+    : SortedKeys(sortedKeys), RunStarts(runStarts), Records(records),
+      Owners(owners) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id run) const
+  {
+    const dax::Id begin = this->RunStarts.Get(run);
+    const dax::Id end = (run+1 < this->RunStarts.GetNumberOfValues()) ?
+          this->RunStarts.Get(run+1) : this->SortedKeys.GetNumberOfValues();
+
+    const dax::Id first = PointHashRecordOfKey(this->SortedKeys.Get(begin));
+    const dax::PointAsEdgeInterpolation firstPoint = this->Records.Get(first);
+    bool collided = false;
+    for (dax::Id index = begin; index < end && !collided; index++)
+      {
+      const dax::Id record = PointHashRecordOfKey(this->SortedKeys.Get(index));
+      collided = (this->Records.Get(record) != firstPoint);
+      }
+
+    for (dax::Id index = begin; index < end; index++)
+      {
+      const dax::Id record = PointHashRecordOfKey(this->SortedKeys.Get(index));
+      dax::Id owner = first;
+      if (collided)
+        {
+        const dax::PointAsEdgeInterpolation point = this->Records.Get(record);
+        dax::Id other = begin;
+        owner = PointHashRecordOfKey(this->SortedKeys.Get(other));
+        while (this->Records.Get(owner) != point)
+          {
+          owner = PointHashRecordOfKey(this->SortedKeys.Get(++other));
+          }
+        }
+      this->Owners.Set(record, owner);
+      }
+  }
+};
+
+/// Flags the records that own themselves, which become the output points.
+///
+template<class OwnersPortalType, class FlagsPortalType>
+struct PointHashOwnerFlagsFunctor : public dax::exec::internal::WorkletBase
+{
+  OwnersPortalType Owners;
+  FlagsPortalType Flags;
+
+  DAX_CONT_EXPORT
+  PointHashOwnerFlagsFunctor(const OwnersPortalType &owners,
+                             const FlagsPortalType &flags)
+    : Owners(owners), Flags(flags) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Flags.Set(index, (this->Owners.Get(index) == index) ? 1 : 0);
+  }
+};
+
+/// Writes the connections of the output cells: record i becomes the point
+/// id of the owner of record i.
+///
+template<class OwnersPortalType,
+         class PointIdsPortalType,
+         class ConnectionsPortalType>
+struct PointHashConnectionsFunctor : public dax::exec::internal::WorkletBase
+{
+  OwnersPortalType Owners;
+  PointIdsPortalType PointIds;
+  ConnectionsPortalType Connections;
+
+  DAX_CONT_EXPORT
+  PointHashConnectionsFunctor(const OwnersPortalType &owners,
+                              const PointIdsPortalType &pointIds,
+                              const ConnectionsPortalType &connections)
+    : Owners(owners), PointIds(pointIds), Connections(connections) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Connections.Set(index, this->PointIds.Get(this->Owners.Get(index)));
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_PointHashWorklets_h
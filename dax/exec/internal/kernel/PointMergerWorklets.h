@@ -0,0 +1,61 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_PointMergerWorklets_h
+#define __dax_exec_internal_kernel_PointMergerWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/WorkletMapField.h>
+#include <dax/math/Precision.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Quantizes a point to the integer lattice of cells of size tolerance that
+/// starts at \c origin. All points that fall in the same lattice cell get the
+/// same key. The caller makes sure the lattice coordinates of the points fit
+/// in a dax::Id.
+///
+struct QuantizePointFunctor : public WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_CONT_EXPORT
+  QuantizePointFunctor(dax::Scalar tolerance, const dax::Vector3 &origin)
+    : InverseTolerance(1/tolerance), Origin(origin) {  }
+
+  DAX_EXEC_EXPORT dax::Id3 operator()(const dax::Vector3 &point) const
+  {
+    const dax::Vector3 lattice =
+        dax::math::Floor((point - this->Origin) * this->InverseTolerance);
+    return dax::make_Id3(static_cast<dax::Id>(lattice[0]),
+                         static_cast<dax::Id>(lattice[1]),
+                         static_cast<dax::Id>(lattice[2]));
+  }
+
+private:
+  dax::Scalar InverseTolerance;
+  dax::Vector3 Origin;
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_PointMergerWorklets_h
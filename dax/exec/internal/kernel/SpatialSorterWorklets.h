@@ -0,0 +1,176 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_SpatialSorterWorklets_h
+#define __dax_exec_internal_kernel_SpatialSorterWorklets_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/MortonCode.h>
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/math/Compare.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Maps coordinates inside the given bounds to the Morton code of their
+/// position in a lattice of 2^MORTON_BITS_PER_AXIS cells along each axis.
+///
+struct MortonCodeOfCoordinates
+{
+  dax::Vector3 Origin;
+  dax::Vector3 Scale;
+
+  DAX_CONT_EXPORT
+  MortonCodeOfCoordinates(const dax::Vector3 &minBounds,
+                          const dax::Vector3 &maxBounds)
+    : Origin(minBounds)
+  {
+    const dax::Scalar latticeMax = static_cast<dax::Scalar>(
+          (dax::Id(1) << dax::exec::internal::MORTON_BITS_PER_AXIS) - 1);
+    for (int axis = 0; axis < 3; axis++)
+      {
+      const dax::Scalar size = maxBounds[axis] - minBounds[axis];
+      this->Scale[axis] = (size > 0) ? latticeMax/size : 0;
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Id operator()(const dax::Vector3 &coordinates) const
+  {
+    const dax::Id latticeMax =
+        (dax::Id(1) << dax::exec::internal::MORTON_BITS_PER_AXIS) - 1;
+    const dax::Vector3 lattice = (coordinates - this->Origin)*this->Scale;
+    dax::Id3 ijk;
+    for (int axis = 0; axis < 3; axis++)
+      {
+      ijk[axis] = dax::math::Min(
+            latticeMax,
+            dax::math::Max(dax::Id(0), static_cast<dax::Id>(lattice[axis])));
+      }
+    return dax::exec::internal::MortonCode(ijk);
+  }
+};
+
+struct PointMortonCodeFunctor : public WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_CONT_EXPORT
+  PointMortonCodeFunctor(const MortonCodeOfCoordinates &code) : Code(code) {  }
+
+  DAX_EXEC_EXPORT dax::Id operator()(const dax::Vector3 &coordinates) const
+  {
+    return this->Code(coordinates);
+  }
+
+private:
+  MortonCodeOfCoordinates Code;
+};
+
+/// Computes the Morton code of the centroid of every cell.
+///
+struct CellMortonCodeFunctor : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_CONT_EXPORT
+  CellMortonCodeFunctor(const MortonCodeOfCoordinates &code) : Code(code) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(
+      const dax::exec::CellField<dax::Vector3,CellTag> &coordinates) const
+  {
+    dax::Vector3 centroid = coordinates[0];
+    for (int vertex = 1; vertex < coordinates.NUM_VERTICES; vertex++)
+      {
+      centroid = centroid + coordinates[vertex];
+      }
+    return this->Code(
+          centroid*(dax::Scalar(1)/coordinates.NUM_VERTICES));
+  }
+
+private:
+  MortonCodeOfCoordinates Code;
+};
+
+/// Writes the inverse of a permutation: if entry i of the input is j, entry
+/// j of the output is i.
+///
+template<class InPortalType, class OutPortalType>
+struct InversePermutationFunctor : public dax::exec::internal::WorkletBase
+{
+  InPortalType Permutation;
+  OutPortalType Inverse;
+
+  DAX_CONT_EXPORT
+  InversePermutationFunctor(const InPortalType &permutation,
+                            const OutPortalType &inverse)
+    : Permutation(permutation), Inverse(inverse) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Inverse.Set(this->Permutation.Get(index), index);
+  }
+};
+
+/// Gathers the connections of the cells in a new cell order, where entry i
+/// of CellOrder is the old index of new cell i.
+///
+template<class CellTag,
+         class CellOrderPortalType,
+         class InConnectionsPortalType,
+         class OutConnectionsPortalType>
+struct PermuteCellConnectionsFunctor : public dax::exec::internal::WorkletBase
+{
+  CellOrderPortalType CellOrder;
+  InConnectionsPortalType InConnections;
+  OutConnectionsPortalType OutConnections;
+
+  DAX_CONT_EXPORT
+  PermuteCellConnectionsFunctor(const CellOrderPortalType &cellOrder,
+                                const InConnectionsPortalType &inConnections,
+                                const OutConnectionsPortalType &outConnections)
+    : CellOrder(cellOrder),
+      InConnections(inConnections),
+      OutConnections(outConnections) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id cellIndex) const
+  {
+    const int numVertices = dax::CellTraits<CellTag>::NUM_VERTICES;
+    const dax::Id inOffset = this->CellOrder.Get(cellIndex)*numVertices;
+    const dax::Id outOffset = cellIndex*numVertices;
+    for (int vertex = 0; vertex < numVertices; vertex++)
+      {
+      this->OutConnections.Set(outOffset + vertex,
+                               this->InConnections.Get(inOffset + vertex));
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_SpatialSorterWorklets_h
@@ -0,0 +1,196 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_StructuredEdgeWorklets_h
+#define __dax_exec_internal_kernel_StructuredEdgeWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <dax/cont/internal/EdgeInterpolatedGrid.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Names the edge of a uniform grid that an interpolated point lies on.
+/// The edge from point p to its neighbor along axis a gets the id 3*p + a,
+/// so the ids are unique, smaller than three times the number of points,
+/// and ordered the same way as the sorted interpolated points. \c
+/// pointDimensions are the number of points along each axis.
+///
+/// Returns -1 when the two points do not span an edge of the grid, for
+/// example a diagonal of a voxel interpolated by a worklet that splits the
+/// voxels into tetrahedra.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id StructuredEdgeId(const dax::PointAsEdgeInterpolation &point,
+                         const dax::Id3 &pointDimensions)
+{
+  const dax::Id low = (point.EdgeIdFirst < point.EdgeIdSecond) ?
+        point.EdgeIdFirst : point.EdgeIdSecond;
+  const dax::Id step = (point.EdgeIdFirst < point.EdgeIdSecond) ?
+        point.EdgeIdSecond - point.EdgeIdFirst :
+        point.EdgeIdFirst - point.EdgeIdSecond;
+
+  // Check the largest stride first; when a dimension is flat the strides of
+  // two axes are equal but only the higher axis has edges. A step along an
+  // axis from the last point of a row, column or slice wraps to another
+  // row, so the low point must not be on the upper boundary of the axis.
+  const dax::Id sliceSize = pointDimensions[0]*pointDimensions[1];
+  if (step == sliceSize)
+    {
+    return (low/sliceSize < pointDimensions[2]-1) ? 3*low + 2 : -1;
+    }
+  if (step == pointDimensions[0])
+    {
+    return ((low/pointDimensions[0])%pointDimensions[1] <
+            pointDimensions[1]-1) ? 3*low + 1 : -1;
+    }
+  if (step == 1)
+    {
+    return (low%pointDimensions[0] < pointDimensions[0]-1) ? 3*low : -1;
+    }
+  return -1;
+}
+
+/// Returns \c point with its end points in increasing order. The weight is
+/// flipped along with them, so both forms interpolate the same point.
+///
+DAX_EXEC_CONT_EXPORT
+dax::PointAsEdgeInterpolation CanonicalEdgeInterpolation(
+    const dax::PointAsEdgeInterpolation &point)
+{
+  if (point.EdgeIdSecond < point.EdgeIdFirst)
+    {
+    return dax::PointAsEdgeInterpolation(point.EdgeIdSecond,
+                                         point.EdgeIdFirst,
+                                         1 - point.Weight);
+    }
+  return point;
+}
+
+/// Flags every edge that has an interpolated point on it and lowers its
+/// owner to the smallest index of the records on it. The owners start
+/// larger than any record index. Records on the same edge may race on the
+/// owner store, so the pass is repeated until \c Pending stays 0: a pass
+/// in which no record finds an owner larger than itself leaves every edge
+/// owned by its first record, whatever the order the records ran in.
+///
+template<class RecordsPortalType,
+         class FlagsPortalType,
+         class OwnersPortalType,
+         class PendingPortalType>
+struct StructuredEdgeClaimFunctor : public dax::exec::internal::WorkletBase
+{
+  RecordsPortalType Records;
+  FlagsPortalType EdgeFlags;
+  OwnersPortalType EdgeOwners;
+  PendingPortalType Pending;
+  dax::Id3 PointDimensions;
+
+  DAX_CONT_EXPORT
+  StructuredEdgeClaimFunctor(const RecordsPortalType &records,
+                             const FlagsPortalType &edgeFlags,
+                             const OwnersPortalType &edgeOwners,
+                             const PendingPortalType &pending,
+                             const dax::Id3 &pointDimensions)
+    : Records(records), EdgeFlags(edgeFlags), EdgeOwners(edgeOwners),
+      Pending(pending), PointDimensions(pointDimensions) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::Id edge =
+        StructuredEdgeId(this->Records.Get(index), this->PointDimensions);
+    if (edge < 0)
+      {
+      this->RaiseError("Interpolated point is not on an edge of the uniform "
+                       "grid. Duplicate points can not be resolved by edge "
+                       "for this worklet.");
+      return;
+      }
+    if (index < this->EdgeOwners.Get(edge))
+      {
+      this->EdgeFlags.Set(edge, 1);
+      this->EdgeOwners.Set(edge, index);
+      this->Pending.Set(0, 1);
+      }
+  }
+};
+
+/// Writes the interpolation weights of the output points: output point i
+/// gets the record that owns its edge, with its end points in increasing
+/// order, so the records of an edge give the same point whichever way
+/// round they name it.
+///
+template<class RecordsPortalType,
+         class OwnersPortalType,
+         class WeightsPortalType>
+struct StructuredEdgeWeightsFunctor : public dax::exec::internal::WorkletBase
+{
+  RecordsPortalType Records;
+  OwnersPortalType Owners;
+  WeightsPortalType Weights;
+
+  DAX_CONT_EXPORT
+  StructuredEdgeWeightsFunctor(const RecordsPortalType &records,
+                               const OwnersPortalType &owners,
+                               const WeightsPortalType &weights)
+    : Records(records), Owners(owners), Weights(weights) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Weights.Set(index, CanonicalEdgeInterpolation(
+                        this->Records.Get(this->Owners.Get(index))));
+  }
+};
+
+/// Writes the connections of the output cells: record i becomes the point
+/// id given to its edge.
+///
+template<class RecordsPortalType,
+         class PointIdsPortalType,
+         class ConnectionsPortalType>
+struct StructuredEdgeConnectionsFunctor
+    : public dax::exec::internal::WorkletBase
+{
+  RecordsPortalType Records;
+  PointIdsPortalType EdgePointIds;
+  ConnectionsPortalType Connections;
+  dax::Id3 PointDimensions;
+
+  DAX_CONT_EXPORT
+  StructuredEdgeConnectionsFunctor(const RecordsPortalType &records,
+                                   const PointIdsPortalType &edgePointIds,
+                                   const ConnectionsPortalType &connections,
+                                   const dax::Id3 &pointDimensions)
+    : Records(records), EdgePointIds(edgePointIds), Connections(connections),
+      PointDimensions(pointDimensions) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::Id edge =
+        StructuredEdgeId(this->Records.Get(index), this->PointDimensions);
+    this->Connections.Set(index, this->EdgePointIds.Get(edge));
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_StructuredEdgeWorklets_h
@@ -18,6 +18,7 @@
 
 #include <dax/Types.h>
 #include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/WorkletBase.h>
 #include <dax/internal/WorkletSignatureFunctions.h>
 
 namespace dax {
@@ -45,15 +46,47 @@ public:
 };
 
 
-struct ComputeVisitIndex : public WorkletMapField
+//The cell map of a generate holds each input cell once for every output it
+//makes, in order, so the visit index of an output is its distance from the
+//first output of the same input cell. This flags the outputs that start a
+//run of equal cell ids.
+template<class CellMapPortalType, class FlagsPortalType>
+struct VisitIndexRunStartFlags : dax::exec::internal::WorkletBase
 {
-  typedef void ControlSignature(FieldIn,FieldOut);
-  typedef _2 ExecutionSignature(_1,WorkId);
+  CellMapPortalType CellMap;
+  FlagsPortalType Flags;
 
-  DAX_EXEC_EXPORT dax::Id operator()(const dax::Id& LowerBoundsCount,
-                                     const dax::Id& workId) const
-  {
-    return workId - LowerBoundsCount;
+  DAX_CONT_EXPORT
+  VisitIndexRunStartFlags(const CellMapPortalType &cellMap,
+                          const FlagsPortalType &flags)
+    : CellMap(cellMap), Flags(flags) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const bool runStart =
+        (index == 0) || (this->CellMap.Get(index-1) != this->CellMap.Get(index));
+    this->Flags.Set(index, runStart ? 1 : 0);
+  }
+};
+
+//Given the inclusive scan of the run start flags, which numbers the run of
+//each output from one, and the index of the first output of every run,
+//replaces the run number of each output with its visit index.
+template<class RunStartsPortalType, class VisitIndexPortalType>
+struct VisitIndexFromRunStarts : dax::exec::internal::WorkletBase
+{
+  RunStartsPortalType RunStarts;
+  VisitIndexPortalType VisitIndices;
+
+  DAX_CONT_EXPORT
+  VisitIndexFromRunStarts(const RunStartsPortalType &runStarts,
+                          const VisitIndexPortalType &visitIndices)
+    : RunStarts(runStarts), VisitIndices(visitIndices) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const dax::Id run = this->VisitIndices.Get(index) - 1;
+    this->VisitIndices.Set(index, index - this->RunStarts.Get(run));
   }
 };
 
@@ -0,0 +1,86 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/exec/internal/FunctorMortonCells.h>
+
+#include <dax/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+struct RecordVisits
+{
+  RecordVisits(std::vector<dax::Id> *visits, std::vector<dax::Id3> *order)
+    : Visits(visits), Order(order) {  }
+
+  void SetErrorMessageBuffer(const dax::exec::internal::ErrorMessageBuffer &)
+  {  }
+
+  void operator()(dax::exec::internal::IJKIndex index) const
+  {
+    (*this->Visits)[index]++;
+    this->Order->push_back(index.GetIJK());
+  }
+
+  std::vector<dax::Id> *Visits;
+  std::vector<dax::Id3> *Order;
+};
+
+void TryDimensions(const dax::Id3 &dims)
+{
+  std::cout << "Visiting " << dims[0] << "x" << dims[1] << "x" << dims[2]
+            << " cells." << std::endl;
+  std::vector<dax::Id> visits(dims[0]*dims[1]*dims[2], 0);
+  std::vector<dax::Id3> order;
+
+  typedef dax::exec::internal::FunctorMortonCells<RecordVisits> FunctorType;
+  FunctorType functor(RecordVisits(&visits, &order), dims);
+  for (dax::Id index = 0; index < functor.GetNumberOfInstances(); index++)
+    {
+    functor(index);
+    }
+
+  for (std::size_t cell = 0; cell < visits.size(); cell++)
+    {
+    DAX_TEST_ASSERT(visits[cell] == 1, "Cell not visited exactly once.");
+    }
+
+  // The first cells of the first brick follow the Z-curve.
+  const dax::Id width = FunctorType::MORTON_BRICK_WIDTH;
+  if ((dims[0] >= width) && (dims[1] >= width) && (dims[2] >= width))
+    {
+    DAX_TEST_ASSERT(order[1] == dax::Id3(1, 0, 0), "Bad second cell.");
+    DAX_TEST_ASSERT(order[2] == dax::Id3(0, 1, 0), "Bad third cell.");
+    DAX_TEST_ASSERT(order[4] == dax::Id3(0, 0, 1), "Bad fifth cell.");
+    DAX_TEST_ASSERT(order[8] == dax::Id3(2, 0, 0), "Bad ninth cell.");
+    }
+}
+
+void TestFunctorMortonCells()
+{
+  TryDimensions(dax::Id3(8, 8, 8));
+  TryDimensions(dax::Id3(17, 9, 11));
+  TryDimensions(dax::Id3(3, 1, 2));
+  TryDimensions(dax::Id3(1, 1, 1));
+}
+
+} // anonymous namespace
+
+int UnitTestFunctorMortonCells(int, char *[])
+{
+  return dax::testing::Testing::Run(TestFunctorMortonCells);
+}
@@ -55,6 +55,41 @@ static void TestUniformGrid()
   TestGridSize(gridstruct, 1936, 1500);
 }
 
+static void TestRectilinearGrid()
+{
+  std::cout << "Testing Rectilinear grid size." << std::endl;
+
+  typedef dax::exec::internal::ArrayPortalFromIterators<
+      std::vector<dax::Scalar>::iterator> AxisPortal;
+
+  std::vector<dax::Scalar> axis(16);
+  for (std::size_t i = 0; i < axis.size(); ++i)
+    {
+    axis[i] = static_cast<dax::Scalar>(i*i);
+    }
+
+  dax::exec::internal::TopologyRectilinear<AxisPortal> gridstruct;
+  gridstruct.XCoordinates = AxisPortal(axis.begin(), axis.end());
+  gridstruct.YCoordinates = gridstruct.XCoordinates;
+  gridstruct.ZCoordinates = gridstruct.XCoordinates;
+
+  gridstruct.Extent.Min = dax::make_Id3(0, 0, 0);
+  gridstruct.Extent.Max = dax::make_Id3(10, 10, 10);
+  TestGridSize(gridstruct, 1331, 1000);
+
+  gridstruct.Extent.Min = dax::make_Id3(5, -9, 3);
+  gridstruct.Extent.Max = dax::make_Id3(15, 6, 13);
+  TestGridSize(gridstruct, 1936, 1500);
+
+  // Coordinates are looked up relative to the minimum extent.
+  dax::Vector3 coords = gridstruct.GetPointCoordiantes(dax::make_Id3(7,-8,3));
+  DAX_TEST_ASSERT(coords == dax::make_Vector3(4, 1, 0),
+                  "Rectilinear grid returned wrong point coordinates");
+  coords = gridstruct.GetPointCoordiantes(1 + 11*(2 + 16*3));
+  DAX_TEST_ASSERT(coords == dax::make_Vector3(1, 4, 9),
+                  "Rectilinear grid returned wrong point coordinates");
+}
+
 static void TestUnstructuredGrid()
 {
   std::cout << "Testing Unstructured grid size." << std::endl;
@@ -96,6 +131,7 @@ static void TestAllGrids()
 static void TestGridSizes()
 {
   TestUniformGrid();
+  TestRectilinearGrid();
   TestUnstructuredGrid();
   TestAllGrids();
 }
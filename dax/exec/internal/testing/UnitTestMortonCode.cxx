@@ -0,0 +1,72 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/exec/internal/MortonCode.h>
+
+#include <dax/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+void TestMortonCode()
+{
+  using dax::exec::internal::MortonCode;
+  using dax::exec::internal::MortonDecode;
+
+  std::cout << "Check the bit interleaving." << std::endl;
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(0, 0, 0)) == 0, "Bad code for origin.");
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(1, 0, 0)) == 1, "Bad code for i.");
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(0, 1, 0)) == 2, "Bad code for j.");
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(0, 0, 1)) == 4, "Bad code for k.");
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(2, 0, 0)) == 8, "Bad code for i=2.");
+  DAX_TEST_ASSERT(MortonCode(dax::Id3(3, 3, 3)) == 63, "Bad code for 3,3,3.");
+
+  std::cout << "Check the codes of a brick are a permutation." << std::endl;
+  const dax::Id size = 8;
+  std::vector<bool> used(size*size*size, false);
+  for (dax::Id k = 0; k < size; k++)
+    {
+    for (dax::Id j = 0; j < size; j++)
+      {
+      for (dax::Id i = 0; i < size; i++)
+        {
+        const dax::Id3 ijk(i, j, k);
+        const dax::Id code = MortonCode(ijk);
+        DAX_TEST_ASSERT((code >= 0) && (code < size*size*size),
+                        "Code out of range.");
+        DAX_TEST_ASSERT(!used[code], "Code used twice.");
+        used[code] = true;
+        DAX_TEST_ASSERT(MortonDecode(code) == ijk, "Bad decoded index.");
+        }
+      }
+    }
+
+  std::cout << "Check the largest index." << std::endl;
+  const dax::Id largest =
+      (dax::Id(1) << dax::exec::internal::MORTON_BITS_PER_AXIS) - 1;
+  const dax::Id3 corner(largest, largest, largest);
+  DAX_TEST_ASSERT(MortonCode(corner) > 0, "Code overflowed the sign bit.");
+  DAX_TEST_ASSERT(MortonDecode(MortonCode(corner)) == corner,
+                  "Bad decoded largest index.");
+}
+
+} // anonymous namespace
+
+int UnitTestMortonCode(int, char *[])
+{
+  return dax::testing::Testing::Run(TestMortonCode);
+}
@@ -105,6 +105,15 @@ public:
            rangeMax);
   }
 
+  template<class FunctorType>
+  DAX_CONT_EXPORT
+  static void Schedule(FunctorType functor, dax::Id2 rangeMax)
+  {
+    Superclass::Schedule(
+           DeviceAdapterAlgorithm::ScheduleKernel<FunctorType>(functor),
+           rangeMax);
+  }
+
   DAX_CONT_EXPORT static void Synchronize()
   {
     // Nothing to do. This OpenMP schedules all of its operations using a
@@ -43,6 +43,7 @@
 //and should be included in future version of TBB.
 #include <dax/tbb/cont/internal/parallel_sort.h>
 #include <tbb/blocked_range.h>
+#include <tbb/blocked_range2d.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_scan.h>
@@ -413,6 +414,82 @@ public:
       }
   }
 
+private:
+  template<class FunctorType>
+  class ScheduleKernelId2
+  {
+  public:
+    DAX_CONT_EXPORT ScheduleKernelId2(const FunctorType &functor,
+                                      const dax::Id2& dims)
+      : Functor(functor),
+        Dims(dims)
+      {  }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &errorMessage)
+    {
+      this->ErrorMessage = errorMessage;
+      this->Functor.SetErrorMessageBuffer(errorMessage);
+    }
+
+    DAX_EXEC_EXPORT
+    void operator()(const ::tbb::blocked_range2d<dax::Id> &range) const {
+      try
+        {
+        dax::exec::internal::IJKIndex index(
+              dax::make_Id3(this->Dims[0], this->Dims[1], 1));
+        for( dax::Id j=range.rows().begin(); j!=range.rows().end(); ++j)
+          {
+          index.SetJ(j);
+          for( dax::Id i=range.cols().begin(); i!=range.cols().end(); ++i)
+            {
+            index.SetI(i);
+            this->Functor(index);
+            }
+          }
+        }
+      catch (dax::cont::Error error)
+        {
+        this->ErrorMessage.RaiseError(error.GetMessage().c_str());
+        }
+      catch (...)
+        {
+        this->ErrorMessage.RaiseError(
+            "Unexpected error in execution environment.");
+        }
+    }
+  private:
+    FunctorType Functor;
+    dax::Id2 Dims;
+    dax::exec::internal::ErrorMessageBuffer ErrorMessage;
+  };
+
+public:
+  template<class FunctorType>
+  DAX_CONT_EXPORT
+  static void Schedule(FunctorType functor,
+                       dax::Id2 rangeMax)
+  {
+    const dax::Id MESSAGE_SIZE = 1024;
+    char errorString[MESSAGE_SIZE];
+    errorString[0] = '\0';
+    dax::exec::internal::ErrorMessageBuffer
+        errorMessage(errorString, MESSAGE_SIZE);
+
+    ::tbb::blocked_range2d<dax::Id> range(0, rangeMax[1],
+                                          0, rangeMax[0]);
+
+    ScheduleKernelId2<FunctorType> kernel(functor,rangeMax);
+    kernel.SetErrorMessageBuffer(errorMessage);
+
+    ::tbb::parallel_for(range, kernel);
+
+    if (errorMessage.IsErrorRaised())
+      {
+      throw dax::cont::ErrorExecution(errorString);
+      }
+  }
+
   template<typename T, class Container>
   DAX_CONT_EXPORT static void Sort(
       dax::cont::ArrayHandle<T,Container,dax::tbb::cont::DeviceAdapterTagTBB>
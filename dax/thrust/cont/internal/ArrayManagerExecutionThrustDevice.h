@@ -155,6 +155,38 @@ public:
     this->Array.resize(numberOfValues);
   }
 
+  /// Resizes the device vector, keeping its values. Thrust grows the
+  /// capacity geometrically, so repeated growth is amortized and the data
+  /// never leaves the device.
+  ///
+  DAX_CONT_EXPORT void Resize(ContainerType &daxNotUsed(container),
+                              dax::Id numberOfValues)
+  {
+    try
+      {
+      this->Array.resize(numberOfValues);
+      }
+    catch (std::bad_alloc error)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(error.what());
+      }
+  }
+
+  /// Reserves space in the device vector, keeping its values.
+  ///
+  DAX_CONT_EXPORT void Reserve(ContainerType &daxNotUsed(container),
+                               dax::Id numberOfValues)
+  {
+    try
+      {
+      this->Array.reserve(numberOfValues);
+      }
+    catch (std::bad_alloc error)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(error.what());
+      }
+  }
+
   DAX_CONT_EXPORT PortalType GetPortal()
   {
     return PortalType(::thrust::raw_pointer_cast(&(*this->Array.begin())),
@@ -444,6 +444,15 @@ public:
     DAAT::Schedule(functor, rangeMax[0]*rangeMax[1]*rangeMax[2]);
   }
 
+  template<class FunctorType>
+  DAX_CONT_EXPORT
+  static void Schedule(FunctorType functor, const dax::Id2& rangeMax)
+  {
+    //like the 3D schedule, defer to the default schedule implementation.
+    typedef DeviceAdapterAlgorithmThrust<DeviceAdapterTag> DAAT;
+    DAAT::Schedule(functor, rangeMax[0]*rangeMax[1]);
+  }
+
   template<typename T, class Container>
   DAX_CONT_EXPORT static void Sort(
       dax::cont::ArrayHandle<T,Container,DeviceAdapterTag>& values)
@@ -18,6 +18,8 @@
 
 #include <dax/thrust/cont/internal/CheckThrustBackend.h>
 
+#include <dax/cont/MemoryTracker.h>
+
 // Disable GCC warnings we check Dax for but Thrust does not.
 #if defined(__GNUC__) && !defined(DAX_CUDA)
 #if (__GNUC__ >= 4) && (__GNUC_MINOR__ >= 6)
@@ -30,6 +32,7 @@
 #endif // gcc && !CUDA
 
 #include <thrust/device_malloc_allocator.h>
+#include <thrust/memory.h>
 
 
 #if defined(__GNUC__) && !defined(DAX_CUDA)
@@ -46,11 +49,16 @@ namespace internal {
 
 // UninitializedAllocator is an allocator which
 // derives from device_allocator and which has a
-// no-op construct member function
+// no-op construct member function. It also reports
+// its allocations to the dax::cont::MemoryTracker.
 template<typename T>
   struct UninitializedAllocator
     : ::thrust::device_malloc_allocator<T>
 {
+  typedef ::thrust::device_malloc_allocator<T> Superclass;
+  typedef typename Superclass::pointer pointer;
+  typedef typename Superclass::size_type size_type;
+
   // note that construct is annotated as
   // a __host__ __device__ function
   __host__ __device__
@@ -58,6 +66,23 @@ template<typename T>
   {
     // no-op
   }
+
+  __host__
+  pointer allocate(size_type cnt)
+  {
+    pointer result = this->Superclass::allocate(cnt);
+    dax::cont::MemoryTracker::RecordAllocation(
+          ::thrust::raw_pointer_cast(result), cnt*sizeof(T));
+    return result;
+  }
+
+  __host__
+  void deallocate(pointer p, size_type cnt)
+  {
+    dax::cont::MemoryTracker::RecordDeallocation(
+          ::thrust::raw_pointer_cast(p));
+    this->Superclass::deallocate(p, cnt);
+  }
 };
 
 }
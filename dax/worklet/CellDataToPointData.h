@@ -18,16 +18,16 @@
 
 #include <dax/exec/CellVertices.h>
 #include <dax/exec/WorkletGenerateKeysValues.h>
+#include <dax/exec/WorkletMapPoint.h>
 #include <dax/exec/WorkletReduceKeysValues.h>
 
 namespace dax {
 namespace worklet {
 
-// It might be prudent to change this to create keys and values separately.
-// That way if you have multiple fields to interpolate, you can do them one at
-// atime without continually recreating keys.  It would nice if the dispatcher
-// for generate keys values was able to cache the indexing structures so that
-// they did not have to continually be rebuilt.
+// The generate keys and reduce keys worklets rebuild the point indexing
+// structures for every field. When several fields are converted on the same
+// grid, build the point to cell links of the grid once and use
+// CellDataToPointDataAverage with a dax::cont::DispatcherMapPoint instead.
 
 class CellDataToPointDataGenerateKeys
   : public dax::exec::WorkletGenerateKeysValues
@@ -73,6 +73,32 @@ public:
   }
 };
 
+/// Averages a cell field over the cells incident to each point. Run with a
+/// dax::cont::DispatcherMapPoint created from the point to cell links of the
+/// grid.
+///
+class CellDataToPointDataAverage : public dax::exec::WorkletMapPoint
+{
+public:
+  typedef void ControlSignature(FieldCellIn, FieldPointOut);
+  typedef _2 ExecutionSignature(AsIncidentCells(_1));
+
+  template<typename IncidentCellsType>
+  DAX_EXEC_EXPORT
+  typename IncidentCellsType::ValueType
+  operator()(const IncidentCellsType &cellValues) const
+  {
+    typedef typename IncidentCellsType::ValueType VType;
+    VType averageValue = VType();
+    const dax::Id numCells = cellValues.GetNumberOfValues();
+    if (numCells == 0) { return averageValue; }
+    for(dax::Id iCtr = 0; iCtr < numCells; iCtr++)
+      {
+      averageValue += cellValues[iCtr];
+      }
+    return (averageValue / numCells);
+  }
+};
 
 } } // namespace dax::worklet
 
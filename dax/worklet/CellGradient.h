@@ -47,6 +47,34 @@ public:
   }
 };
 
+/// The two dimensional variant of CellGradient for images and other grids of
+/// quadrilateral cells lying in the xy plane. Only the in-plane components of
+/// the gradient are written, which halves the output compared to CellGradient.
+///
+class CellGradient2D : public dax::exec::WorkletMapCell
+{
+public:
+
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldPointIn, FieldOut);
+  typedef _4 ExecutionSignature(_2,_3);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Vector2 operator()(
+      const dax::exec::CellField<dax::Vector3,CellTag> &coords,
+      const dax::exec::CellField<dax::Scalar,CellTag> &pointField) const
+  {
+    dax::Vector3 parametricCellCenter =
+        dax::exec::ParametricCoordinates<CellTag>::Center();
+    const dax::Vector3 gradient =
+        dax::exec::CellDerivative(parametricCellCenter,
+                                  coords,
+                                  pointField,
+                                  CellTag());
+    return dax::make_Vector2(gradient[0], gradient[1]);
+  }
+};
+
 }
 } // namespace dax::worklet
 
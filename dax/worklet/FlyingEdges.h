@@ -0,0 +1,628 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_worklet_FlyingEdges_h
+#define __dax_worklet_FlyingEdges_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/MemoryTracker.h>
+#include <dax/cont/TopologyPlan.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/internal/EdgeInterpolatedGrid.h>
+
+#include <dax/worklet/internal/MarchingCubesTable.h>
+
+namespace dax {
+namespace worklet {
+
+namespace internal {
+namespace flyingedges {
+
+// The rows of a uniform grid run along the x axis. Row r holds the points
+// (i, j, k) with r = j + k*ny, and owns the edges that leave its points in
+// the +x, +y and +z directions. The points of a row are numbered x edges
+// first, then y edges, then z edges, each in order of i.
+
+// -----------------------------------------------------------------------------
+/// Finds the range of a row of points, or of cells, that can cross the
+/// contour when looking at a few neighboring rows together. Outside of the
+/// first and last crossed x edges every row is constant, so the only
+/// crossings left there are between rows with a different classification
+/// at the ends. Points in [left, right] and cells in [left, right) need to
+/// be visited.
+///
+template<class ClassPortalType, class IdPortalType>
+DAX_EXEC_EXPORT
+void TrimRows(const dax::Id rows[],
+              int numRows,
+              dax::Id rowLength,
+              const ClassPortalType &classes,
+              const IdPortalType &xMins,
+              const IdPortalType &xMaxs,
+              dax::Id &left,
+              dax::Id &right)
+{
+  left = rowLength;
+  right = 0;
+  bool leftDiffers = false;
+  bool rightDiffers = false;
+  const dax::Id leftClass = classes.Get(rows[0]*rowLength);
+  const dax::Id rightClass = classes.Get(rows[0]*rowLength + rowLength - 1);
+  for (int index = 0; index < numRows; index++)
+    {
+    const dax::Id rowMin = xMins.Get(rows[index]);
+    const dax::Id rowMax = xMaxs.Get(rows[index]);
+    left = (rowMin < left) ? rowMin : left;
+    right = (rowMax > right) ? rowMax : right;
+    leftDiffers |=
+        (classes.Get(rows[index]*rowLength) != leftClass);
+    rightDiffers |=
+        (classes.Get(rows[index]*rowLength + rowLength - 1) != rightClass);
+    }
+  if (leftDiffers) { left = 0; }
+  if (rightDiffers) { right = rowLength - 1; }
+}
+
+// -----------------------------------------------------------------------------
+/// Returns 1 if point i of one row and point i of another row lie on
+/// different sides of the contour.
+///
+template<class ClassPortalType>
+DAX_EXEC_EXPORT
+dax::Id Crossed(const ClassPortalType &classes,
+                dax::Id rowLength,
+                dax::Id row,
+                dax::Id otherRow,
+                dax::Id i)
+{
+  return (classes.Get(row*rowLength+i) !=
+          classes.Get(otherRow*rowLength+i)) ? 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+/// Returns the marching cubes case of cell i of the row of cells between
+/// rows (j, k), (j+1, k), (j, k+1) and (j+1, k+1).
+///
+template<class ClassPortalType>
+DAX_EXEC_EXPORT
+int CellClass(const ClassPortalType &classes,
+              dax::Id rowLength,
+              const dax::Id rows[],
+              dax::Id i)
+{
+  return (classes.Get(rows[0]*rowLength+i) << 0 |
+          classes.Get(rows[0]*rowLength+i+1) << 1 |
+          classes.Get(rows[1]*rowLength+i+1) << 2 |
+          classes.Get(rows[1]*rowLength+i) << 3 |
+          classes.Get(rows[2]*rowLength+i) << 4 |
+          classes.Get(rows[2]*rowLength+i+1) << 5 |
+          classes.Get(rows[3]*rowLength+i+1) << 6 |
+          classes.Get(rows[3]*rowLength+i) << 7);
+}
+
+// -----------------------------------------------------------------------------
+/// First pass over the rows: classifies the points of a row against the
+/// iso value and counts the x edges that cross it, keeping the first and
+/// last of them to trim the later passes.
+///
+template<class FieldPortalType, class ClassPortalType, class IdPortalType>
+struct ClassifyRows : public dax::exec::internal::WorkletBase
+{
+  FieldPortalType Field;
+  ClassPortalType Classes;
+  IdPortalType XCounts;
+  IdPortalType XMins;
+  IdPortalType XMaxs;
+  dax::Scalar IsoValue;
+  dax::Id RowLength;
+
+  DAX_CONT_EXPORT
+  ClassifyRows(const FieldPortalType &field,
+               const ClassPortalType &classes,
+               const IdPortalType &xCounts,
+               const IdPortalType &xMins,
+               const IdPortalType &xMaxs,
+               dax::Scalar isoValue,
+               dax::Id rowLength)
+    : Field(field), Classes(classes), XCounts(xCounts), XMins(xMins),
+      XMaxs(xMaxs), IsoValue(isoValue), RowLength(rowLength) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    const dax::Id start = row*this->RowLength;
+    dax::Id count = 0;
+    dax::Id xMin = this->RowLength;
+    dax::Id xMax = 0;
+    unsigned char previous = 0;
+    for (dax::Id i = 0; i < this->RowLength; i++)
+      {
+      const unsigned char pointClass =
+          static_cast<dax::Scalar>(this->Field.Get(start+i)) > this->IsoValue;
+      this->Classes.Set(start+i, pointClass);
+      if (i > 0 && pointClass != previous)
+        {
+        count++;
+        xMin = (xMin == this->RowLength) ? i-1 : xMin;
+        xMax = i;
+        }
+      previous = pointClass;
+      }
+    this->XCounts.Set(row, count);
+    this->XMins.Set(row, xMin);
+    this->XMaxs.Set(row, xMax);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Second pass over the rows: counts the y and z edges of a row that cross
+/// the contour and the triangles of the row of cells in front of it.
+///
+template<class ClassPortalType, class IdPortalConstType, class IdPortalType>
+struct CountRows : public dax::exec::internal::WorkletBase
+{
+  ClassPortalType Classes;
+  IdPortalConstType XCounts;
+  IdPortalConstType XMins;
+  IdPortalConstType XMaxs;
+  IdPortalType YCounts;
+  IdPortalType PointCounts;
+  IdPortalType TriangleCounts;
+  dax::Id3 PointDimensions;
+
+  DAX_CONT_EXPORT
+  CountRows(const ClassPortalType &classes,
+            const IdPortalConstType &xCounts,
+            const IdPortalConstType &xMins,
+            const IdPortalConstType &xMaxs,
+            const IdPortalType &yCounts,
+            const IdPortalType &pointCounts,
+            const IdPortalType &triangleCounts,
+            const dax::Id3 &pointDimensions)
+    : Classes(classes), XCounts(xCounts), XMins(xMins), XMaxs(xMaxs),
+      YCounts(yCounts), PointCounts(pointCounts),
+      TriangleCounts(triangleCounts), PointDimensions(pointDimensions) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    const dax::Id nx = this->PointDimensions[0];
+    const dax::Id ny = this->PointDimensions[1];
+    const dax::Id nz = this->PointDimensions[2];
+    const dax::Id j = row % ny;
+    const dax::Id k = row / ny;
+    const dax::Id rows[4] = { row, row+1, row+ny, row+ny+1 };
+    const dax::Id zRows[2] = { row, row+ny };
+    dax::Id left, right;
+
+    dax::Id yCount = 0;
+    if (j < ny-1)
+      {
+      TrimRows(rows, 2, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      yCount = this->CountCrossings(row, row+1, left, right);
+      }
+
+    dax::Id zCount = 0;
+    if (k < nz-1)
+      {
+      TrimRows(zRows, 2, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      zCount = this->CountCrossings(row, row+ny, left, right);
+      }
+
+    dax::Id triangleCount = 0;
+    if (j < ny-1 && k < nz-1)
+      {
+      using dax::worklet::internal::marchingcubes::NumFaces;
+      TrimRows(rows, 4, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      for (dax::Id i = left; i < right; i++)
+        {
+        triangleCount += NumFaces[CellClass(this->Classes, nx, rows, i)];
+        }
+      }
+
+    this->YCounts.Set(row, yCount);
+    this->PointCounts.Set(row, this->XCounts.Get(row) + yCount + zCount);
+    this->TriangleCounts.Set(row, triangleCount);
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Id CountCrossings(dax::Id row,
+                         dax::Id otherRow,
+                         dax::Id left,
+                         dax::Id right) const
+  {
+    dax::Id count = 0;
+    for (dax::Id i = left; i <= right; i++)
+      {
+      count += Crossed(this->Classes, this->PointDimensions[0],
+                       row, otherRow, i);
+      }
+    return count;
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Last pass over the rows: writes the interpolation of every point the row
+/// owns and the triangles of the row of cells in front of it. The point ids
+/// of the triangles are found by walking the rows around the cells and
+/// counting the crossed edges, so every point is written exactly once.
+///
+template<class FieldPortalType,
+         class ClassPortalType,
+         class IdPortalConstType,
+         class RecordsPortalType,
+         class ConnectionsPortalType,
+         class CellMapPortalType>
+struct GenerateRows : public dax::exec::internal::WorkletBase
+{
+  FieldPortalType Field;
+  ClassPortalType Classes;
+  IdPortalConstType XCounts;
+  IdPortalConstType XMins;
+  IdPortalConstType XMaxs;
+  IdPortalConstType YCounts;
+  IdPortalConstType PointOffsets;
+  IdPortalConstType TriangleOffsets;
+  RecordsPortalType Records;
+  ConnectionsPortalType Connections;
+  CellMapPortalType CellMap;
+  dax::Scalar IsoValue;
+  dax::Id3 PointDimensions;
+
+  DAX_CONT_EXPORT
+  GenerateRows(const FieldPortalType &field,
+               const ClassPortalType &classes,
+               const IdPortalConstType &xCounts,
+               const IdPortalConstType &xMins,
+               const IdPortalConstType &xMaxs,
+               const IdPortalConstType &yCounts,
+               const IdPortalConstType &pointOffsets,
+               const IdPortalConstType &triangleOffsets,
+               const RecordsPortalType &records,
+               const ConnectionsPortalType &connections,
+               const CellMapPortalType &cellMap,
+               dax::Scalar isoValue,
+               const dax::Id3 &pointDimensions)
+    : Field(field), Classes(classes), XCounts(xCounts), XMins(xMins),
+      XMaxs(xMaxs), YCounts(yCounts), PointOffsets(pointOffsets),
+      TriangleOffsets(triangleOffsets), Records(records),
+      Connections(connections), CellMap(cellMap), IsoValue(isoValue),
+      PointDimensions(pointDimensions) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    const dax::Id nx = this->PointDimensions[0];
+    const dax::Id ny = this->PointDimensions[1];
+    const dax::Id nz = this->PointDimensions[2];
+    const dax::Id j = row % ny;
+    const dax::Id k = row / ny;
+    const dax::Id rows[4] = { row, row+1, row+ny, row+ny+1 };
+    const dax::Id zRows[2] = { row, row+ny };
+    dax::Id left, right;
+
+    // The points on the edges this row owns.
+    dax::Id pointId = this->PointOffsets.Get(row);
+    for (dax::Id i = this->XMins.Get(row); i < this->XMaxs.Get(row); i++)
+      {
+      pointId = this->WriteCrossing(row*nx+i, row*nx+i+1, pointId);
+      }
+    if (j < ny-1)
+      {
+      TrimRows(rows, 2, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      for (dax::Id i = left; i <= right; i++)
+        {
+        pointId = this->WriteCrossing(row*nx+i, (row+1)*nx+i, pointId);
+        }
+      }
+    if (k < nz-1)
+      {
+      TrimRows(zRows, 2, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      for (dax::Id i = left; i <= right; i++)
+        {
+        pointId = this->WriteCrossing(row*nx+i, (row+ny)*nx+i, pointId);
+        }
+      }
+
+    if (j < ny-1 && k < nz-1)
+      {
+      TrimRows(rows, 4, nx, this->Classes, this->XMins, this->XMaxs,
+               left, right);
+      this->WriteTriangles(rows, j, k, left, right);
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Id WriteCrossing(dax::Id low, dax::Id high, dax::Id pointId) const
+  {
+    if (this->Classes.Get(low) == this->Classes.Get(high))
+      {
+      return pointId;
+      }
+    const dax::Scalar lowValue = static_cast<dax::Scalar>(this->Field.Get(low));
+    const dax::Scalar highValue =
+        static_cast<dax::Scalar>(this->Field.Get(high));
+    const dax::Scalar weight =
+        (this->IsoValue - lowValue) / (highValue - lowValue);
+    this->Records.Set(pointId,
+                      dax::PointAsEdgeInterpolation(low, high, weight));
+    return pointId+1;
+  }
+
+  DAX_EXEC_EXPORT
+  void WriteTriangles(const dax::Id rows[],
+                      dax::Id j,
+                      dax::Id k,
+                      dax::Id left,
+                      dax::Id right) const
+  {
+    using dax::worklet::internal::marchingcubes::NumFaces;
+    using dax::worklet::internal::marchingcubes::TriTable;
+
+    const dax::Id nx = this->PointDimensions[0];
+    const dax::Id ny = this->PointDimensions[1];
+    const dax::Id cellRowStart = (nx-1)*(j + (ny-1)*k);
+
+    // Where the y and z points of the rows around the cells start.
+    dax::Id xBase[4];
+    for (int r = 0; r < 4; r++)
+      {
+      xBase[r] = this->PointOffsets.Get(rows[r]);
+      }
+    const dax::Id yBase[2] = { xBase[0] + this->XCounts.Get(rows[0]),
+                               xBase[2] + this->XCounts.Get(rows[2]) };
+    const dax::Id zBase[2] = { yBase[0] + this->YCounts.Get(rows[0]),
+                               xBase[1] + this->XCounts.Get(rows[1]) +
+                               this->YCounts.Get(rows[1]) };
+
+    // No edge crosses the contour before left, so every count starts at 0.
+    dax::Id xSeen[4] = { 0, 0, 0, 0 };
+    dax::Id ySeen[2] = { 0, 0 };
+    dax::Id zSeen[2] = { 0, 0 };
+
+    dax::Id triangle = this->TriangleOffsets.Get(rows[0]);
+    for (dax::Id i = left; i < right; i++)
+      {
+      dax::Id xCrossed[4];
+      for (int r = 0; r < 4; r++)
+        {
+        xCrossed[r] = (this->Classes.Get(rows[r]*nx+i) !=
+                       this->Classes.Get(rows[r]*nx+i+1)) ? 1 : 0;
+        }
+      const dax::Id yCrossed[2] = {
+        Crossed(this->Classes, nx, rows[0], rows[1], i),
+        Crossed(this->Classes, nx, rows[2], rows[3], i) };
+      const dax::Id zCrossed[2] = {
+        Crossed(this->Classes, nx, rows[0], rows[2], i),
+        Crossed(this->Classes, nx, rows[1], rows[3], i) };
+
+      const int cellClass = CellClass(this->Classes, nx, rows, i);
+      const int numFaces = NumFaces[cellClass];
+      if (numFaces > 0)
+        {
+        // Point ids of the 12 voxel edges, in the order of the marching
+        // cubes tables.
+        const dax::Id edgeIds[12] = {
+          xBase[0] + xSeen[0],
+          yBase[0] + ySeen[0] + yCrossed[0],
+          xBase[1] + xSeen[1],
+          yBase[0] + ySeen[0],
+          xBase[2] + xSeen[2],
+          yBase[1] + ySeen[1] + yCrossed[1],
+          xBase[3] + xSeen[3],
+          yBase[1] + ySeen[1],
+          zBase[0] + zSeen[0],
+          zBase[0] + zSeen[0] + zCrossed[0],
+          zBase[1] + zSeen[1] + zCrossed[1],
+          zBase[1] + zSeen[1]
+        };
+        const dax::Id cellIndex = cellRowStart + i;
+        for (int face = 0; face < numFaces; face++, triangle++)
+          {
+          for (int vertex = 0; vertex < 3; vertex++)
+            {
+            this->Connections.Set(3*triangle + vertex,
+                                  edgeIds[TriTable[cellClass][3*face+vertex]]);
+            }
+          this->CellMap.Set(triangle, cellIndex);
+          }
+        }
+
+      for (int r = 0; r < 4; r++) { xSeen[r] += xCrossed[r]; }
+      ySeen[0] += yCrossed[0];
+      ySeen[1] += yCrossed[1];
+      zSeen[0] += zCrossed[0];
+      zSeen[1] += zCrossed[1];
+      }
+  }
+};
+
+}
+} //internal::flyingedges
+
+// -----------------------------------------------------------------------------
+/// Contours a scalar point field of a uniform grid with the Flying Edges
+/// algorithm. Where the MarchingCubesCount and MarchingCubesGenerate
+/// worklets visit every cell and find the duplicate points afterwards, this
+/// dispatcher walks the grid one row of points at a time:
+///
+/// 1. Classify the points of each row and find the first and last x edges
+///    that cross the contour.
+/// 2. Count the y and z edge crossings and the triangles of each row, only
+///    looking at the part of the row between those bounds.
+/// 3. Scan the counts of the rows to find where each row writes.
+/// 4. Write the points each row owns and its triangles.
+///
+/// Every point is written once by the row that owns its edge, so no
+/// duplicates need to be removed, and the output is the same as the one of
+/// DispatcherGenerateInterpolatedCells with duplicate points removed, up to
+/// the numbering of the points.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class DispatcherFlyingEdges
+{
+public:
+  typedef dax::cont::TopologyPlan<DeviceAdapterTag> TopologyPlanType;
+
+  DAX_CONT_EXPORT
+  DispatcherFlyingEdges(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  DAX_CONT_EXPORT
+  void SetIsoValue(dax::Scalar isoValue) { this->IsoValue = isoValue; }
+
+  DAX_CONT_EXPORT
+  dax::Scalar GetIsoValue() const { return this->IsoValue; }
+
+  /// Contours \c field on \c grid and writes the triangles to \c outputGrid,
+  /// which needs to be a grid of triangles.
+  ///
+  template<class FieldHandleType, class OutputGridType>
+  DAX_CONT_EXPORT
+  void Invoke(const dax::cont::UniformGrid<DeviceAdapterTag> &grid,
+              const FieldHandleType &field,
+              OutputGridType &outputGrid)
+  {
+    dax::cont::MemoryTrackerScope memoryScope(
+        "DispatcherFlyingEdges::Invoke");
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id,
+        dax::cont::ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef dax::cont::ArrayHandle<unsigned char,
+        dax::cont::ArrayContainerControlTagBasic,
+        DeviceAdapterTag> ClassArrayHandleType;
+    typedef typename IdArrayHandleType::PortalExecution IdPortalType;
+    typedef typename IdArrayHandleType::PortalConstExecution IdPortalConstType;
+    typedef typename ClassArrayHandleType::PortalConstExecution
+        ClassPortalConstType;
+    typedef typename FieldHandleType::PortalConstExecution FieldPortalType;
+    typedef typename TopologyPlanType::InterpolationWeightsType
+        RecordsHandleType;
+
+    this->Plan.ReleaseResources();
+
+    const dax::Id3 dims = dax::extentDimensions(grid.GetExtent());
+    const dax::Id numRows = dims[1]*dims[2];
+
+    ClassArrayHandleType classes;
+    IdArrayHandleType xCounts;
+    IdArrayHandleType xMins;
+    IdArrayHandleType xMaxs;
+    internal::flyingedges::ClassifyRows<FieldPortalType,
+        typename ClassArrayHandleType::PortalExecution,
+        IdPortalType>
+        classify(field.PrepareForInput(),
+                 classes.PrepareForOutput(grid.GetNumberOfPoints()),
+                 xCounts.PrepareForOutput(numRows),
+                 xMins.PrepareForOutput(numRows),
+                 xMaxs.PrepareForOutput(numRows),
+                 this->IsoValue,
+                 dims[0]);
+    Algorithm::Schedule(classify, numRows);
+
+    IdArrayHandleType yCounts;
+    IdArrayHandleType pointOffsets;
+    IdArrayHandleType triangleOffsets;
+    internal::flyingedges::CountRows<ClassPortalConstType,
+        IdPortalConstType,
+        IdPortalType>
+        count(classes.PrepareForInput(),
+              xCounts.PrepareForInput(),
+              xMins.PrepareForInput(),
+              xMaxs.PrepareForInput(),
+              yCounts.PrepareForOutput(numRows),
+              pointOffsets.PrepareForOutput(numRows),
+              triangleOffsets.PrepareForOutput(numRows),
+              dims);
+    Algorithm::Schedule(count, numRows);
+
+    const dax::Id numPoints =
+        Algorithm::ScanExclusive(pointOffsets, pointOffsets);
+    const dax::Id numTriangles =
+        Algorithm::ScanExclusive(triangleOffsets, triangleOffsets);
+
+    RecordsHandleType records;
+    IdArrayHandleType cellMap;
+    internal::flyingedges::GenerateRows<FieldPortalType,
+        ClassPortalConstType,
+        IdPortalConstType,
+        typename RecordsHandleType::PortalExecution,
+        typename OutputGridType::CellConnectionsType::PortalExecution,
+        IdPortalType>
+        generate(field.PrepareForInput(),
+                 classes.PrepareForInput(),
+                 xCounts.PrepareForInput(),
+                 xMins.PrepareForInput(),
+                 xMaxs.PrepareForInput(),
+                 yCounts.PrepareForInput(),
+                 pointOffsets.PrepareForInput(),
+                 triangleOffsets.PrepareForInput(),
+                 records.PrepareForOutput(numPoints),
+                 outputGrid.GetCellConnections().PrepareForOutput(
+                   3*numTriangles),
+                 cellMap.PrepareForOutput(numTriangles),
+                 this->IsoValue,
+                 dims);
+    Algorithm::Schedule(generate, numRows);
+
+    TopologyPlanType plan(cellMap);
+    plan.SetInterpolationWeights(records);
+    this->Plan = plan;
+
+    if (!this->CompactPointField(grid.GetPointCoordinates(),
+                                 outputGrid.GetPointCoordinates()))
+      {
+      // The contour is empty.
+      outputGrid.GetPointCoordinates().PrepareForOutput(0);
+      }
+  }
+
+  /// Interpolates a point field of the input grid to the points of the
+  /// contour generated by the last invoke. Returns false if the contour
+  /// has no points.
+  ///
+  template<typename T, typename Container1, typename Container2>
+  DAX_CONT_EXPORT
+  bool CompactPointField(
+      const dax::cont::ArrayHandle<T,Container1,DeviceAdapterTag>& input,
+      dax::cont::ArrayHandle<T,Container2,DeviceAdapterTag>& output) const
+  {
+    return this->Plan.CompactPointField(input, output);
+  }
+
+  /// Returns the plan of the last invoke, which maps the cells of the
+  /// contour to the cells they came from and its points to the edges they
+  /// lie on.
+  ///
+  DAX_CONT_EXPORT
+  TopologyPlanType GetTopologyPlan() const { return this->Plan; }
+
+private:
+  dax::Scalar IsoValue;
+  TopologyPlanType Plan;
+};
+
+}
+} //dax::worklet
+
+#endif //__dax_worklet_FlyingEdges_h
@@ -0,0 +1,174 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#ifndef __MarchingSquares_worklet_
+#define __MarchingSquares_worklet_
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+#include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/worklet/internal/MarchingSquaresTable.h>
+
+namespace dax {
+namespace worklet {
+
+namespace internal{
+namespace marchingsquares{
+// -----------------------------------------------------------------------------
+template<typename T, typename U>
+DAX_EXEC_EXPORT
+int GetQuadrilateralClassification(const T isoValue, const U& values )
+{
+  return ((values[0] > isoValue) << 0 |
+          (values[1] > isoValue) << 1 |
+          (values[2] > isoValue) << 2 |
+          (values[3] > isoValue) << 3);
+}
+}
+}
+
+// -----------------------------------------------------------------------------
+/// The counting pass of marching squares: the two dimensional analogue of
+/// MarchingCubesCount that returns the number of contour line segments
+/// generated by each quadrilateral (or pixel) cell.
+///
+class MarchingSquaresCount : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_CONT_EXPORT MarchingSquaresCount(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &values) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    return this->GetNumLines(
+          values,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id GetNumLines(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                      dax::CellTagQuadrilateral) const
+  {
+    const int quadClass =
+    internal::marchingsquares::GetQuadrilateralClassification(IsoValue,values);
+    return dax::worklet::internal::marchingsquares::NumLines[quadClass];
+  }
+};
+
+
+// -----------------------------------------------------------------------------
+/// The generate pass of marching squares. Each visit of a cell produces one
+/// line segment whose end points are interpolated along the cell edges.
+///
+class MarchingSquaresGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, FieldPointIn);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3, VisitIndex);
+
+  DAX_CONT_EXPORT MarchingSquaresGenerate(dax::Scalar isoValue)
+    : IsoValue(isoValue){ }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagLine>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildLine(
+          verts,
+          outCell,
+          values,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void BuildLine(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagLine>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagQuadrilateral) const
+  {
+    using dax::worklet::internal::marchingsquares::LineTable;
+    const unsigned char cellVertEdges[4][2] ={
+        {0,1}, {1,2}, {3,2}, {0,3},
+      };
+
+    const int quadClass =
+      internal::marchingsquares::GetQuadrilateralClassification(IsoValue,values);
+
+    //save the point ids and ratio to interpolate the points of the new cell
+    for (dax::Id outVertIndex = 0;
+         outVertIndex < outCell.NUM_VERTICES;
+         ++outVertIndex)
+      {
+      const unsigned char edge =
+          LineTable[quadClass][(inputCellVisitIndex*2)+outVertIndex];
+      int vertA;
+      int vertB;
+      if (verts[cellVertEdges[edge][0]] < verts[cellVertEdges[edge][1]])
+        {
+        vertA = cellVertEdges[edge][0];
+        vertB = cellVertEdges[edge][1];
+        }
+      else
+        {
+        vertA = cellVertEdges[edge][1];
+        vertB = cellVertEdges[edge][0];
+        }
+
+      // Find the weight for linear interpolation
+      const dax::Scalar weight = (IsoValue - values[vertA]) /
+                                (values[vertB]-values[vertA]);
+
+      outCell.SetInterpolationPoint(outVertIndex,
+                                    verts[vertA],
+                                    verts[vertB],
+                                    weight);
+      }
+  }
+};
+}
+} //dax::worklet
+
+#endif
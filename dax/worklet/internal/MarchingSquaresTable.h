@@ -0,0 +1,56 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_worklet_internal_MarchingSquaresTable_h
+#define __dax_worklet_internal_MarchingSquaresTable_h
+
+#include <dax/internal/ExportMacros.h>
+
+namespace dax {
+namespace worklet{
+namespace internal{
+namespace marchingsquares{
+
+// ------------------------------------------------------------------- numLines
+DAX_EXEC_CONSTANT_EXPORT const unsigned char NumLines[16] =
+{ 0, 1, 1, 1, 1, 2, 1, 1, 1, 1, 2, 1, 1, 1, 1, 0 };
+
+// .................................................................. lineTable
+// Pairs of quadrilateral edges the contour lines cross. The edges are
+// numbered {0,1}, {1,2}, {3,2}, {0,3}. The ambiguous cases 5 and 10 separate
+// the two vertices above the iso value.
+DAX_EXEC_CONSTANT_EXPORT const unsigned char LineTable[16][4] =
+{
+   {255, 255, 255, 255},
+   {0, 3, 255, 255},
+   {0, 1, 255, 255},
+   {1, 3, 255, 255},
+   {1, 2, 255, 255},
+   {0, 3, 1, 2},
+   {0, 2, 255, 255},
+   {2, 3, 255, 255},
+   {2, 3, 255, 255},
+   {0, 2, 255, 255},
+   {0, 1, 2, 3},
+   {1, 2, 255, 255},
+   {1, 3, 255, 255},
+   {0, 1, 255, 255},
+   {0, 3, 255, 255},
+   {255, 255, 255, 255},
+};
+
+}}}} // dax::worklet::internal::marchingsquares
+
+#endif
@@ -80,6 +80,22 @@ struct TestCellAverageWorklet
     std::cout << "Checking result" << std::endl;
     std::vector<dax::Scalar> averages(grid->GetNumberOfCells());
     resultHandle.CopyInto(averages.begin());
+    for (dax::Id cellIndex = 0;
+         cellIndex < grid->GetNumberOfCells();
+         cellIndex++)
+      {
+      verifyAverage<CellTag>(grid.GetCellConnections(cellIndex),
+                             averages[cellIndex]);
+      }
+
+    // Uniform grids visit the cells in Morton order; the grid dimensions are
+    // not a multiple of the brick size, so partial bricks are covered too.
+    std::cout << "Running CellAverage worklet in Morton order" << std::endl;
+    dispatcher.SetMortonTraversal(true);
+    dispatcher.Invoke(grid.GetRealGrid(), fieldHandle, resultHandle);
+
+    std::cout << "Checking result" << std::endl;
+    resultHandle.CopyInto(averages.begin());
     for (dax::Id cellIndex = 0;
          cellIndex < grid->GetNumberOfCells();
          cellIndex++)
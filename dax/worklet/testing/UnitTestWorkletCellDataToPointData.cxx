@@ -27,6 +27,7 @@
 #include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/DeviceAdapterSerial.h>
 #include <dax/cont/DispatcherGenerateKeysValues.h>
+#include <dax/cont/DispatcherMapPoint.h>
 #include <dax/cont/DispatcherReduceKeysValues.h>
 
 #include <iostream>
@@ -117,10 +118,35 @@ struct TestCellDataToPointDataWorklet
 
     generateKeys.Invoke(grid.GetRealGrid(),fieldHandle,keyHandle,valueHandle);
 
+    std::cout << "Running CellDataToPointDataGenerateKeys with a fixed fanout"
+              << std::endl;
+    dax::cont::DispatcherGenerateKeysValues<
+        dax::worklet::CellDataToPointDataGenerateKeys>
+        fanoutGenerateKeys(dax::CellTraits<CellTag>::NUM_VERTICES);
+    dax::cont::ArrayHandle<dax::Id> fanoutKeyHandle;
+    dax::cont::ArrayHandle<dax::Scalar> fanoutValueHandle;
+    fanoutGenerateKeys.Invoke(grid.GetRealGrid(),
+                              fieldHandle,
+                              fanoutKeyHandle,
+                              fanoutValueHandle);
+    DAX_TEST_ASSERT(fanoutKeyHandle.GetNumberOfValues() ==
+                    keyHandle.GetNumberOfValues(),
+                    "Fixed fanout generated the wrong number of keys.");
+    for (dax::Id index = 0; index < keyHandle.GetNumberOfValues(); index++)
+      {
+      DAX_TEST_ASSERT(fanoutKeyHandle.GetPortalConstControl().Get(index) ==
+                      keyHandle.GetPortalConstControl().Get(index),
+                      "Fixed fanout generated a different key.");
+      DAX_TEST_ASSERT(fanoutValueHandle.GetPortalConstControl().Get(index) ==
+                      valueHandle.GetPortalConstControl().Get(index),
+                      "Fixed fanout generated a different value.");
+      }
+
     std::cout << "Running CellDataToPointDataReduceKeys worklet" << std::endl;
 
     dax::cont::DispatcherReduceKeysValues<
       dax::worklet::CellDataToPointDataReduceKeys> reduceKeys(keyHandle);
+    reduceKeys.SetReleaseReductionMap(false);
 
     reduceKeys.Invoke(valueHandle, resultHandle);
 
@@ -129,14 +155,73 @@ struct TestCellDataToPointDataWorklet
     resultHandle.CopyInto(pointData.begin());
 
     verifyPointData(grid, field, pointData);
+
+    std::cout << "Reducing again with the plan of the first reduction"
+              << std::endl;
+    DAX_TEST_ASSERT(reduceKeys.GetReductionPlan().IsValid(),
+                    "Reduction plan was not kept.");
+    dax::cont::DispatcherReduceKeysValues<
+      dax::worklet::CellDataToPointDataReduceKeys>
+        reduceWithPlan(reduceKeys.GetReductionPlan());
+    dax::cont::ArrayHandle<dax::Scalar> secondResultHandle;
+    reduceWithPlan.Invoke(valueHandle, secondResultHandle);
+
+    std::cout << "Checking result" << std::endl;
+    secondResultHandle.CopyInto(pointData.begin());
+    verifyPointData(grid, field, pointData);
   }
 };
 
+//-----------------------------------------------------------------------------
+template<typename CellTag>
+void TestCellDataToPointDataMapPoint()
+{
+  typedef dax::cont::UnstructuredGrid<CellTag> GridType;
+  dax::cont::testing::TestGrid<GridType> grid(DIM);
+
+  std::cout << "Building point to cell links" << std::endl;
+  typedef typename GridType::PointToCellLinksType LinksType;
+  GridType realGrid = grid.GetRealGrid();
+  const LinksType &links = realGrid.BuildPointToCellLinks();
+
+  dax::cont::DispatcherMapPoint<
+      dax::worklet::CellDataToPointDataAverage> dispatcher(links);
+
+  // Convert two fields with the same links, which are only built once.
+  for (dax::Id fieldIndex = 0; fieldIndex < 2; fieldIndex++)
+    {
+    std::vector<dax::Scalar> field(grid->GetNumberOfCells());
+    for (dax::Id cellIndex = 0;
+         cellIndex < grid->GetNumberOfCells();
+         cellIndex++)
+      {
+      field[cellIndex] = static_cast<dax::Scalar>(
+            (fieldIndex+1)*cellIndex % 7);
+      }
+
+    std::cout << "Running CellDataToPointDataAverage worklet" << std::endl;
+    dax::cont::ArrayHandle<dax::Scalar> resultHandle;
+    dispatcher.Invoke(dax::cont::make_ArrayHandle(field), resultHandle);
+
+    std::cout << "Checking result" << std::endl;
+    DAX_TEST_ASSERT(resultHandle.GetNumberOfValues() ==
+                    grid->GetNumberOfPoints(),
+                    "Wrong number of point values.");
+    std::vector<dax::Scalar> pointData(resultHandle.GetNumberOfValues());
+    resultHandle.CopyInto(pointData.begin());
+
+    verifyPointData(grid, field, pointData);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void TestCellDataToPointData()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes(
                                            TestCellDataToPointDataWorklet());
+  TestCellDataToPointDataMapPoint<dax::CellTagHexahedron>();
+  TestCellDataToPointDataMapPoint<dax::CellTagTetrahedron>();
+  TestCellDataToPointDataMapPoint<dax::CellTagTriangle>();
   }
 
 
@@ -21,8 +21,14 @@
 
 #include <dax/CellTraits.h>
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompact.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/StructuredGrid.h>
+#include <dax/cont/UniformGrid2D.h>
+#include <dax/cont/UnstructuredGridMixed.h>
+#include <dax/math/Trig.h>
 
 #include <vector>
 
@@ -107,6 +113,29 @@ struct TestCellGradientWorklet
     std::cout << "Checking result" << std::endl;
     std::vector<dax::Vector3> gradient(grid->GetNumberOfCells());
     gradientHandle.CopyInto(gradient.begin());
+    for (dax::Id cellIndex = 0;
+         cellIndex < grid->GetNumberOfCells();
+         cellIndex++)
+      {
+      verifyGradient(grid.GetCellVertexCoordinates(cellIndex),
+                     gradient[cellIndex],
+                     trueGradient);
+      }
+
+    // The field values are small integers, so they are exact as halfs and
+    // the gradient must not change.
+    std::cout << "Running CellGradient worklet on a half float field"
+              << std::endl;
+    dax::cont::ArrayHandleCompact<dax::cont::CompactCodecHalf> halfField;
+    dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+          fieldHandle, halfField);
+    dispatcher.Invoke(grid.GetRealGrid(),
+                    grid->GetPointCoordinates(),
+                    halfField,
+                    gradientHandle);
+
+    std::cout << "Checking result" << std::endl;
+    gradientHandle.CopyInto(gradient.begin());
     for (dax::Id cellIndex = 0;
          cellIndex < grid->GetNumberOfCells();
          cellIndex++)
@@ -118,10 +147,218 @@ struct TestCellGradientWorklet
     }
 };
 
+//-----------------------------------------------------------------------------
+void TestCellGradientStretchedRectilinear()
+  {
+  // The gradient of a linear field is exact on any axis aligned hexahedron,
+  // so use a rectilinear grid whose spacing grows along each axis.
+  std::cout << "Running CellGradient worklet on a stretched rectilinear grid"
+            << std::endl;
+  std::vector<dax::Scalar> axis(DIM);
+  for (dax::Id i = 0; i < DIM; i++)
+    {
+    axis[i] = 0.25f*static_cast<dax::Scalar>(i*i) + static_cast<dax::Scalar>(i);
+    }
+  dax::cont::RectilinearGrid<> grid(dax::cont::make_ArrayHandle(axis),
+                                    dax::cont::make_ArrayHandle(axis),
+                                    dax::cont::make_ArrayHandle(axis));
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, -2.0, 0.5);
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex]
+        = dax::dot(grid.ComputePointCoordinates(pointIndex), trueGradient);
+    }
+
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::CellGradient > dispatcher;
+  dispatcher.Invoke(grid,
+                    grid.GetPointCoordinates(),
+                    dax::cont::make_ArrayHandle(field),
+                    gradientHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of gradients.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < grid.GetNumberOfCells();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(gradientHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               trueGradient),
+                    "Got bad gradient on stretched grid");
+    }
+  }
+
+//-----------------------------------------------------------------------------
+void TestCellGradientWarpedStructured()
+  {
+  // Trilinear hexahedra reproduce linear fields exactly, so the gradient must
+  // be exact even though the cells are not axis aligned.
+  std::cout << "Running CellGradient worklet on a warped structured grid"
+            << std::endl;
+  const dax::Extent3 extent(dax::make_Id3(0, 0, 0),
+                            dax::make_Id3(DIM-1, DIM-1, DIM-1));
+  std::vector<dax::Vector3> points;
+  dax::Id3 ijk;
+  for (ijk[2] = 0; ijk[2] < DIM; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIM; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIM; ijk[0]++)
+        {
+        const dax::Scalar radius = 2.0f + 0.5f*static_cast<dax::Scalar>(ijk[0]);
+        const dax::Scalar angle = 0.2f*static_cast<dax::Scalar>(ijk[1]);
+        points.push_back(dax::make_Vector3(radius*dax::math::Cos(angle),
+                                           radius*dax::math::Sin(angle),
+                                           static_cast<dax::Scalar>(ijk[2])));
+        }
+      }
+    }
+  dax::cont::StructuredGrid<> grid(extent, dax::cont::make_ArrayHandle(points));
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, -2.0, 0.5);
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex]
+        = dax::dot(grid.ComputePointCoordinates(pointIndex), trueGradient);
+    }
+
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::CellGradient > dispatcher;
+  dispatcher.Invoke(grid,
+                    grid.GetPointCoordinates(),
+                    dax::cont::make_ArrayHandle(field),
+                    gradientHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of gradients.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < grid.GetNumberOfCells();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(gradientHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               trueGradient),
+                    "Got bad gradient on warped grid");
+    }
+  }
+
+//-----------------------------------------------------------------------------
+void TestCellGradientMixed()
+  {
+  // Every supported cell type reproduces linear fields exactly, so all the
+  // cells of the mixed grid must get the same gradient.
+  std::cout << "Running CellGradient worklet on a mixed cell grid"
+            << std::endl;
+  dax::cont::UnstructuredGridMixed<> grid =
+      dax::cont::testing::MakeMixedGrid(
+        DIM, DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, -2.0, 0.5);
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex]
+        = dax::dot(grid.ComputePointCoordinates(pointIndex), trueGradient);
+    }
+
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::CellGradient > dispatcher;
+  dispatcher.Invoke(grid,
+                    grid.GetPointCoordinates(),
+                    dax::cont::make_ArrayHandle(field),
+                    gradientHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of gradients.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < grid.GetNumberOfCells();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(gradientHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               trueGradient),
+                    "Got bad gradient on mixed grid");
+    }
+  }
+
+//-----------------------------------------------------------------------------
+void TestCellGradient2D()
+  {
+  std::cout << "Running CellGradient2D worklet on a 2D image" << std::endl;
+  dax::cont::UniformGrid2D<> grid;
+  grid.SetExtent(dax::Id2(0, 0), dax::Id2(DIM-1, 2*DIM-1));
+  grid.SetOrigin(dax::make_Vector3(-1.0, 0.5, 2.0));
+  grid.SetSpacing(dax::make_Vector2(0.5, 2.0));
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, -2.0, 0.5);
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex]
+        = dax::dot(grid.ComputePointCoordinates(pointIndex), trueGradient);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  // The image lies in a plane of constant z, so only the in plane components
+  // of the gradient are recovered.
+  const dax::Vector3 expectedGradient =
+      dax::make_Vector3(trueGradient[0], trueGradient[1], 0.0);
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::CellGradient > dispatcher;
+  dispatcher.Invoke(grid,
+                    grid.GetPointCoordinates(),
+                    fieldHandle,
+                    gradientHandle);
+
+  dax::cont::ArrayHandle<dax::Vector2> gradient2DHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::CellGradient2D > dispatcher2D;
+  dispatcher2D.Invoke(grid,
+                      grid.GetPointCoordinates(),
+                      fieldHandle,
+                      gradient2DHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of gradients.");
+  DAX_TEST_ASSERT(
+        gradient2DHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+        "Wrong number of 2D gradients.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < grid.GetNumberOfCells();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(test_equal(gradientHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               expectedGradient),
+                    "Got bad gradient on image");
+    DAX_TEST_ASSERT(test_equal(gradient2DHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               dax::make_Vector2(trueGradient[0],
+                                                 trueGradient[1])),
+                    "Got bad 2D gradient on image");
+    }
+  }
+
 //-----------------------------------------------------------------------------
 void TestCellGradient()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes( TestCellGradientWorklet() );
+  TestCellGradientStretchedRectilinear();
+  TestCellGradientWarpedStructured();
+  TestCellGradientMixed();
+  TestCellGradient2D();
   }
 
 } // Anonymous namespace
@@ -0,0 +1,211 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/worklet/FlyingEdges.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+
+typedef dax::cont::UniformGrid<DeviceAdapter> UniformGridType;
+typedef dax::cont::UnstructuredGrid<
+    dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+    TriangleGridType;
+typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+    ScalarHandleType;
+typedef dax::cont::ArrayHandle<dax::Id,ArrayContainer,DeviceAdapter>
+    IdHandleType;
+
+const dax::Vector3 SECONDARY_GRADIENT = dax::make_Vector3(-0.5, 1.0, 2.0);
+
+//-----------------------------------------------------------------------------
+struct PlaneField
+{
+  dax::Scalar operator()(const dax::Vector3 &coordinates) const
+  {
+    return dax::dot(coordinates, dax::make_Vector3(1.0, 1.0, 1.0));
+  }
+};
+
+struct SphereField
+{
+  dax::Scalar operator()(const dax::Vector3 &coordinates) const
+  {
+    return dax::math::Magnitude(coordinates -
+                                dax::make_Vector3(2.0, 3.0, 4.0));
+  }
+};
+
+//-----------------------------------------------------------------------------
+template<class FieldFunction>
+void TryContour(const UniformGridType &grid,
+                FieldFunction function,
+                dax::Scalar isoValue)
+{
+  const dax::Id numPoints = grid.GetNumberOfPoints();
+  std::vector<dax::Scalar> field(numPoints);
+  std::vector<dax::Scalar> secondaryField(numPoints);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    dax::Vector3 coordinates = grid.ComputePointCoordinates(pointIndex);
+    field[pointIndex] = function(coordinates);
+    secondaryField[pointIndex] = dax::dot(coordinates, SECONDARY_GRADIENT);
+    }
+  ScalarHandleType fieldHandle =
+      dax::cont::make_ArrayHandle(field, ArrayContainer(), DeviceAdapter());
+  ScalarHandleType secondaryFieldHandle =
+      dax::cont::make_ArrayHandle(secondaryField,
+                                  ArrayContainer(),
+                                  DeviceAdapter());
+
+  std::cout << "Contour with marching cubes." << std::endl;
+  IdHandleType count;
+  dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount>
+      countDispatcher((dax::worklet::MarchingCubesCount(isoValue)));
+  countDispatcher.Invoke(grid, fieldHandle, count);
+
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<
+      dax::worklet::MarchingCubesGenerate> InterpolatedDispatcher;
+  InterpolatedDispatcher generateDispatcher(
+        count, dax::worklet::MarchingCubesGenerate(isoValue));
+  generateDispatcher.SetRemoveDuplicatePoints(true);
+  TriangleGridType marchingGrid;
+  generateDispatcher.Invoke(grid, marchingGrid, fieldHandle);
+
+  std::cout << "Contour with flying edges." << std::endl;
+  dax::worklet::DispatcherFlyingEdges<DeviceAdapter> flyingDispatcher(isoValue);
+  TriangleGridType flyingGrid;
+  flyingDispatcher.Invoke(grid, fieldHandle, flyingGrid);
+
+  std::cout << "Marching cubes gave " << marchingGrid.GetNumberOfPoints()
+            << " points and " << marchingGrid.GetNumberOfCells()
+            << " triangles, flying edges gave "
+            << flyingGrid.GetNumberOfPoints() << " points and "
+            << flyingGrid.GetNumberOfCells() << " triangles." << std::endl;
+  DAX_TEST_ASSERT(marchingGrid.GetNumberOfCells() > 0,
+                  "Test contour is empty.");
+  DAX_TEST_ASSERT(flyingGrid.GetNumberOfCells() ==
+                  marchingGrid.GetNumberOfCells(),
+                  "Flying edges gave the wrong number of triangles.");
+  DAX_TEST_ASSERT(flyingGrid.GetNumberOfPoints() ==
+                  marchingGrid.GetNumberOfPoints(),
+                  "Flying edges gave the wrong number of points.");
+
+  std::cout << "Check the triangles." << std::endl;
+  // The points are numbered differently, but the triangles come in the
+  // same order and have their corners at the same places.
+  IdHandleType marchingCellMap =
+      generateDispatcher.GetTopologyPlan().GetCellMap();
+  IdHandleType flyingCellMap = flyingDispatcher.GetTopologyPlan().GetCellMap();
+  for (dax::Id cellIndex = 0;
+       cellIndex < marchingGrid.GetNumberOfCells();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(flyingCellMap.GetPortalConstControl().Get(cellIndex) ==
+                    marchingCellMap.GetPortalConstControl().Get(cellIndex),
+                    "Triangle came from the wrong cell.");
+    for (dax::Id vertex = 0; vertex < 3; vertex++)
+      {
+      const dax::Id flyingPoint = flyingGrid.GetCellConnections()
+          .GetPortalConstControl().Get(3*cellIndex + vertex);
+      const dax::Id marchingPoint = marchingGrid.GetCellConnections()
+          .GetPortalConstControl().Get(3*cellIndex + vertex);
+      DAX_TEST_ASSERT(test_equal(
+            flyingGrid.GetPointCoordinates().GetPortalConstControl()
+              .Get(flyingPoint),
+            marchingGrid.GetPointCoordinates().GetPortalConstControl()
+              .Get(marchingPoint)),
+            "Triangle has a corner at the wrong place.");
+      }
+    }
+
+  std::cout << "Check interpolation of secondary field." << std::endl;
+  ScalarHandleType interpolatedSecondaryField;
+  DAX_TEST_ASSERT(flyingDispatcher.CompactPointField(
+                    secondaryFieldHandle, interpolatedSecondaryField),
+                  "Did not interpolate the secondary field.");
+  DAX_TEST_ASSERT(interpolatedSecondaryField.GetNumberOfValues() ==
+                  flyingGrid.GetNumberOfPoints(),
+                  "Secondary field has the wrong number of values.");
+  for (dax::Id pointIndex = 0;
+       pointIndex < flyingGrid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 coordinates =
+        flyingGrid.GetPointCoordinates().GetPortalConstControl()
+        .Get(pointIndex);
+    DAX_TEST_ASSERT(test_equal(
+          dax::dot(coordinates, SECONDARY_GRADIENT),
+          interpolatedSecondaryField.GetPortalConstControl().Get(pointIndex)),
+          "Got bad secondary field value.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestFlyingEdges()
+{
+  UniformGridType grid;
+
+  std::cout << "Plane contour." << std::endl;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(25, 25, 25));
+  TryContour(grid, PlaneField(), 70);
+
+  std::cout << "Sphere contour." << std::endl;
+  grid.SetExtent(dax::make_Id3(-3, -2, -1), dax::make_Id3(11, 9, 13));
+  grid.SetSpacing(dax::make_Vector3(0.5, 0.75, 1.0));
+  TryContour(grid, SphereField(), 3.3f);
+
+  std::cout << "Sphere contour through thin grid." << std::endl;
+  grid.SetExtent(dax::make_Id3(-3, 4, -1), dax::make_Id3(11, 5, 13));
+  TryContour(grid, SphereField(), 3.3f);
+
+  std::cout << "Empty contour." << std::endl;
+  dax::worklet::DispatcherFlyingEdges<DeviceAdapter> flyingDispatcher(1000);
+  TriangleGridType flyingGrid;
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints(), 0);
+  flyingDispatcher.Invoke(grid,
+                          dax::cont::make_ArrayHandle(field,
+                                                      ArrayContainer(),
+                                                      DeviceAdapter()),
+                          flyingGrid);
+  DAX_TEST_ASSERT(flyingGrid.GetNumberOfCells() == 0,
+                  "Empty contour has triangles.");
+  DAX_TEST_ASSERT(flyingGrid.GetNumberOfPoints() == 0,
+                  "Empty contour has points.");
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletFlyingEdges(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestFlyingEdges);
+}
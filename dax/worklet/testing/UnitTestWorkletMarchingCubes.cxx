@@ -26,8 +26,12 @@
 #include <dax/TypeTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompact.h>
 #include <dax/cont/DispatcherGenerateInterpolatedCells.h>
 #include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherProfile.h>
+#include <dax/cont/ErrorExecution.h>
+#include <dax/cont/MemoryTracker.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 
@@ -39,6 +43,12 @@ namespace {
 const dax::Id DIM = 26;
 const dax::Id ISOVALUE = 70;
 
+void CountProfilePhase(const dax::cont::DispatcherProfile::Phase &,
+                       void *clientData)
+{
+  ++*static_cast<dax::Id *>(clientData);
+}
+
 template<typename PointCoordinatesArrayType,
          typename FieldArrayType>
 DAX_CONT_EXPORT
@@ -169,6 +179,33 @@ struct TestMarchingCubesWorklet
       CheckFieldInterpolation(outGrid.GetPointCoordinates(),
                               interpolatedSecondaryField,
                               secondaryGradient);
+      typename InterpolatedDispatcher::TopologyPlanType firstPlan =
+          interpDispatcher.GetTopologyPlan();
+
+      std::cout << "Interpolate several point fields at once." << std::endl;
+      typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+          ScalarHandleType;
+      dax::Tuple<ScalarHandleType,2> pointFields;
+      pointFields[0] = fieldHandle;
+      pointFields[1] = secondaryFieldHandle;
+      dax::Tuple<ScalarHandleType,2> interpolatedFields;
+      interpDispatcher.CompactPointFields(pointFields, interpolatedFields);
+      ScalarHandleType interpolatedField;
+      interpDispatcher.CompactPointField(fieldHandle, interpolatedField);
+      DAX_TEST_ASSERT(interpolatedFields[1].GetNumberOfValues() ==
+                      interpolatedSecondaryField.GetNumberOfValues(),
+                      "Interpolated the point fields to a wrong size.");
+      for (dax::Id index = 0;
+           index < interpolatedSecondaryField.GetNumberOfValues();
+           index++)
+        {
+        DAX_TEST_ASSERT(
+              interpolatedFields[0].GetPortalConstControl().Get(index) ==
+              interpolatedField.GetPortalConstControl().Get(index) &&
+              interpolatedFields[1].GetPortalConstControl().Get(index) ==
+              interpolatedSecondaryField.GetPortalConstControl().Get(index),
+              "Interpolated the point fields differently.");
+        }
 
       std::cout
           << "Generate the contour again, this time removing duplicate points."
@@ -198,6 +235,242 @@ struct TestMarchingCubesWorklet
       CheckFieldInterpolation(secondOutGrid.GetPointCoordinates(),
                               interpolatedSecondaryField,
                               secondaryGradient);
+
+      std::cout << "Check the topology plans of both invokes." << std::endl;
+      // The plan of the first invoke must survive the second one.
+      DAX_TEST_ASSERT(firstPlan.CompactPointField(secondaryFieldHandle,
+                                                  interpolatedSecondaryField),
+                      "Plan did not interpolate the point field.");
+      DAX_TEST_ASSERT(interpolatedSecondaryField.GetNumberOfValues() ==
+                      valid_num_points,
+                      "First plan interpolated the wrong number of points.");
+      CheckFieldInterpolation(outGrid.GetPointCoordinates(),
+                              interpolatedSecondaryField,
+                              secondaryGradient);
+
+      typename InterpolatedDispatcher::TopologyPlanType secondPlan =
+          interpDispatcher.GetTopologyPlan();
+      secondPlan.CompactPointField(secondaryFieldHandle,
+                                   interpolatedSecondaryField);
+      CheckFieldInterpolation(secondOutGrid.GetPointCoordinates(),
+                              interpolatedSecondaryField,
+                              secondaryGradient);
+
+      // Every output triangle came from a cell that generates at least as
+      // many triangles as its visit index.
+      dax::cont::ArrayHandle<dax::Id, ArrayContainer, DeviceAdapter>
+          triangleCounts;
+      secondPlan.CompactCellField(count, triangleCounts);
+      dax::cont::ArrayHandle<dax::Id, ArrayContainer, DeviceAdapter>
+          visitIndex = secondPlan.GetVisitIndex();
+      DAX_TEST_ASSERT(triangleCounts.GetNumberOfValues() ==
+                      secondOutGrid.GetNumberOfCells(),
+                      "Plan mapped the cell field to the wrong size.");
+      for (dax::Id index = 0;
+           index < secondOutGrid.GetNumberOfCells();
+           index++)
+        {
+        DAX_TEST_ASSERT(visitIndex.GetPortalConstControl().Get(index) <
+                        triangleCounts.GetPortalConstControl().Get(index),
+                        "Bad visit index or cell map in plan.");
+        }
+
+      std::cout << "Generate the contour from a quantized field." << std::endl;
+      // The field values are small integers, so storing them in bytes is
+      // exact and the contour must not change.
+      typedef dax::cont::CompactCodecQuantized<unsigned char> CodecType;
+      dax::cont::ArrayHandleCompact<CodecType,DeviceAdapter>
+          quantizedFieldHandle((CodecType(1, 0)));
+      dax::cont::DeviceAdapterAlgorithm<DeviceAdapter>::Copy(
+            fieldHandle, quantizedFieldHandle);
+
+      CountHandleType quantizedCount;
+      cellDispatcher.Invoke( inGrid.GetRealGrid(),
+                             quantizedFieldHandle,
+                             quantizedCount);
+
+      InterpolatedDispatcher quantizedInterpDispatcher( quantizedCount,
+                              dax::worklet::MarchingCubesGenerate(isoValue) );
+      quantizedInterpDispatcher.SetRemoveDuplicatePoints(true);
+
+      UnstructuredGridType quantizedOutGrid;
+      quantizedInterpDispatcher.Invoke(inGrid.GetRealGrid(),
+                                       quantizedOutGrid,
+                                       quantizedFieldHandle);
+      DAX_TEST_ASSERT(quantizedOutGrid.GetNumberOfCells() ==
+                      secondOutGrid.GetNumberOfCells(),
+                      "Quantized field gave a different number of cells.");
+      DAX_TEST_ASSERT(quantizedOutGrid.GetNumberOfPoints() ==
+                      secondOutGrid.GetNumberOfPoints(),
+                      "Quantized field gave a different number of points.");
+
+      std::cout << "Generate the contour with 16-bit connections." << std::endl;
+      typedef dax::cont::UnstructuredGrid<
+          CellType,
+          dax::cont::ArrayContainerControlCompactId<
+              unsigned short,DeviceAdapter>::ArrayContainerControlTag,
+          ArrayContainer,
+          DeviceAdapter> CompactGridType;
+      CompactGridType compactOutGrid;
+      interpDispatcher.Invoke(inGrid.GetRealGrid(),
+                              compactOutGrid,
+                              fieldHandle);
+      DAX_TEST_ASSERT(compactOutGrid.GetNumberOfPoints() ==
+                      secondOutGrid.GetNumberOfPoints(),
+                      "Compact connections gave a different number of points.");
+      DAX_TEST_ASSERT(compactOutGrid.GetCellConnections().GetNumberOfValues() ==
+                      secondOutGrid.GetCellConnections().GetNumberOfValues(),
+                      "Compact connections gave a different number of cells.");
+      for (dax::Id index = 0;
+           index < secondOutGrid.GetCellConnections().GetNumberOfValues();
+           index++)
+        {
+        DAX_TEST_ASSERT(
+              compactOutGrid.GetCellConnections().GetPortalConstControl()
+                .Get(index) ==
+              secondOutGrid.GetCellConnections().GetPortalConstControl()
+                .Get(index),
+              "Compact connections differ.");
+        }
+
+      std::cout << "Remove duplicate points with a hash table." << std::endl;
+      interpDispatcher.SetDuplicatePointResolution(
+            InterpolatedDispatcher::RESOLVE_DUPLICATES_BY_HASH);
+      UnstructuredGridType hashOutGrid;
+      interpDispatcher.Invoke(inGrid.GetRealGrid(),
+                              hashOutGrid,
+                              fieldHandle);
+      DAX_TEST_ASSERT(hashOutGrid.GetNumberOfPoints() == NumberOfUniquePoints,
+                      "Hash table merged to the wrong number of points.");
+      DAX_TEST_ASSERT(hashOutGrid.GetCellConnections().GetNumberOfValues() ==
+                      secondOutGrid.GetCellConnections().GetNumberOfValues(),
+                      "Hash table gave a different number of cells.");
+      // The points may be numbered differently, but every cell must use
+      // points at the same place as when sorting.
+      for (dax::Id index = 0;
+           index < secondOutGrid.GetCellConnections().GetNumberOfValues();
+           index++)
+        {
+        dax::Id hashPoint =
+            hashOutGrid.GetCellConnections().GetPortalConstControl().Get(index);
+        dax::Id sortPoint =
+            secondOutGrid.GetCellConnections().GetPortalConstControl().Get(index);
+        DAX_TEST_ASSERT(test_equal(
+              hashOutGrid.GetPointCoordinates().GetPortalConstControl()
+                .Get(hashPoint),
+              secondOutGrid.GetPointCoordinates().GetPortalConstControl()
+                .Get(sortPoint)),
+              "Hash table connected a cell to the wrong point.");
+        }
+
+      interpDispatcher.CompactPointField(secondaryFieldHandle,
+                                         interpolatedSecondaryField);
+      CheckFieldInterpolation(hashOutGrid.GetPointCoordinates(),
+                              interpolatedSecondaryField,
+                              secondaryGradient);
+
+      std::cout << "Remove duplicate points by structured edge." << std::endl;
+      // Grids without structured edges fall back to sorting, and the edge
+      // ids keep the order of the sorted points, so the output must match
+      // the sorted one exactly.
+      interpDispatcher.SetDuplicatePointResolution(
+            InterpolatedDispatcher::RESOLVE_DUPLICATES_BY_EDGE);
+      UnstructuredGridType edgeOutGrid;
+      interpDispatcher.Invoke(inGrid.GetRealGrid(),
+                              edgeOutGrid,
+                              fieldHandle);
+      DAX_TEST_ASSERT(edgeOutGrid.GetNumberOfPoints() == NumberOfUniquePoints,
+                      "Edge ids merged to the wrong number of points.");
+      DAX_TEST_ASSERT(edgeOutGrid.GetCellConnections().GetNumberOfValues() ==
+                      secondOutGrid.GetCellConnections().GetNumberOfValues(),
+                      "Edge ids gave a different number of cells.");
+      for (dax::Id index = 0;
+           index < secondOutGrid.GetCellConnections().GetNumberOfValues();
+           index++)
+        {
+        DAX_TEST_ASSERT(
+              edgeOutGrid.GetCellConnections().GetPortalConstControl()
+                .Get(index) ==
+              secondOutGrid.GetCellConnections().GetPortalConstControl()
+                .Get(index),
+              "Edge ids gave different connections.");
+        }
+      for (dax::Id index = 0; index < NumberOfUniquePoints; index++)
+        {
+        DAX_TEST_ASSERT(test_equal(
+              edgeOutGrid.GetPointCoordinates().GetPortalConstControl()
+                .Get(index),
+              secondOutGrid.GetPointCoordinates().GetPortalConstControl()
+                .Get(index)),
+              "Edge ids gave different points.");
+        }
+
+      std::cout << "Profile the phases of the generate." << std::endl;
+      interpDispatcher.SetDuplicatePointResolution(
+            InterpolatedDispatcher::RESOLVE_DUPLICATES_BY_SORT);
+      DAX_TEST_ASSERT(interpDispatcher.GetProfile().GetPhases().empty(),
+                      "Phases recorded without profiling.");
+      dax::Id numberOfReportedPhases = 0;
+      interpDispatcher.SetProfiling(true);
+      interpDispatcher.SetProfileCallback(CountProfilePhase,
+                                          &numberOfReportedPhases);
+      UnstructuredGridType profiledOutGrid;
+      interpDispatcher.Invoke(inGrid.GetRealGrid(),
+                              profiledOutGrid,
+                              fieldHandle);
+      interpDispatcher.CompactPointField(secondaryFieldHandle,
+                                         interpolatedSecondaryField);
+      interpDispatcher.SetProfiling(false);
+
+      const dax::cont::DispatcherProfile &profile =
+          interpDispatcher.GetProfile();
+      profile.Print(std::cout);
+      DAX_TEST_ASSERT(
+            profiledOutGrid.GetNumberOfPoints() == NumberOfUniquePoints,
+            "Profiling changed the output.");
+      DAX_TEST_ASSERT(!dax::cont::MemoryTracker::IsEnabled(),
+                      "Profiling left the memory tracker on.");
+      DAX_TEST_ASSERT(profile.GetBytesAllocated() == 0,
+                      "Bytes counted without the memory tracker.");
+
+      const char *expectedPhases[] = {
+        "ScanInclusive", "UpperBounds", "VisitIndex",
+        "PrepareInterpolatedGrid", "Worklet", "CopyWeights", "Sort",
+        "Unique", "LowerBounds", "CompactPointField", "CompactPointField" };
+      const dax::Id numberOfExpectedPhases =
+          sizeof(expectedPhases)/sizeof(expectedPhases[0]);
+      const dax::cont::DispatcherProfile::PhaseListType &phases =
+          profile.GetPhases();
+      DAX_TEST_ASSERT(
+            static_cast<dax::Id>(phases.size()) == numberOfExpectedPhases,
+            "Wrong number of profiled phases.");
+      DAX_TEST_ASSERT(numberOfReportedPhases == numberOfExpectedPhases,
+                      "Callback did not get every phase.");
+      for (dax::Id index = 0; index < numberOfExpectedPhases; index++)
+        {
+        DAX_TEST_ASSERT(phases[index].Name == expectedPhases[index],
+                        "Unexpected profiled phase.");
+        DAX_TEST_ASSERT(phases[index].Seconds >= 0,
+                        "Negative phase time.");
+        }
+      DAX_TEST_ASSERT(phases[0].NumberOfValues == secondOutGrid.GetNumberOfCells(),
+                      "Scan phase did not count the output cells.");
+      DAX_TEST_ASSERT(phases[7].NumberOfValues == NumberOfUniquePoints,
+                      "Unique phase did not count the unique points.");
+      DAX_TEST_ASSERT(profile.GetInvokeSeconds() >= 0,
+                      "Invoke was not timed.");
+
+      std::cout << "Profile the memory of the generate." << std::endl;
+      dax::cont::MemoryTracker::Enable();
+      interpDispatcher.SetProfiling(true);
+      interpDispatcher.Invoke(inGrid.GetRealGrid(),
+                              profiledOutGrid,
+                              fieldHandle);
+      interpDispatcher.SetProfiling(false);
+      dax::cont::MemoryTracker::Disable();
+      profile.Print(std::cout);
+      DAX_TEST_ASSERT(profile.GetPhases()[4].BytesAllocated > 0,
+                      "Worklet phase did not count its output arrays.");
       }
     catch (dax::cont::ErrorControl error)
       {
@@ -208,12 +481,142 @@ struct TestMarchingCubesWorklet
 };
 
 
+//-----------------------------------------------------------------------------
+//Interpolates along the diagonal of each voxel, which is not an edge of the
+//grid, so the points can not be merged by edge id.
+class DiagonalGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+  typedef void ControlSignature(TopologyIn, GeometryOut);
+  typedef void ExecutionSignature(AsVertices(_1), _2);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell) const
+  {
+    outCell.SetInterpolationPoint(0, verts[0], verts[1], 0.5);
+    outCell.SetInterpolationPoint(1, verts[0], verts[2], 0.5);
+    outCell.SetInterpolationPoint(2, verts[0], verts[7], 0.5);
+  }
+};
+
+void TestEdgeResolutionRejectsDiagonals()
+  {
+  std::cout << "Resolve points off the grid edges by edge id." << std::endl;
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<DiagonalGenerate>
+      DispatcherType;
+
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(3, 3, 3));
+  std::vector<dax::Id> counts(grid.GetNumberOfCells(), 1);
+
+  DispatcherType dispatcher(dax::cont::make_ArrayHandle(counts));
+  dispatcher.SetDuplicatePointResolution(
+        DispatcherType::RESOLVE_DUPLICATES_BY_EDGE);
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
+  bool gotError = false;
+  try
+    {
+    dispatcher.Invoke(grid, outGrid);
+    }
+  catch (dax::cont::ErrorExecution error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError,
+                  "Diagonal points were merged by edge id without an error.");
+
+  //sorting handles any segment
+  dispatcher.SetDuplicatePointResolution(
+        DispatcherType::RESOLVE_DUPLICATES_BY_SORT);
+  dispatcher.Invoke(grid, outGrid);
+  DAX_TEST_ASSERT(outGrid.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Wrong number of diagonal cells.");
+  }
+
+//-----------------------------------------------------------------------------
+//Interpolates the same point on the first edge of each voxel twice, once
+//from each end, and a third point on another edge.
+class SwappedEdgeGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+  typedef void ControlSignature(TopologyIn, GeometryOut);
+  typedef void ExecutionSignature(AsVertices(_1), _2);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell) const
+  {
+    outCell.SetInterpolationPoint(0, verts[1], verts[0], 0.75);
+    outCell.SetInterpolationPoint(1, verts[0], verts[1], 0.25);
+    outCell.SetInterpolationPoint(2, verts[0], verts[4], 0.5);
+  }
+};
+
+void TestEdgeResolutionMergesSwappedEndPoints()
+  {
+  std::cout << "Resolve points named from either end of an edge by edge id."
+            << std::endl;
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<SwappedEdgeGenerate>
+      DispatcherType;
+
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(3, 3, 3));
+  const dax::Id numCells = grid.GetNumberOfCells();
+  std::vector<dax::Id> counts(numCells, 1);
+
+  DispatcherType dispatcher(dax::cont::make_ArrayHandle(counts));
+
+  //sorting compares the end points in the order they are given
+  dispatcher.SetDuplicatePointResolution(
+        DispatcherType::RESOLVE_DUPLICATES_BY_SORT);
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> sortOutGrid;
+  dispatcher.Invoke(grid, sortOutGrid);
+  DAX_TEST_ASSERT(sortOutGrid.GetNumberOfPoints() == 3*numCells,
+                  "Sorting merged points named in a different order.");
+
+  dispatcher.SetDuplicatePointResolution(
+        DispatcherType::RESOLVE_DUPLICATES_BY_EDGE);
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> edgeOutGrid;
+  dispatcher.Invoke(grid, edgeOutGrid);
+  DAX_TEST_ASSERT(edgeOutGrid.GetNumberOfCells() == numCells,
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(edgeOutGrid.GetNumberOfPoints() == 2*numCells,
+                  "Edge ids did not merge the swapped end points.");
+
+  const dax::Vector3 offset = dax::make_Vector3(0.25, 0, 0);
+  for (dax::Id cell = 0; cell < numCells; cell++)
+    {
+    const dax::Id first =
+        edgeOutGrid.GetCellConnections().GetPortalConstControl().Get(3*cell);
+    const dax::Id second =
+        edgeOutGrid.GetCellConnections().GetPortalConstControl()
+          .Get(3*cell+1);
+    DAX_TEST_ASSERT(first == second,
+                    "Swapped end points gave different point ids.");
+
+    const dax::Id3 ijk = dax::make_Id3(cell%3, (cell/3)%3, cell/9);
+    const dax::Vector3 expected =
+        grid.ComputePointCoordinates(ijk) + offset;
+    DAX_TEST_ASSERT(test_equal(
+          edgeOutGrid.GetPointCoordinates().GetPortalConstControl()
+            .Get(first),
+          expected),
+          "Swapped end points interpolated the wrong point.");
+    }
+  }
+
 //-----------------------------------------------------------------------------
 void TestMarchingCubes()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes(
         TestMarchingCubesWorklet(),
         dax::testing::Testing::CellCheckHexahedron());
+  TestEdgeResolutionRejectsDiagonals();
+  TestEdgeResolutionMergesSwappedEndPoints();
   }
 } // Anonymous namespace
 
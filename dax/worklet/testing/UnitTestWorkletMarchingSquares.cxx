@@ -0,0 +1,144 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/MarchingSquares.h>
+
+#include <iostream>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UniformGrid2D.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <vector>
+
+
+namespace {
+const dax::Id DIM = 26;
+
+//-----------------------------------------------------------------------------
+template<typename GridType>
+DAX_CONT_EXPORT
+void CheckContourPoints(const GridType &grid,
+                        dax::Scalar isoValue,
+                        dax::Scalar planeZ)
+{
+  typename GridType::PointCoordinatesType::PortalConstControl portal =
+      grid.GetPointCoordinates().GetPortalConstControl();
+  for (dax::Id pointIndex = 0;
+       pointIndex < portal.GetNumberOfValues();
+       pointIndex++)
+    {
+    dax::Vector3 coords = portal.Get(pointIndex);
+    DAX_TEST_ASSERT(test_equal(coords[0] + coords[1], isoValue),
+                    "Contour point is not on the iso line.");
+    DAX_TEST_ASSERT(test_equal(coords[2], planeZ),
+                    "Contour point is not in the image plane.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestMarchingSquares()
+{
+  typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+  typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+  typedef dax::CellTagLine CellType;
+  typedef dax::cont::UnstructuredGrid<
+      CellType,ArrayContainer,ArrayContainer,DeviceAdapter>
+      UnstructuredGridType;
+
+  const dax::Scalar planeZ = 3.0;
+  dax::cont::UniformGrid2D<DeviceAdapter> inGrid;
+  inGrid.SetExtent(dax::Id2(0, 0), dax::Id2(DIM-1, DIM-1));
+  inGrid.SetOrigin(dax::make_Vector3(0.0, 0.0, planeZ));
+
+  // The field x + y puts the iso line on the anti diagonal of the image. Use
+  // a value between grid points so no point is exactly on the contour.
+  std::vector<dax::Scalar> field(inGrid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < inGrid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 coordinates = inGrid.ComputePointCoordinates(pointIndex);
+    field[pointIndex] = coordinates[0] + coordinates[1];
+    }
+  dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+      fieldHandle = dax::cont::make_ArrayHandle(field,
+                                                ArrayContainer(),
+                                                DeviceAdapter());
+  const dax::Id N = DIM-1;
+  const dax::Scalar isoValue = static_cast<dax::Scalar>(N) + 0.5f;
+
+  typedef dax::cont::ArrayHandle<dax::Id, ArrayContainer, DeviceAdapter>
+      CountHandleType;
+  typedef dax::cont::DispatcherMapCell<
+      dax::worklet::MarchingSquaresCount > CellDispatcher;
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<
+      dax::worklet::MarchingSquaresGenerate > InterpolatedDispatcher;
+
+  std::cout << "Count how many lines are to be generated." << std::endl;
+  CountHandleType count;
+  CellDispatcher cellDispatcher( (dax::worklet::MarchingSquaresCount(isoValue)) );
+  cellDispatcher.Invoke(inGrid, fieldHandle, count);
+
+  std::cout << "Generate the contour lines with duplicate points." << std::endl;
+  InterpolatedDispatcher interpDispatcher( count,
+                            dax::worklet::MarchingSquaresGenerate(isoValue) );
+  interpDispatcher.SetRemoveDuplicatePoints(false);
+  interpDispatcher.SetReleaseCount(false);
+
+  UnstructuredGridType outGrid;
+  interpDispatcher.Invoke(inGrid, outGrid, fieldHandle);
+
+  // The cells with i + j == N - 1 or i + j == N straddle the iso line.
+  const dax::Id expectedNumLines = 2*N - 1;
+  std::cout << "Number of lines is " << outGrid.GetNumberOfCells() << std::endl;
+  DAX_TEST_ASSERT(outGrid.GetNumberOfCells() == expectedNumLines,
+                  "Wrong number of contour lines.");
+  DAX_TEST_ASSERT(outGrid.GetNumberOfPoints() == 2*expectedNumLines,
+                  "Incorrect number of points when not merging.");
+  CheckContourPoints(outGrid, isoValue, planeZ);
+
+  std::cout << "Generate the contour again, removing duplicate points."
+            << std::endl;
+  interpDispatcher.SetRemoveDuplicatePoints(true);
+  UnstructuredGridType mergedGrid;
+  interpDispatcher.Invoke(inGrid, mergedGrid, fieldHandle);
+
+  // The contour is a single open polyline, which crosses N horizontal and
+  // N vertical edges of the image.
+  std::cout << "Number of points is " << mergedGrid.GetNumberOfPoints()
+            << std::endl;
+  DAX_TEST_ASSERT(mergedGrid.GetNumberOfCells() == expectedNumLines,
+                  "Wrong number of merged contour lines.");
+  DAX_TEST_ASSERT(mergedGrid.GetNumberOfPoints() == 2*N,
+                  "We didn't merge to the correct number of points.");
+  CheckContourPoints(mergedGrid, isoValue, planeZ);
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletMarchingSquares(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestMarchingSquares);
+}
@@ -23,6 +23,7 @@
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UnstructuredGridMixed.h>
 
 #include <vector>
 
@@ -87,11 +88,59 @@ struct TestPointDataToCellDataWorklet
     }
 };
 
+//-----------------------------------------------------------------------------
+void TestPointDataToCellDataMixed()
+  {
+  std::cout << "Running PointDataToCellData worklet on a mixed cell grid"
+            << std::endl;
+  dax::cont::UnstructuredGridMixed<> grid =
+      dax::cont::testing::MakeMixedGrid(
+        DIM, DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex] = pointIndex;
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> resultHandle;
+  dax::cont::DispatcherMapCell< dax::worklet::PointDataToCellData> dispatcher;
+  dispatcher.Invoke(grid, dax::cont::make_ArrayHandle(field), resultHandle);
+
+  std::cout << "Checking result" << std::endl;
+  DAX_TEST_ASSERT(resultHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of cell values.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < grid.GetNumberOfCells();
+       cellIndex++)
+    {
+    const dax::Id offset =
+        grid.GetOffsets().GetPortalConstControl().Get(cellIndex);
+    const dax::Id nextOffset = (cellIndex+1 < grid.GetNumberOfCells())
+        ? grid.GetOffsets().GetPortalConstControl().Get(cellIndex+1)
+        : grid.GetCellConnections().GetNumberOfValues();
+    dax::Scalar expectedCellData = 0.0;
+    for (dax::Id index = offset; index < nextOffset; index++)
+      {
+      expectedCellData +=
+          grid.GetCellConnections().GetPortalConstControl().Get(index);
+      }
+    expectedCellData /= nextOffset - offset;
+    DAX_TEST_ASSERT(test_equal(resultHandle.GetPortalConstControl()
+                               .Get(cellIndex),
+                               expectedCellData),
+                    "Got bad average on mixed grid");
+    }
+  }
+
 //-----------------------------------------------------------------------------
 void TestPointDataToCellData()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes(
                                            TestPointDataToCellDataWorklet() );
+  TestPointDataToCellDataMixed();
   }
 
 
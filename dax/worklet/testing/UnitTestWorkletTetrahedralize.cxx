@@ -27,6 +27,7 @@
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/DispatcherGenerateTopology.h>
+#include <dax/cont/RectilinearGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/testing/Testing.h>
@@ -87,6 +88,16 @@ struct TestTetrahedralizeWorklet
     this->GridTetrahedralize(in.GetRealGrid(),out);
     }
 
+  //----------------------------------------------------------------------------
+  DAX_CONT_EXPORT
+  void operator()(const dax::cont::RectilinearGrid<>&) const
+    {
+    dax::cont::testing::TestGrid<dax::cont::RectilinearGrid<> > in(DIM);
+    dax::cont::UnstructuredGrid<dax::CellTagTetrahedron> out;
+
+    this->GridTetrahedralize(in.GetRealGrid(),out);
+    }
+
   //----------------------------------------------------------------------------
   template <typename InGridType,
             typename OutGridType>
@@ -132,6 +143,45 @@ struct TestTetrahedralizeWorklet
     cellHandle.CopyInto(cellConnections.begin());
     verify_cell_values_written(cellConnections);
     verify_cell_values_correct(cellConnections,inGrid.GetNumberOfPoints());
+
+    std::cout << "Tetrahedralize with a fixed fanout" << std::endl;
+    std::vector<dax::Id> fanoutConnections(cellConnLength,-1);
+    dax::cont::ArrayHandle<dax::Id> fanoutHandle =
+            dax::cont::make_ArrayHandle(fanoutConnections);
+    OutGridType fanoutGrid;
+    typedef dax::cont::DispatcherGenerateTopology<
+        dax::worklet::Tetrahedralize> FanoutDispatcherType;
+    typename FanoutDispatcherType::TopologyPlanType plan;
+    try
+      {
+      FanoutDispatcherType dispatcher(5);
+      dispatcher.SetRemoveDuplicatePoints(false);
+
+      fanoutGrid.SetCellConnections(fanoutHandle);
+      dispatcher.Invoke(inGrid,fanoutGrid);
+      plan = dispatcher.GetTopologyPlan();
+      }
+    catch (dax::cont::ErrorControl error)
+      {
+      std::cout << "Got error: " << error.GetMessage() << std::endl;
+      DAX_TEST_ASSERT(true==false,error.GetMessage());
+      }
+    fanoutHandle.CopyInto(fanoutConnections.begin());
+    DAX_TEST_ASSERT(fanoutConnections == cellConnections,
+                    "Fixed fanout generated different tetrahedra");
+
+    DAX_TEST_ASSERT(plan.IsValid() &&
+                    plan.GetNumberOfCells()==inGrid.GetNumberOfCells() * 5,
+                    "Incorrect number of cells in the fixed fanout plan");
+    dax::cont::ArrayHandle<dax::Id> cellMap = plan.GetCellMap();
+    dax::cont::ArrayHandle<dax::Id> visitIndex = plan.GetVisitIndex();
+    for (dax::Id index = 0; index < plan.GetNumberOfCells(); ++index)
+      {
+      DAX_TEST_ASSERT(cellMap.GetPortalConstControl().Get(index)==index / 5,
+                      "Incorrect cell map in the fixed fanout plan");
+      DAX_TEST_ASSERT(visitIndex.GetPortalConstControl().Get(index)==index % 5,
+                      "Incorrect visit index in the fixed fanout plan");
+      }
     }
 };
 
@@ -25,6 +25,10 @@
 #include <dax/TypeTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCompact.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/StructuredGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/DispatcherGenerateTopology.h>
 #include <dax/cont/DispatcherMapCell.h>
@@ -158,6 +162,33 @@ struct TestThresholdWorklet
     dax::cont::testing::TestGrid<dax::cont::UniformGrid<> > in(DIM);
     dax::cont::UnstructuredGrid<dax::CellTagHexahedron> out;
 
+    this->GridThreshold(in,out);
+
+    std::cout << "Threshold into 32-bit connections" << std::endl;
+    dax::cont::UnstructuredGrid<
+        dax::CellTagHexahedron,
+        dax::cont::ArrayContainerControlCompactId<
+            dax::internal::Int32Type>::ArrayContainerControlTag> compactOut;
+    this->GridThreshold(in,compactOut);
+    }
+
+  //----------------------------------------------------------------------------
+  DAX_CONT_EXPORT
+  void operator()(const dax::cont::RectilinearGrid<>&) const
+    {
+    dax::cont::testing::TestGrid<dax::cont::RectilinearGrid<> > in(DIM);
+    dax::cont::UnstructuredGrid<dax::CellTagHexahedron> out;
+
+    this->GridThreshold(in,out);
+    }
+
+  //----------------------------------------------------------------------------
+  DAX_CONT_EXPORT
+  void operator()(const dax::cont::StructuredGrid<>&) const
+    {
+    dax::cont::testing::TestGrid<dax::cont::StructuredGrid<> > in(DIM);
+    dax::cont::UnstructuredGrid<dax::CellTagHexahedron> out;
+
     this->GridThreshold(in,out);
     }
 
@@ -216,6 +247,88 @@ struct TestThresholdWorklet
 
       //request to also compact the topology
       dispatcherTopo.CompactPointField(fieldHandle,resultHandle);
+
+      std::cout << "Map fields with the topology plan" << std::endl;
+      typename DispatcherGT::TopologyPlanType plan =
+          dispatcherTopo.GetTopologyPlan();
+      DAX_TEST_ASSERT(plan.IsValid(), "Threshold did not export a plan.");
+      DAX_TEST_ASSERT(plan.GetNumberOfCells() == outGrid.GetNumberOfCells(),
+                      "Plan has wrong number of cells.");
+
+      dax::cont::ArrayHandle<dax::Scalar> planPointField;
+      DAX_TEST_ASSERT(plan.CompactPointField(fieldHandle, planPointField),
+                      "Plan did not compact the point field.");
+      DAX_TEST_ASSERT(planPointField.GetNumberOfValues() ==
+                      resultHandle.GetNumberOfValues(),
+                      "Plan compacted the point field to a wrong size.");
+      for (dax::Id index = 0;
+           index < resultHandle.GetNumberOfValues();
+           index++)
+        {
+        DAX_TEST_ASSERT(planPointField.GetPortalConstControl().Get(index) ==
+                        resultHandle.GetPortalConstControl().Get(index),
+                        "Plan compacted the point field differently.");
+        }
+
+      std::cout << "Compact several point fields at once" << std::endl;
+      std::vector<dax::Scalar> secondField(field.size());
+      for (std::size_t index = 0; index < field.size(); index++)
+        {
+        secondField[index] = -2*field[index];
+        }
+      dax::Tuple<dax::cont::ArrayHandle<dax::Scalar>,2> pointFields;
+      pointFields[0] = fieldHandle;
+      pointFields[1] = dax::cont::make_ArrayHandle(secondField);
+      dax::Tuple<dax::cont::ArrayHandle<dax::Scalar>,2> compactedFields;
+      dax::Tuple<dax::cont::ArrayHandle<dax::Scalar>,2> planCompactedFields;
+      DAX_TEST_ASSERT(dispatcherTopo.CompactPointFields(pointFields,
+                                                        compactedFields),
+                      "Dispatcher did not compact the point fields.");
+      DAX_TEST_ASSERT(plan.CompactPointFields(pointFields,
+                                              planCompactedFields),
+                      "Plan did not compact the point fields.");
+      for (int fieldIndex = 0; fieldIndex < 2; fieldIndex++)
+        {
+        DAX_TEST_ASSERT(compactedFields[fieldIndex].GetNumberOfValues() ==
+                        resultHandle.GetNumberOfValues() &&
+                        planCompactedFields[fieldIndex].GetNumberOfValues() ==
+                        resultHandle.GetNumberOfValues(),
+                        "Point fields compacted to a wrong size.");
+        }
+      for (dax::Id index = 0;
+           index < resultHandle.GetNumberOfValues();
+           index++)
+        {
+        const dax::Scalar expected =
+            resultHandle.GetPortalConstControl().Get(index);
+        DAX_TEST_ASSERT(
+              compactedFields[0].GetPortalConstControl().Get(index) ==
+              expected &&
+              compactedFields[1].GetPortalConstControl().Get(index) ==
+              -2*expected,
+              "Dispatcher compacted the point fields differently.");
+        DAX_TEST_ASSERT(
+              planCompactedFields[0].GetPortalConstControl().Get(index) ==
+              expected &&
+              planCompactedFields[1].GetPortalConstControl().Get(index) ==
+              -2*expected,
+              "Plan compacted the point fields differently.");
+        }
+
+      dax::cont::ArrayHandle<dax::Id> planCellField;
+      plan.CompactCellField(
+            dax::cont::make_ArrayHandleCounting(dax::Id(0),
+                                                inGrid.GetNumberOfCells()),
+            planCellField);
+      dax::cont::ArrayHandle<dax::Id> visitIndex = plan.GetVisitIndex();
+      for (dax::Id index = 0; index < outGrid.GetNumberOfCells(); index++)
+        {
+        DAX_TEST_ASSERT(planCellField.GetPortalConstControl().Get(index) ==
+                        plan.GetCellMap().GetPortalConstControl().Get(index),
+                        "Plan mapped the cell field to the wrong cells.");
+        DAX_TEST_ASSERT(visitIndex.GetPortalConstControl().Get(index) == 0,
+                        "Threshold visits each cell once.");
+        }
       }
     catch (dax::cont::ErrorControl error)
       {